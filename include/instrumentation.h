@@ -0,0 +1,120 @@
+/**
+ * @file instrumentation.h
+ * @brief Mesure des operations du coeur : latences et causes d'echec
+ * @date Decembre 2025
+ *
+ * Chaque operation mesuree alimente un histogramme de latences a pas
+ * logarithmique (16 subdivisions par puissance de deux, precision de 6 %)
+ * et un compteur par code de retour. Chaque thread ecrit dans ses propres
+ * compteurs, sans verrou ; les lectures additionnent ceux de tous les
+ * threads. Une operation appelee par une autre (recherche de place lors
+ * d'une entree) est comptee mais pas chronometree.
+ *
+ * Compiler avec -DPARKING_SANS_MESURES supprime toute mesure.
+ */
+
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include "types.h"
+
+/** Codes de retour comptes : SUCCES (0) a ERREUR_PLACE_OCCUPEE */
+#define CODES_MESURES (1 - ERREUR_PLACE_OCCUPEE)
+
+/* ============================================================================
+ * TYPES DE L'INSTRUMENTATION
+ * ============================================================================ */
+
+/**
+ * @enum OperationMesuree
+ * @brief Operations du coeur suivies
+ */
+typedef enum {
+    MESURE_ENTREE = 0,              /* enregistrerEntree */
+    MESURE_SORTIE = 1,              /* enregistrerSortie */
+    MESURE_RECHERCHE_VEHICULE = 2,  /* rechercherVehicule */
+    MESURE_PLACE_LIBRE = 3,         /* rechercherPlaceLibre */
+    MESURE_ETAT_PLACE = 4,          /* modifierEtatPlace */
+    NOMBRE_MESURES = 5
+} OperationMesuree;
+
+/**
+ * @struct ResumeMesure
+ * @brief Latences (nanosecondes) et codes de retour d'une operation
+ */
+typedef struct {
+    long long nombre;                   /* Appels */
+    long long chronometrees;            /* Appels hors autre operation */
+    long long retours[CODES_MESURES];   /* Indice : -code (0 : succes) */
+    double p50;
+    double p90;
+    double p99;
+    double maximum;
+    double moyenne;
+} ResumeMesure;
+
+/* ============================================================================
+ * ENREGISTREMENT
+ * ============================================================================ */
+
+/**
+ * @brief Instant de debut d'une operation mesuree
+ * @return Instant monotone en secondes, negatif si l'operation n'est pas
+ *         chronometree
+ *
+ * Chaque appel doit etre suivi de terminerMesure dans le meme thread.
+ */
+double debuterMesure(void);
+
+/**
+ * @brief Enregistre la fin d'une operation
+ * @param operation Operation mesuree
+ * @param debut Instant retourne par debuterMesure
+ * @param code SUCCES ou code d'erreur (CodeErreur) de l'operation
+ */
+void terminerMesure(OperationMesuree operation, double debut, int code);
+
+/* ============================================================================
+ * CONSULTATION
+ * ============================================================================ */
+
+/**
+ * @brief Resume les mesures d'une operation, tous threads confondus
+ * @param operation Operation mesuree
+ * @param resume Recoit le resume
+ */
+void resumerMesure(OperationMesuree operation, ResumeMesure *resume);
+
+/**
+ * @brief Remet toutes les mesures a zero
+ *
+ * A appeler quand aucune operation n'est en cours dans un autre thread.
+ */
+void reinitialiserMesures(void);
+
+/**
+ * @brief Nom d'une operation mesuree (fonction du coeur)
+ * @param operation Operation mesuree
+ * @return Nom constant
+ */
+const char* nomMesure(OperationMesuree operation);
+
+/**
+ * @brief Nom court d'un code de retour (DEJA_PRESENT, AUCUNE_PLACE...)
+ * @param code SUCCES ou code d'erreur
+ * @return Nom constant
+ */
+const char* nomCodeMesure(int code);
+
+/**
+ * @brief Ecrit les mesures de toutes les operations dans un fichier texte
+ * @param fichier Chemin du fichier (remplace)
+ * @return SUCCES, ERREUR_PARAMETRE ou ERREUR_ENTREE_SORTIE
+ *
+ * Une ligne par operation : nom, nombre d'appels et d'appels chronometres,
+ * p50, p90, p99, max et moyenne en nanosecondes, puis les codes d'erreur
+ * rencontres (NOM=nombre).
+ */
+int ecrireMesures(const char *fichier);
+
+#endif /* INSTRUMENTATION_H */
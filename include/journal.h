@@ -0,0 +1,78 @@
+/**
+ * @file journal.h
+ * @brief Prototypes du journal des operations
+ * @date Decembre 2025
+ *
+ * Chaque entree, sortie et changement d'etat d'une place ajoute un
+ * enregistrement de taille fixe au journal. Au demarrage, la derniere
+ * sauvegarde est chargee puis les operations posterieures du journal
+ * sont rejouees.
+ */
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include "types.h"
+
+/**
+ * @brief Rejoue la fin du journal puis l'ouvre en ajout
+ * @param parking Parking issu de la derniere sauvegarde
+ * @param fichier Fichier du journal (cree s'il n'existe pas)
+ * @param groupeSynchro Enregistrements regroupes par synchronisation
+ *        disque (1 : chaque operation est synchronisee)
+ * @param delaiSynchroSecondes Delai au-dela duquel un groupe incomplet
+ *        est synchronise (0 : pas de delai)
+ * @return Nombre d'operations rejouees, sinon code d'erreur negatif
+ *         (ERREUR_PARAMETRE, ERREUR_FICHIER_INVALIDE, ERREUR_ENTREE_SORTIE
+ *         ou ERREUR_MEMOIRE)
+ *
+ * Seules les operations de numero superieur a parking->sequenceJournal
+ * sont rejouees. Une fin de journal incomplete ou illisible jusqu'au bout
+ * du fichier (arret brutal pendant une ecriture) est ignoree puis retiree
+ * du fichier. Un journal qui ne prolonge pas la sauvegarde (operations
+ * manquantes, enregistrement corrompu suivi d'enregistrements valides,
+ * operation non rejouable) n'est ni tronque ni ouvert :
+ * ERREUR_FICHIER_INVALIDE, le parking pouvant porter une partie des
+ * operations rejouees.
+ */
+int ouvrirJournal(Parking *parking, const char *fichier,
+                  int groupeSynchro, int delaiSynchroSecondes);
+
+/**
+ * @brief Ecrit et synchronise sur disque les enregistrements en attente
+ * @param parking Pointeur vers le parking
+ * @return 1 si succes ou journal ferme, 0 en cas d'erreur d'ecriture
+ */
+int synchroniserJournal(Parking *parking);
+
+/**
+ * @brief Retire du journal les operations contenues dans une sauvegarde
+ * @param parking Pointeur vers le parking
+ * @param sequenceSauvegardee Derniere operation contenue dans la
+ *        sauvegarde (deja sur disque)
+ * @return 1 si succes, 0 sinon (journal inchange)
+ */
+int compacterJournal(Parking *parking, uint32_t sequenceSauvegardee);
+
+/**
+ * @brief Applique les operations ajoutees au journal d'une autre instance
+ * @param parking Parking observe, sans journal ouvert
+ * @param fichier Fichier du journal suivi (lecture seule)
+ * @param position Position de lecture, mise a jour (0 au premier appel)
+ * @return Nombre d'operations appliquees, ERREUR_FICHIER_INVALIDE si le
+ *         journal ne prolonge plus l'etat du parking (compacte apres une
+ *         sauvegarde : la sauvegarde est alors a recharger), sinon
+ *         ERREUR_PARAMETRE ou ERREUR_ENTREE_SORTIE
+ *
+ * Le fichier est rouvert a chaque appel, ce qui suit son remplacement
+ * lors d'une compaction. Un journal absent n'est pas une erreur.
+ */
+int suivreJournal(Parking *parking, const char *fichier, long *position);
+
+/**
+ * @brief Synchronise puis ferme le journal
+ * @param parking Pointeur vers le parking
+ */
+void fermerJournal(Parking *parking);
+
+#endif /* JOURNAL_H */
@@ -0,0 +1,52 @@
+/**
+ * @file metriques.h
+ * @brief Prototypes de l'export des metriques (format texte Prometheus)
+ * @date Decembre 2025
+ *
+ * Les compteurs du parking (places libres et occupees, places libres par
+ * type, presents, entrees, sorties, recettes) et les latences des
+ * operations sont ecrits dans un fichier lu par le collecteur "textfile"
+ * de node_exporter. Le fichier est ecrit a cote puis renomme : un lecteur
+ * ne voit jamais un export incomplet.
+ *
+ * Seuls les agregats tenus a jour a chaque operation sont lus, jamais
+ * l'historique : un export coute le meme prix quelle que soit l'activite.
+ */
+
+#ifndef METRIQUES_H
+#define METRIQUES_H
+
+#include "types.h"
+
+/**
+ * @brief Ecrit les metriques du parking dans un fichier
+ * @param parking Pointeur vers le parking
+ * @param nomFichier Fichier de destination (remplace par renommage)
+ * @return SUCCES, ERREUR_PARAMETRE ou ERREUR_ENTREE_SORTIE
+ */
+int ecrireMetriques(const Parking *parking, const char *nomFichier);
+
+/**
+ * @brief Regle l'export periodique des metriques
+ * @param nomFichier Fichier de destination (NULL ou vide : aucun export)
+ * @param intervalleSecondes Intervalle entre deux exports (0 : aucun)
+ */
+void configurerExportMetriques(const char *nomFichier,
+                               int intervalleSecondes);
+
+/**
+ * @brief Exporte les metriques si l'intervalle est ecoule ; a appeler a
+ *        chaque tour de la boucle principale
+ * @param parking Pointeur vers le parking
+ * @return SUCCES (export fait ou pas encore du), sinon code d'erreur
+ */
+int exporterMetriquesSiEcheance(const Parking *parking);
+
+/**
+ * @brief Exporte les metriques immediatement (fin de traitement)
+ * @param parking Pointeur vers le parking
+ * @return SUCCES (ou aucun export configure), sinon code d'erreur
+ */
+int exporterMetriques(const Parking *parking);
+
+#endif /* METRIQUES_H */
@@ -0,0 +1,177 @@
+/**
+ * @file mode_lot.h
+ * @brief Prototypes du mode par lot (commandes non interactives)
+ * @date Decembre 2025
+ *
+ * Une commande par ligne, champs separes par des espaces :
+ *   ENTRY <plaque> <proprietaire> <type>   type : VOITURE, MOTO, CAMION,
+ *                                          BUS ou 1 a 4
+ *   EXIT <plaque>
+ *   PLACE <numero> <etat>                  etat : LIBRE, RESERVEE,
+ *                                          HORS_SERVICE ou 0, 2, 3 (une
+ *                                          place n'est occupee que par
+ *                                          ENTRY)
+ *   LOOKUP <plaque>                        place, type, duree (minutes) et
+ *                                          montant du stationnement en cours
+ *   AVAIL [type]                           places libres (par type, ou pour
+ *                                          un type de vehicule)
+ *   REPORT                                 etat courant du parking
+ *   CLOCK <minutes>                        avance l'horloge simulee
+ * Les lignes vides et celles commencant par '#' sont ignorees.
+ *
+ * Chaque commande produit une ligne de reponse : "OK ..." ou
+ * "ERR <ligne> ...".
+ */
+
+#ifndef MODE_LOT_H
+#define MODE_LOT_H
+
+#include <stdio.h>
+#include "types.h"
+#include "moteur_concurrent.h"
+
+/* ============================================================================
+ * TYPES DU MODE PAR LOT
+ * ============================================================================ */
+
+/** Longueur maximale d'une ligne de commande */
+#define TAILLE_LIGNE_LOT 256
+
+/**
+ * @struct BilanLot
+ * @brief Compteurs d'un traitement par lot
+ */
+typedef struct {
+    long commandes;
+    long entrees;
+    long sorties;
+    long changementsEtat;
+    long rapports;
+    long consultations;
+    long erreurs;
+    double secondes;
+} BilanLot;
+
+/**
+ * @enum NatureCommandeLot
+ * @brief Commandes reconnues
+ */
+typedef enum {
+    COMMANDE_INCONNUE = 0,
+    COMMANDE_ENTREE,
+    COMMANDE_SORTIE,
+    COMMANDE_PLACE,
+    COMMANDE_RAPPORT,
+    COMMANDE_HORLOGE,
+    COMMANDE_CONSULTATION,
+    COMMANDE_DISPONIBILITE
+} NatureCommandeLot;
+
+/**
+ * @struct CommandeLot
+ * @brief Ligne de commande decoupee en champs
+ */
+typedef struct {
+    NatureCommandeLot nature;
+    char nom[16];
+    char plaque[TAILLE_LIGNE_LOT];
+    char proprietaire[TAILLE_LIGNE_LOT];
+    int numero;
+    int type;
+    int etat;
+} CommandeLot;
+
+/* ============================================================================
+ * ANALYSE DES COMMANDES
+ * ============================================================================ */
+
+/**
+ * @brief Nom d'un type de vehicule dans les commandes et les reponses
+ * @param type Type de vehicule (VOITURE a BUS)
+ * @return Nom du type, "?" si invalide
+ */
+const char* nomTypeLot(int type);
+
+/**
+ * @brief Lit une ligne de commande
+ * @param entree Flux des commandes
+ * @param ligne Recoit la ligne, sans caractere de fin de ligne
+ * @param taille Taille de ligne
+ * @return 1 si une ligne a ete lue, -1 si elle etait trop longue
+ *         (ignoree jusqu'a sa fin), 0 en fin de flux
+ */
+int lireLigneLot(FILE *entree, char *ligne, int taille);
+
+/**
+ * @brief Decoupe une ligne de commande et compte la commande
+ * @param ligne Ligne lue (sans caractere de fin de ligne)
+ * @param numeroLigne Numero de la ligne, pour les messages d'erreur
+ * @param commande Recoit la commande
+ * @param sortie Flux des reponses (erreurs de syntaxe)
+ * @param bilan Compteurs mis a jour
+ * @return 1 si la commande est a executer, 0 si elle est erronee, -1 si
+ *         la ligne est ignoree
+ */
+int analyserCommandeLot(const char *ligne, long numeroLigne,
+                        CommandeLot *commande, FILE *sortie, BilanLot *bilan);
+
+/* ============================================================================
+ * EXECUTION D'UN LOT
+ * ============================================================================ */
+
+/**
+ * @brief Execute une ligne de commande
+ * @param parking Pointeur vers le parking
+ * @param ligne Ligne lue (sans caractere de fin de ligne)
+ * @param numeroLigne Numero de la ligne, pour les messages d'erreur
+ * @param sortie Flux des reponses
+ * @param bilan Compteurs mis a jour
+ * @param exploitation Non nul pour accepter CLOCK et PLACE (lot de
+ *        l'exploitant) ; nul, ces commandes sont refusees (bornes)
+ * @return 1 si la commande a reussi, 0 sinon, -1 si la ligne est ignoree
+ */
+int executerCommandeLot(Parking *parking, const char *ligne,
+                        long numeroLigne, FILE *sortie, BilanLot *bilan,
+                        int exploitation);
+
+/**
+ * @brief Execute les commandes lues jusqu'a la fin du flux d'entree
+ * @param parking Pointeur vers le parking
+ * @param entree Flux des commandes
+ * @param sortie Flux des reponses
+ * @param bilan Recoit les compteurs et la duree du traitement
+ * @return 1 si toutes les commandes ont reussi, 0 sinon
+ *
+ * L'historique est archive et la sauvegarde periodique relancee a
+ * intervalles reguliers, comme dans la boucle interactive.
+ */
+int executerLot(Parking *parking, FILE *entree, FILE *sortie,
+                BilanLot *bilan);
+
+/**
+ * @brief Execute plusieurs flux de commandes en parallele, un par voie
+ * @param moteur Moteur concurrent cree pour nombreVoies voies
+ * @param entrees Flux des commandes de chaque voie
+ * @param sorties Flux des reponses de chaque voie
+ * @param nombreVoies Nombre de voies (et de threads)
+ * @param bilans Recoit les compteurs de chaque voie
+ * @return 1 si toutes les commandes ont reussi, 0 sinon
+ *
+ * REPORT donne les totaux de toutes les voies ; CLOCK est refuse (l'heure
+ * est commune aux voies). Pendant le traitement, le thread appelant
+ * reporte periodiquement les operations dans le parking et son journal
+ * (fusionnerMoteurConcurrent) ; les dernieres sont a fusionner apres le
+ * retour.
+ */
+int executerLotConcurrent(MoteurConcurrent *moteur, FILE *entrees[],
+                          FILE *sorties[], int nombreVoies,
+                          BilanLot bilans[]);
+
+/**
+ * @brief Affiche le debit et les compteurs d'un traitement par lot
+ * @param bilan Bilan a afficher
+ * @param sortie Flux de sortie
+ */
+void afficherBilanLot(const BilanLot *bilan, FILE *sortie);
+
+#endif /* MODE_LOT_H */
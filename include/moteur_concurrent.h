@@ -0,0 +1,148 @@
+/**
+ * @file moteur_concurrent.h
+ * @brief Prototypes du moteur concurrent (plusieurs voies d'entree/sortie)
+ * @date Decembre 2025
+ *
+ * Le moteur prend en charge un parking pour une session pendant laquelle
+ * plusieurs voies (une par thread) enregistrent entrees, sorties et
+ * changements d'etat en meme temps :
+ * - l'etat de chaque place est change par compare-et-echange atomique,
+ *   une place ne peut donc etre attribuee deux fois ;
+ * - l'index des plaques est reparti en fragments proteges chacun par
+ *   son propre verrou ;
+ * - chaque voie tient ses compteurs sur sa propre ligne de cache ; les
+ *   totaux sont obtenus en les additionnant.
+ * Les operations sont numerotees et gardees par voie, puis reportees
+ * dans le parking (et son journal) par fusionnerMoteurConcurrent, appelee
+ * periodiquement pendant que les voies travaillent.
+ *
+ * Le moteur utilise les threads POSIX et les primitives atomiques de
+ * GCC/Clang.
+ */
+
+#ifndef MOTEUR_CONCURRENT_H
+#define MOTEUR_CONCURRENT_H
+
+#include "types.h"
+
+/** Moteur concurrent (structure interne a moteur_concurrent.c) */
+typedef struct MoteurConcurrent MoteurConcurrent;
+
+/**
+ * @struct TotauxConcurrents
+ * @brief Compteurs des voies additionnes
+ *
+ * Entrees, sorties, places, presents et recettes cumulent l'etat du
+ * parking a la creation du moteur ; changementsEtat et refus ne comptent
+ * que les operations des voies.
+ */
+typedef struct {
+    long entrees;
+    long sorties;
+    long changementsEtat;
+    long refus;
+    int placesLibres;
+    int placesOccupees;
+    int presents;
+    double recettes;
+} TotauxConcurrents;
+
+/* ============================================================================
+ * CYCLE DE VIE
+ * ============================================================================ */
+
+/**
+ * @brief Cree un moteur pour un parking et un nombre de voies
+ * @param parking Parking pris en charge (a ne plus modifier directement
+ *        jusqu'a detruireMoteurConcurrent)
+ * @param nombreVoies Nombre de voies (threads) simultanees
+ * @return Moteur cree, NULL si parametre invalide ou memoire insuffisante
+ */
+MoteurConcurrent* creerMoteurConcurrent(Parking *parking, int nombreVoies);
+
+/**
+ * @brief Reporte dans le parking les operations des voies, dans l'ordre
+ * @param moteur Moteur concurrent
+ * @return Nombre d'operations reportees, ERREUR_PARAMETRE, ERREUR_MEMOIRE
+ *         ou ERREUR_ENTREE_SORTIE (journal non synchronise)
+ *
+ * Appelable pendant que les voies travaillent, par un seul thread (le
+ * seul a lire le parking) : les operations numerotees avant l'appel sont
+ * appliquees et journalisees comme par les fonctions du coeur, puis le
+ * journal est synchronise. Voies arretees, le parking est ensuite
+ * identique a l'etat du moteur. Apres ERREUR_MEMOIRE ou une ecriture du
+ * journal en echec, les operations non reportees restent pour la fusion
+ * suivante.
+ */
+int fusionnerMoteurConcurrent(MoteurConcurrent *moteur);
+
+/**
+ * @brief Libere le moteur (les operations non fusionnees sont perdues)
+ * @param moteur Moteur concurrent
+ */
+void detruireMoteurConcurrent(MoteurConcurrent *moteur);
+
+/* ============================================================================
+ * OPERATIONS DES VOIES (appelables en parallele, une voie par thread)
+ * ============================================================================ */
+
+/**
+ * @brief Enregistre une entree sur une voie
+ * @param moteur Moteur concurrent
+ * @param voie Numero de la voie (0 a nombreVoies - 1)
+ * @param plaque Plaque d'immatriculation
+ * @param proprietaire Nom du proprietaire
+ * @param type Type de vehicule
+ * @return Numero de la place attribuee, sinon ERREUR_PARAMETRE,
+ *         ERREUR_DEJA_PRESENT, ERREUR_AUCUNE_PLACE ou ERREUR_MEMOIRE
+ */
+int entreeConcurrente(MoteurConcurrent *moteur, int voie, const char *plaque,
+                      const char *proprietaire, TypeVehicule type);
+
+/**
+ * @brief Enregistre une sortie sur une voie
+ * @param moteur Moteur concurrent
+ * @param voie Numero de la voie
+ * @param plaque Plaque d'immatriculation
+ * @param montant Recoit le montant a payer (peut etre NULL)
+ * @return SUCCES, ERREUR_PARAMETRE, ERREUR_VEHICULE_ABSENT ou
+ *         ERREUR_MEMOIRE
+ */
+int sortieConcurrente(MoteurConcurrent *moteur, int voie, const char *plaque,
+                      float *montant);
+
+/**
+ * @brief Change l'etat d'une place libre, reservee ou hors service
+ * @param moteur Moteur concurrent
+ * @param voie Numero de la voie
+ * @param numeroPlace Numero de la place
+ * @param nouvelEtat LIBRE, RESERVEE ou HORS_SERVICE
+ * @return SUCCES, ERREUR_PARAMETRE, ERREUR_PLACE_INVALIDE,
+ *         ERREUR_PLACE_OCCUPEE ou ERREUR_MEMOIRE
+ *
+ * Une place n'est occupee ou liberee de son vehicule que par une entree
+ * ou une sortie.
+ */
+int etatPlaceConcurrent(MoteurConcurrent *moteur, int voie, int numeroPlace,
+                        EtatPlace nouvelEtat);
+
+/**
+ * @brief Additionne les compteurs de toutes les voies
+ * @param moteur Moteur concurrent
+ * @param totaux Recoit les totaux (valeurs instantanees si des voies
+ *        sont en cours d'operation)
+ */
+void totaliserMoteurConcurrent(const MoteurConcurrent *moteur,
+                               TotauxConcurrents *totaux);
+
+/**
+ * @brief Regle l'heure utilisee par les voies
+ * @param moteur Moteur concurrent
+ * @param heure Heure courante
+ *
+ * Les voies ne lisent jamais l'horloge elles-memes : un seul thread
+ * (celui qui coordonne les voies) la publie.
+ */
+void reglerHeureMoteur(MoteurConcurrent *moteur, Horodatage heure);
+
+#endif /* MOTEUR_CONCURRENT_H */
@@ -36,6 +36,38 @@ void initialiserPlace(Place *place, int numero, TypeVehicule typeAutorise);
  */
 void libererParking(Parking *parking);
 
+/**
+ * @brief Ajoute des places en fin de parking
+ * @param parking Pointeur vers le parking
+ * @param nombre Nombre de places a ajouter
+ * @param typeAutorise Type de vehicule autorise sur les nouvelles places
+ * @return 1 si succes, 0 sinon
+ */
+int ajouterPlaces(Parking *parking, int nombre, TypeVehicule typeAutorise);
+
+/**
+ * @brief Acces a une place par son indice
+ * @param parking Pointeur vers le parking
+ * @param indice Indice de la place (0 <= indice < nombrePlaces)
+ * @return Pointeur vers la place
+ */
+Place* obtenirPlace(const Parking *parking, int indice);
+
+/**
+ * @brief Acces a un vehicule de l'historique par son indice
+ * @param parking Pointeur vers le parking
+ * @param indice Indice du vehicule (0 <= indice < nombreVehicules)
+ * @return Pointeur vers le vehicule
+ */
+Vehicule* obtenirVehicule(const Parking *parking, int indice);
+
+/**
+ * @brief Ajoute un enregistrement vierge en fin d'historique
+ * @param parking Pointeur vers le parking
+ * @return Indice du nouvel enregistrement, -1 si memoire insuffisante
+ */
+int ajouterVehiculeHistorique(Parking *parking);
+
 /* ============================================================================
  * GESTION DES PLACES
  * ============================================================================ */
@@ -52,8 +84,10 @@ int rechercherPlaceLibre(Parking *parking, TypeVehicule type);
  * @brief Modifie l'etat d'une place
  * @param parking Pointeur vers le parking
  * @param numeroPlace Numero de la place
- * @param nouvelEtat Nouvel etat de la place
- * @return 1 si succes, 0 sinon
+ * @param nouvelEtat Nouvel etat de la place (LIBRE, RESERVEE ou
+ *        HORS_SERVICE ; seule une entree occupe une place)
+ * @return SUCCES, ERREUR_PARAMETRE, ERREUR_PLACE_INVALIDE ou
+ *         ERREUR_PLACE_OCCUPEE (place occupee par un vehicule)
  */
 int modifierEtatPlace(Parking *parking, int numeroPlace, EtatPlace nouvelEtat);
 
@@ -79,7 +113,9 @@ void afficherCartePaking(const Parking *parking);
  * @param plaque Plaque d'immatriculation
  * @param proprietaire Nom du proprietaire
  * @param type Type de vehicule
- * @return Numero de place attribuee, -1 si echec
+ * @return Numero de place attribuee (>= 1), sinon code d'erreur negatif :
+ *         ERREUR_PARAMETRE, ERREUR_DEJA_PRESENT, ERREUR_AUCUNE_PLACE ou
+ *         ERREUR_MEMOIRE
  */
 int enregistrerEntree(Parking *parking, const char *plaque, 
                       const char *proprietaire, TypeVehicule type);
@@ -88,9 +124,11 @@ int enregistrerEntree(Parking *parking, const char *plaque,
  * @brief Enregistre la sortie d'un vehicule
  * @param parking Pointeur vers le parking
  * @param plaque Plaque d'immatriculation
- * @return Montant a payer, -1.0 si erreur
+ * @param montant Recoit le montant a payer (peut etre NULL)
+ * @return SUCCES, ERREUR_PARAMETRE, ERREUR_VEHICULE_ABSENT ou
+ *         ERREUR_DEJA_SORTI
  */
-float enregistrerSortie(Parking *parking, const char *plaque);
+int enregistrerSortie(Parking *parking, const char *plaque, float *montant);
 
 /**
  * @brief Recherche un vehicule par sa plaque
@@ -101,7 +139,7 @@ float enregistrerSortie(Parking *parking, const char *plaque);
 Vehicule* rechercherVehicule(Parking *parking, const char *plaque);
 
 /**
- * @brief Recherche la place occupee par un vehicule
+ * @brief Recherche la place occupee par un vehicule present
  * @param parking Pointeur vers le parking
  * @param plaque Plaque du vehicule
  * @return Numero de la place, -1 si non trouve
@@ -114,4 +152,45 @@ int rechercherPlaceParVehicule(Parking *parking, const char *plaque);
  */
 void afficherVehiculesPresents(const Parking *parking);
 
+/* ============================================================================
+ * SEGMENTS ET ARCHIVAGE DE L'HISTORIQUE
+ * ============================================================================ */
+
+/**
+ * @brief Active ou ajuste l'archivage des segments anciens de l'historique
+ * @param parking Pointeur vers le parking
+ * @param fichier Fichier d'archive des segments scelles
+ * @param segmentsMax Nombre de segments complets gardes en memoire
+ * @param ageMaxMinutes Age de la derniere sortie au-dela duquel un
+ *        segment est archive (0 : pas de critere d'age)
+ * @return 1 si succes, 0 sinon
+ */
+int configurerArchivage(Parking *parking, const char *fichier,
+                        int segmentsMax, int ageMaxMinutes);
+
+/**
+ * @brief Archive les segments anciens qui ont depasse un seuil
+ * @param parking Pointeur vers le parking
+ * @return Nombre de segments ecrits sur disque et liberes
+ *
+ * Les segments partent du plus ancien au plus recent ; un vehicule
+ * encore present retient son segment et les suivants en memoire.
+ */
+int archiverHistorique(Parking *parking);
+
+/**
+ * @brief Indice du premier vehicule dont le segment est en memoire
+ * @param parking Pointeur vers le parking
+ * @return Indice dans l'historique (0 si rien n'est archive)
+ */
+int premierVehiculeEnMemoire(const Parking *parking);
+
+/**
+ * @brief Lecture d'un vehicule de l'historique, archive ou non
+ * @param parking Pointeur vers le parking
+ * @param indice Indice du vehicule (0 <= indice < nombreVehicules)
+ * @return Pointeur valide jusqu'a la lecture suivante, NULL si illisible
+ */
+const Vehicule* lireVehicule(const Parking *parking, int indice);
+
 #endif /* PARKING_H */
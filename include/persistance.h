@@ -0,0 +1,135 @@
+/**
+ * @file persistance.h
+ * @brief Prototypes de la sauvegarde et du chargement du parking
+ * @date Decembre 2025
+ *
+ * Format de sauvegarde (version 5), dans l'ordre du fichier :
+ *   - en-tete : signature, version, tailles des enregistrements,
+ *     compteurs, agregats, numero de la derniere operation du journal
+ *     et sommes de controle CRC32C ;
+ *   - places, le vehicule occupant etant designe par son indice ;
+ *   - indices des vehicules presents (index des plaques) ;
+ *   - somme de controle CRC32C de chaque bloc de l'historique ;
+ *   - a la frontiere de page suivante, vehicules de l'historique encore
+ *     en memoire (les segments archives restent dans leur fichier).
+ * Les entiers sont ecrits dans l'ordre des octets de la machine.
+ */
+
+#ifndef PERSISTANCE_H
+#define PERSISTANCE_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include "types.h"
+
+/* ============================================================================
+ * SOMME DE CONTROLE
+ * ============================================================================ */
+
+/**
+ * @brief Calcule ou prolonge une somme de controle CRC32C (Castagnoli)
+ * @param crc Somme des donnees precedentes (0 pour commencer)
+ * @param donnees Donnees a ajouter
+ * @param taille Taille des donnees en octets
+ * @return Somme de controle mise a jour
+ */
+uint32_t calculerCrc32c(uint32_t crc, const void *donnees, size_t taille);
+
+/**
+ * @brief Vide un flux et synchronise son fichier sur disque
+ * @param flux Flux ouvert en ecriture
+ * @return 1 si succes, 0 sinon
+ */
+int synchroniserFlux(FILE *flux);
+
+/* ============================================================================
+ * SAUVEGARDE ET CHARGEMENT
+ * ============================================================================ */
+
+/**
+ * @brief Sauvegarde les donnees du parking dans un fichier
+ * @param parking Pointeur vers le parking
+ * @param nomFichier Nom du fichier de sauvegarde
+ * @return SUCCES, ERREUR_PARAMETRE, ERREUR_MEMOIRE ou ERREUR_ENTREE_SORTIE
+ *
+ * Le fichier est ecrit sous un nom temporaire puis renomme : l'ancienne
+ * sauvegarde reste valide jusqu'au remplacement.
+ */
+int sauvegarderDonnees(const Parking *parking, const char *nomFichier);
+
+/**
+ * @brief Charge les donnees du parking depuis un fichier
+ * @param parking Pointeur vers le parking
+ * @param nomFichier Nom du fichier a charger
+ * @return SUCCES, ERREUR_FICHIER_ABSENT, ERREUR_FICHIER_INVALIDE (parking
+ *         inchange), ERREUR_ENTREE_SORTIE ou ERREUR_MEMOIRE
+ *
+ * Lorsque le systeme le permet, le fichier est projete en memoire et
+ * l'historique est utilise sur place sans copie : seuls les blocs des
+ * vehicules presents sont controles au chargement, les autres a leur
+ * premier acces (un bloc corrompu est alors illisible pour lireVehicule).
+ */
+int chargerDonnees(Parking *parking, const char *nomFichier);
+
+/**
+ * @brief Lit le numero de la derniere operation contenue dans une sauvegarde
+ * @param nomFichier Nom du fichier de sauvegarde
+ * @param sequence Recoit le numero d'operation (journal)
+ * @return SUCCES, ERREUR_PARAMETRE, ERREUR_FICHIER_ABSENT ou
+ *         ERREUR_FICHIER_INVALIDE
+ *
+ * Seul l'en-tete est lu : un observateur peut ainsi savoir, a peu de
+ * frais, si une sauvegarde plus recente que son etat a ete ecrite.
+ */
+int lireSequenceSauvegarde(const char *nomFichier, uint32_t *sequence);
+
+/* ============================================================================
+ * SAUVEGARDE EN ARRIERE-PLAN
+ * ============================================================================ */
+
+/**
+ * @brief Lance une sauvegarde sans bloquer l'appelant
+ * @param parking Pointeur vers le parking
+ * @param nomFichier Nom du fichier de sauvegarde
+ * @return 1 si la sauvegarde est lancee, 0 si une autre est en cours
+ *         ou en cas d'echec
+ *
+ * Sous POSIX, un processus enfant ecrit une copie figee du parking.
+ * Ailleurs, la sauvegarde est synchrone. Une fois la sauvegarde sur
+ * disque, le journal est compacte.
+ */
+int lancerSauvegardeAsynchrone(Parking *parking, const char *nomFichier);
+
+/**
+ * @brief Constate sans attendre la fin d'une sauvegarde en arriere-plan
+ * @param parking Parking dont le journal sera compacte
+ * @return 1 si une sauvegarde vient de reussir, -1 si elle a echoue,
+ *         0 sinon
+ */
+int suivreSauvegardeAsynchrone(Parking *parking);
+
+/**
+ * @brief Attend la fin de la sauvegarde en arriere-plan eventuelle
+ * @param parking Parking dont le journal sera compacte (NULL : aucun)
+ * @return 1 si une sauvegarde vient de reussir, -1 si elle a echoue,
+ *         0 s'il n'y en avait aucune
+ */
+int attendreSauvegardeAsynchrone(Parking *parking);
+
+/**
+ * @brief Regle la sauvegarde periodique
+ * @param nomFichier Nom du fichier de sauvegarde
+ * @param intervalleSecondes Intervalle entre deux sauvegardes (0 : aucune)
+ */
+void configurerSauvegardePeriodique(const char *nomFichier,
+                                    int intervalleSecondes);
+
+/**
+ * @brief Recupere la sauvegarde terminee et lance la suivante si l'heure
+ *        est venue ; a appeler a chaque tour de la boucle principale
+ * @param parking Pointeur vers le parking
+ * @return Resultat de suivreSauvegardeAsynchrone
+ */
+int sauvegarderSiEcheance(Parking *parking);
+
+#endif /* PERSISTANCE_H */
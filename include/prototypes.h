@@ -16,15 +16,7 @@
  * PROTOTYPES DES FONCTIONS INTERNES
  * ============================================================================ */
 
-/* --- Fonctions de calcul de montant (parking_affichage.c) --- */
-
-/**
- * @brief Calcule le montant a payer selon la duree et le type de vehicule
- * @param dureeMinutes Duree de stationnement en minutes
- * @param type Type de vehicule
- * @return Montant a payer en FCFA
- */
-float calculerMontant(int dureeMinutes, TypeVehicule type);
+/* --- Fonctions d'affichage (parking_affichage.c) --- */
 
 /**
  * @brief Affiche les details d'un vehicule
@@ -59,6 +51,257 @@ Place* obtenirPlaceParNumero(Parking *parking, int numero);
  */
 int compterPlacesLibresParType(const Parking *parking, TypeVehicule type);
 
+/**
+ * @brief Modifie l'etat d'une place sans journaliser l'operation
+ * @param parking Pointeur vers le parking
+ * @param numeroPlace Numero de la place
+ * @param nouvelEtat Nouvel etat de la place
+ * @return 1 si succes, 0 sinon
+ */
+int appliquerEtatPlace(Parking *parking, int numeroPlace, EtatPlace nouvelEtat);
+
+/**
+ * @brief Agrandit les bitmaps de places libres pour une nouvelle capacite
+ * @param parking Pointeur vers le parking
+ * @param nombrePlaces Nombre de places a couvrir
+ * @return 1 si succes, 0 si memoire insuffisante
+ */
+int redimensionnerBitmapsPlaces(Parking *parking, int nombrePlaces);
+
+/**
+ * @brief Reconstruit les bitmaps et compteurs de places libres par type
+ * @param parking Pointeur vers le parking
+ */
+void reconstruireBitmapsPlaces(Parking *parking);
+
+/* --- Stockage par blocs (arene.c) --- */
+
+/**
+ * @brief Initialise une arene vide
+ * @param arene Pointeur vers l'arene
+ * @param tailleElement Taille d'un element en octets
+ * @param decalageBloc Log2 du nombre d'elements par bloc
+ */
+void initialiserArene(Arene *arene, int tailleElement, int decalageBloc);
+
+/**
+ * @brief Ajoute un element (initialise a zero) en fin d'arene
+ * @param arene Pointeur vers l'arene
+ * @return Pointeur vers le nouvel element, NULL si memoire insuffisante
+ */
+void* ajouterElementArene(Arene *arene);
+
+/**
+ * @brief Ajoute des blocs sans memoire en fin d'arene
+ * @param arene Pointeur vers l'arene (dont le dernier bloc est complet)
+ * @param nombre Nombre de blocs a ajouter
+ * @return 1 si succes, 0 sinon
+ *
+ * Les elements de ces blocs ne sont pas accessibles par elementArene.
+ */
+int ajouterBlocsVidesArene(Arene *arene, int nombre);
+
+/**
+ * @brief Ajoute des blocs complets pris dans une memoire externe
+ * @param arene Pointeur vers l'arene (dont le dernier bloc est complet)
+ * @param memoire Debut des blocs, contigus
+ * @param nombre Nombre de blocs a ajouter
+ * @return 1 si succes, 0 sinon
+ *
+ * Ces blocs ne sont jamais liberes par l'arene ; la memoire doit rester
+ * valide jusqu'a libererArene.
+ */
+int emprunterBlocsArene(Arene *arene, void *memoire, int nombre);
+
+/**
+ * @brief Libere la memoire d'un bloc, ses elements deviennent inaccessibles
+ * @param arene Pointeur vers l'arene
+ * @param bloc Indice du bloc
+ */
+void libererBlocArene(Arene *arene, int bloc);
+
+/**
+ * @brief Acces a un element de l'arene
+ * @param arene Pointeur vers l'arene
+ * @param indice Indice de l'element (0 <= indice < nombreElements)
+ * @return Pointeur vers l'element
+ */
+void* elementArene(const Arene *arene, int indice);
+
+/**
+ * @brief Libere tous les blocs d'une arene
+ * @param arene Pointeur vers l'arene
+ */
+void libererArene(Arene *arene);
+
+/* --- Archivage de l'historique (archive_historique.c) --- */
+
+/**
+ * @brief Libere l'etat d'archivage (le fichier d'archive est conserve)
+ * @param parking Pointeur vers le parking
+ */
+void libererArchive(Parking *parking);
+
+/* --- Fonctions de gestion des vehicules (parking_vehicules.c) --- */
+
+/**
+ * @brief Inscrit l'entree d'un vehicule sur une place donnee, sans journal
+ * @param parking Pointeur vers le parking
+ * @param plaque Plaque d'immatriculation
+ * @param proprietaire Nom du proprietaire
+ * @param type Type de vehicule
+ * @param numeroPlace Place libre attribuee
+ * @param entree Heure d'entree
+ * @return Indice du vehicule dans l'historique, -1 si memoire insuffisante
+ */
+int appliquerEntree(Parking *parking, const char *plaque,
+                    const char *proprietaire, TypeVehicule type,
+                    int numeroPlace, Horodatage entree);
+
+/**
+ * @brief Inscrit la sortie d'un vehicule present, sans journal
+ * @param parking Pointeur vers le parking
+ * @param vehicule Vehicule present
+ * @param sortie Heure de sortie
+ * @param montant Montant paye
+ */
+void appliquerSortie(Parking *parking, Vehicule *vehicule,
+                     Horodatage sortie, float montant);
+
+#ifdef PARKING_DEBUG
+/**
+ * @brief Recherche lineaire de la place d'un vehicule (verification)
+ * @param parking Pointeur vers le parking
+ * @param plaque Plaque du vehicule
+ * @return Numero de la place, -1 si non trouve
+ */
+int rechercherPlaceParVehiculeLineaire(const Parking *parking,
+                                       const char *plaque);
+#endif
+
+/* --- Sauvegarde (persistance.c) --- */
+
+/**
+ * @brief Rend la projection en memoire de la sauvegarde chargee
+ * @param parking Pointeur vers le parking (historique deja libere)
+ */
+void libererProjection(Parking *parking);
+
+/**
+ * @brief Controle au premier acces un bloc pris dans la sauvegarde projetee
+ * @param parking Pointeur vers le parking
+ * @param bloc Numero du bloc dans l'arene d'historique
+ * @return 1 si le bloc est intact ou n'a pas a etre controle, 0 s'il est
+ *         corrompu
+ */
+int controlerBlocHistorique(const Parking *parking, int bloc);
+
+/* --- Journal des operations (journal.c) --- */
+
+/*
+ * Chaque operation est journalisee avant d'etre appliquee : en cas
+ * d'echec (ERREUR_ENTREE_SORTIE), l'enregistrement est retire du fichier
+ * et l'operation doit etre refusee.
+ */
+
+/**
+ * @brief Journalise l'entree d'un vehicule (parametres de appliquerEntree)
+ * @param parking Pointeur vers le parking
+ * @param plaque Plaque d'immatriculation
+ * @param proprietaire Nom du proprietaire
+ * @param type Type de vehicule
+ * @param numeroPlace Place attribuee
+ * @param entree Heure d'entree
+ * @return SUCCES (ou journal ferme), ERREUR_ENTREE_SORTIE sinon
+ */
+int journaliserEntree(Parking *parking, const char *plaque,
+                      const char *proprietaire, TypeVehicule type,
+                      int numeroPlace, Horodatage entree);
+
+/**
+ * @brief Journalise la sortie d'un vehicule (parametres de appliquerSortie)
+ * @param parking Pointeur vers le parking
+ * @param vehicule Vehicule qui sort
+ * @param sortie Heure de sortie
+ * @param montant Montant paye
+ * @return SUCCES (ou journal ferme), ERREUR_ENTREE_SORTIE sinon
+ */
+int journaliserSortie(Parking *parking, const Vehicule *vehicule,
+                      Horodatage sortie, float montant);
+
+/**
+ * @brief Journalise un changement d'etat de place
+ * @param parking Pointeur vers le parking
+ * @param numeroPlace Numero de la place
+ * @param etat Nouvel etat
+ * @return SUCCES (ou journal ferme), ERREUR_ENTREE_SORTIE sinon
+ */
+int journaliserEtatPlace(Parking *parking, int numeroPlace, EtatPlace etat);
+
+/**
+ * @brief Retire le dernier enregistrement du journal (operation qui n'a
+ *        finalement pas pu etre appliquee)
+ * @param parking Pointeur vers le parking
+ */
+void annulerDernierEnregistrement(Parking *parking);
+
+/* --- Index des plaques (index_plaques.c) --- */
+
+/**
+ * @brief Calcule l'empreinte d'une plaque normalisee
+ * @param plaque Plaque d'immatriculation
+ * @return Empreinte FNV-1a (majuscules, sans espaces ni tirets)
+ */
+unsigned int hacherPlaque(const char *plaque);
+
+/**
+ * @brief Compare deux plaques apres normalisation
+ * @param plaque1 Premiere plaque
+ * @param plaque2 Deuxieme plaque
+ * @return 1 si equivalentes, 0 sinon
+ */
+int plaquesEquivalentes(const char *plaque1, const char *plaque2);
+
+/**
+ * @brief Vide l'index des plaques
+ * @param parking Pointeur vers le parking
+ */
+void viderIndexPlaques(Parking *parking);
+
+/**
+ * @brief Ajoute un vehicule present a l'index des plaques
+ * @param parking Pointeur vers le parking
+ * @param indiceVehicule Indice du vehicule dans l'historique
+ * @return 1 si succes, 0 si l'index est plein
+ */
+int indexerVehicule(Parking *parking, int indiceVehicule);
+
+/**
+ * @brief Recherche un vehicule present dans l'index des plaques
+ * @param parking Pointeur vers le parking
+ * @param plaque Plaque recherchee
+ * @return Indice dans l'historique, -1 si absent
+ */
+int rechercherIndexPlaque(const Parking *parking, const char *plaque);
+
+/**
+ * @brief Retire une plaque de l'index
+ * @param parking Pointeur vers le parking
+ * @param plaque Plaque a retirer
+ */
+void retirerIndexPlaque(Parking *parking, const char *plaque);
+
+/**
+ * @brief Dimensionne l'index pour un nombre de places donne
+ * @param parking Pointeur vers le parking
+ * @param nombrePlaces Nombre de places (borne des vehicules presents)
+ * @return 1 si succes, 0 si memoire insuffisante
+ *
+ * L'index est garde au plus a moitie plein ; les entrees existantes
+ * sont redistribuees dans la nouvelle table.
+ */
+int redimensionnerIndexPlaques(Parking *parking, int nombrePlaces);
+
 /* --- Fonctions de temps (utilitaires_temps.c) --- */
 
 /**
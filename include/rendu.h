@@ -0,0 +1,54 @@
+/**
+ * @file rendu.h
+ * @brief Prototypes de la couche de rendu des ecrans
+ * @date Decembre 2025
+ *
+ * Un ecran (rapport, carte, ticket) est compose dans un tampon
+ * reutilise d'un ecran a l'autre, puis ecrit d'un seul appel systeme.
+ * Les rendus peuvent s'imbriquer : seul le plus externe ecrit l'ecran.
+ */
+
+#ifndef RENDU_H
+#define RENDU_H
+
+/* ============================================================================
+ * COMPOSITION D'UN ECRAN
+ * ============================================================================ */
+
+/**
+ * @brief Commence un ecran (ou un rendu imbrique dans l'ecran en cours)
+ */
+void commencerRendu(void);
+
+/**
+ * @brief Ajoute du texte formate a l'ecran en cours
+ * @param format Format a la maniere de printf
+ */
+void rendreTexte(const char *format, ...);
+
+/**
+ * @brief Ajoute une ligne d'un meme caractere suivie d'un saut de ligne
+ * @param caractere Caractere a repeter
+ * @param longueur Nombre de caracteres
+ */
+void rendreLigne(char caractere, int longueur);
+
+/**
+ * @brief Ajoute l'effacement du terminal (sequence ANSI) a l'ecran en cours
+ */
+void rendreEffacement(void);
+
+/**
+ * @brief Termine l'ecran : le plus externe est ecrit sur la sortie standard
+ *
+ * Les ecritures precedentes de stdio sont videes avant, pour conserver
+ * l'ordre d'affichage.
+ */
+void terminerRendu(void);
+
+/**
+ * @brief Libere le tampon de rendu
+ */
+void libererRendu(void);
+
+#endif /* RENDU_H */
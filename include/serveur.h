@@ -0,0 +1,36 @@
+/**
+ * @file serveur.h
+ * @brief Prototypes du serveur local des bornes (socket Unix ou TCP)
+ * @date Decembre 2025
+ *
+ * Les barrieres et les caisses du site envoient les commandes du mode par
+ * lot (ENTRY, EXIT, LOOKUP, AVAIL, REPORT), une par ligne, et recoivent
+ * une ligne de reponse par commande, dans l'ordre. Un client peut envoyer
+ * plusieurs commandes sans attendre les reponses. CLOCK et PLACE, qui
+ * deplacent l'horloge ou ferment des places, restent au lot de l'exploitant
+ * et sont refusees.
+ *
+ * Un seul thread sert toutes les connexions par une boucle d'evenements
+ * epoll (Linux). Les reponses d'un tour de boucle partent apres une seule
+ * synchronisation du journal : toute operation confirmee est durable.
+ */
+
+#ifndef SERVEUR_H
+#define SERVEUR_H
+
+#include "types.h"
+#include "mode_lot.h"
+
+/**
+ * @brief Sert les bornes jusqu'a l'interruption (Ctrl+C ou SIGTERM)
+ * @param parking Parking charge, journal ouvert
+ * @param adresse Numero de port (TCP sur 127.0.0.1 uniquement) ou chemin
+ *        d'une socket Unix
+ * @param bilan Recoit les compteurs des commandes servies
+ * @return SUCCES a l'interruption, sinon ERREUR_PARAMETRE,
+ *         ERREUR_MEMOIRE ou ERREUR_ENTREE_SORTIE (notamment journal non
+ *         synchronise : le serveur s'arrete sans confirmer le tour)
+ */
+int executerServeur(Parking *parking, const char *adresse, BilanLot *bilan);
+
+#endif /* SERVEUR_H */
@@ -8,6 +8,31 @@
 #define STATISTIQUES_H
 
 #include "types.h"
+#include "tri_recherche.h"
+
+/* ============================================================================
+ * AGREGATS CUMULES
+ * ============================================================================ */
+
+/**
+ * @brief Remet a zero les agregats du parking
+ * @param parking Pointeur vers le parking
+ */
+void initialiserAgregats(Parking *parking);
+
+/**
+ * @brief Comptabilise l'entree d'un vehicule
+ * @param parking Pointeur vers le parking
+ * @param vehicule Vehicule entre
+ */
+void comptabiliserEntree(Parking *parking, const Vehicule *vehicule);
+
+/**
+ * @brief Comptabilise la sortie d'un vehicule (montant deja fixe)
+ * @param parking Pointeur vers le parking
+ * @param vehicule Vehicule sorti
+ */
+void comptabiliserSortie(Parking *parking, const Vehicule *vehicule);
 
 /* ============================================================================
  * CALCUL DES STATISTIQUES
@@ -65,29 +90,24 @@ void afficherResumeJournalier(const Parking *parking);
 void afficherHistorique(const Parking *parking, int nombreMax);
 
 /**
- * @brief Affiche les recettes par type de vehicule
+ * @brief Affiche l'historique dans un ordre choisi (tri indirect)
  * @param parking Pointeur vers le parking
+ * @param critere Plaque, date d'entree ou montant decroissant
+ * @param nombreMax Nombre maximum d'entrees a afficher
  */
-void afficherRecettesParType(const Parking *parking);
-
-/* ============================================================================
- * SAUVEGARDE ET CHARGEMENT
- * ============================================================================ */
+void afficherHistoriqueTrie(const Parking *parking, CritereTri critere,
+                            int nombreMax);
 
 /**
- * @brief Sauvegarde les donnees du parking dans un fichier
+ * @brief Affiche les recettes par type de vehicule
  * @param parking Pointeur vers le parking
- * @param nomFichier Nom du fichier de sauvegarde
- * @return 1 si succes, 0 sinon
  */
-int sauvegarderDonnees(const Parking *parking, const char *nomFichier);
+void afficherRecettesParType(const Parking *parking);
 
 /**
- * @brief Charge les donnees du parking depuis un fichier
- * @param parking Pointeur vers le parking
- * @param nomFichier Nom du fichier a charger
- * @return 1 si succes, 0 sinon
+ * @brief Affiche les latences (p50, p99, max) et les causes d'echec des
+ *        operations du coeur depuis le lancement
  */
-int chargerDonnees(Parking *parking, const char *nomFichier);
+void afficherMesuresOperations(void);
 
 #endif /* STATISTIQUES_H */
@@ -0,0 +1,33 @@
+/**
+ * @file tableau_bord.h
+ * @brief Prototypes du tableau de bord en direct
+ * @date Decembre 2025
+ *
+ * Le tableau de bord affiche la carte du parking et ses compteurs, et les
+ * tient a jour en suivant le journal ecrit par l'instance en service
+ * (interactive ou par lot). Apres la premiere image, seules les places
+ * dont l'etat a change et les compteurs modifies sont reecrits, par
+ * deplacement du curseur (sequences ANSI).
+ */
+
+#ifndef TABLEAU_BORD_H
+#define TABLEAU_BORD_H
+
+#include "types.h"
+
+/**
+ * @brief Affiche le tableau de bord jusqu'a l'interruption (Ctrl+C)
+ * @param parking Parking charge depuis la derniere sauvegarde, sans
+ *        journal ouvert
+ * @param fichierSauvegarde Sauvegarde rechargee lorsque le journal a ete
+ *        compacte
+ * @param fichierJournal Journal suivi (lecture seule)
+ * @param periodeMillisecondes Delai entre deux images
+ * @return SUCCES a l'interruption, sinon ERREUR_PARAMETRE ou
+ *         ERREUR_MEMOIRE
+ */
+int executerTableauBord(Parking *parking, const char *fichierSauvegarde,
+                        const char *fichierJournal,
+                        int periodeMillisecondes);
+
+#endif /* TABLEAU_BORD_H */
@@ -0,0 +1,83 @@
+/**
+ * @file tarification.h
+ * @brief Prototypes du moteur de tarification
+ * @date Decembre 2025
+ *
+ * Les tarifs (horaire, plafond journalier, franchise par type et
+ * bandes horaires) sont lus dans un fichier de configuration puis
+ * compiles en tables : le prix d'un sejour est une lecture de table.
+ */
+
+#ifndef TARIFICATION_H
+#define TARIFICATION_H
+
+#include "types.h"
+
+/* ============================================================================
+ * TYPES DE LA TARIFICATION
+ * ============================================================================ */
+
+/**
+ * @struct Sejour
+ * @brief Stationnement a facturer
+ */
+typedef struct {
+    TypeVehicule type;
+    Horodatage entree;
+    int dureeMinutes;
+} Sejour;
+
+/* ============================================================================
+ * CONFIGURATION DES TARIFS
+ * ============================================================================ */
+
+/**
+ * @brief Retablit les tarifs par defaut (TARIF_HORAIRE, TARIF_JOURNALIER_MAX)
+ */
+void appliquerTarifsParDefaut(void);
+
+/**
+ * @brief Charge et compile les tarifs depuis un fichier de configuration
+ * @param nomFichier Fichier de tarifs
+ * @return 1 si succes, 0 si fichier absent ou invalide (tarifs inchanges)
+ *
+ * Format, une directive par ligne ('#' pour les commentaires) :
+ *   tarif TYPE tarif_horaire plafond_journalier franchise_minutes
+ *   bande heure_debut heure_fin coefficient
+ * Une bande applique son coefficient au tarif horaire de tous les types
+ * pour les heures de heure_debut (incluse) a heure_fin (exclue).
+ */
+int chargerTarifs(const char *nomFichier);
+
+/* ============================================================================
+ * CALCUL DES MONTANTS
+ * ============================================================================ */
+
+/**
+ * @brief Calcule le montant a payer selon la duree et le type de vehicule
+ * @param dureeMinutes Duree de stationnement en minutes
+ * @param type Type de vehicule
+ * @return Montant a payer en FCFA, hors bandes horaires
+ */
+float calculerMontant(int dureeMinutes, TypeVehicule type);
+
+/**
+ * @brief Calcule le montant d'un sejour, bandes horaires comprises
+ * @param entree Heure d'entree (choix de la bande de la premiere heure)
+ * @param dureeMinutes Duree de stationnement en minutes
+ * @param type Type de vehicule
+ * @return Montant a payer en FCFA
+ */
+float calculerMontantSejour(Horodatage entree, int dureeMinutes,
+                            TypeVehicule type);
+
+/**
+ * @brief Calcule les montants d'un lot de sejours (cloture journaliere)
+ * @param sejours Tableau des sejours
+ * @param montants Tableau recevant les montants
+ * @param nombre Nombre de sejours
+ * @return Somme des montants du lot
+ */
+float calculerMontantsLot(const Sejour sejours[], float montants[], int nombre);
+
+#endif /* TARIFICATION_H */
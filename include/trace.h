@@ -0,0 +1,109 @@
+/**
+ * @file trace.h
+ * @brief Trace des operations au format Chrome (chrome://tracing, Perfetto)
+ * @date Decembre 2025
+ *
+ * Une fois la trace activee, chaque operation suivie (entree, sortie,
+ * recherche de place, tarification, journal, sauvegarde, affichage) note
+ * son debut et sa fin dans un anneau propre a son thread, sans verrou :
+ * seul le thread proprietaire ecrit dans son anneau, l'ecriture du fichier
+ * le relit. Un anneau plein ecrase ses plus anciens evenements ; le
+ * fichier porte donc les dernieres operations de chaque thread.
+ *
+ * Trace desactivee, chaque point de trace se reduit a un test de
+ * traceActive, toujours faux.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "types.h"
+
+/* ============================================================================
+ * TYPES DE LA TRACE
+ * ============================================================================ */
+
+/**
+ * @enum EvenementTrace
+ * @brief Operations suivies par la trace
+ */
+typedef enum {
+    TRACE_ENTREE = 0,           /* enregistrerEntree, entreeConcurrente */
+    TRACE_SORTIE = 1,           /* enregistrerSortie, sortieConcurrente */
+    TRACE_PLACE_LIBRE = 2,      /* rechercherPlaceLibre */
+    TRACE_TARIFICATION = 3,     /* calculerMontant, calculerMontantSejour */
+    TRACE_JOURNAL = 4,          /* synchroniserJournal */
+    TRACE_SAUVEGARDE = 5,       /* sauvegarderDonnees, lancement en fond */
+    TRACE_RENDU = 6,            /* ecriture d'un ecran compose */
+    TRACE_FUSION = 7,           /* fusionnerMoteurConcurrent */
+    NOMBRE_EVENEMENTS_TRACE = 8
+} EvenementTrace;
+
+/** Non nul quand la trace est activee (lu a chaque point de trace) */
+extern int traceActive;
+
+/** Debut d'une operation suivie */
+#define TRACER_DEBUT(evenement) \
+    do { \
+        if (traceActive) { \
+            tracerEvenement((evenement), 'B'); \
+        } \
+    } while (0)
+
+/** Fin d'une operation suivie */
+#define TRACER_FIN(evenement) \
+    do { \
+        if (traceActive) { \
+            tracerEvenement((evenement), 'E'); \
+        } \
+    } while (0)
+
+/* ============================================================================
+ * ENREGISTREMENT
+ * ============================================================================ */
+
+/**
+ * @brief Active la trace
+ * @param nomFichier Fichier ecrit par exporterTrace (NULL ou vide :
+ *        trace desactivee)
+ *
+ * A appeler avant de lancer les threads des voies ou du serveur.
+ */
+void activerTrace(const char *nomFichier);
+
+/**
+ * @brief Note le debut ou la fin d'une operation (par TRACER_DEBUT et
+ *        TRACER_FIN)
+ * @param evenement Operation suivie
+ * @param phase 'B' (debut) ou 'E' (fin)
+ */
+void tracerEvenement(EvenementTrace evenement, char phase);
+
+/**
+ * @brief Nomme le thread courant dans la trace ("voie 2"...) ; sans effet
+ *        trace desactivee
+ * @param nom Nom affiche
+ */
+void nommerThreadTrace(const char *nom);
+
+/* ============================================================================
+ * ECRITURE
+ * ============================================================================ */
+
+/**
+ * @brief Ecrit les evenements de tous les threads au format Chrome
+ * @param nomFichier Fichier de destination (remplace par renommage)
+ * @return SUCCES, ERREUR_PARAMETRE, ERREUR_MEMOIRE ou ERREUR_ENTREE_SORTIE
+ *
+ * Peut etre appelee pendant que les threads tracent : un evenement ecrase
+ * pendant la lecture est ecarte.
+ */
+int ecrireTrace(const char *nomFichier);
+
+/**
+ * @brief Ecrit la trace dans le fichier donne a activerTrace
+ * @return SUCCES (ou trace desactivee), sinon code d'erreur
+ */
+int exporterTrace(void);
+
+#endif /* TRACE_H */
@@ -5,6 +5,10 @@
  * 
  * Implementation des algorithmes de tri par selection et insertion,
  * ainsi que des algorithmes de recherche sequentielle et dichotomique.
+ *
+ * Pour les grands volumes (historique), le tri indirect trie des paires
+ * (cle, indice) par fusion en O(n log n) et rend une permutation : les
+ * enregistrements ne sont jamais deplaces.
  */
 
 #ifndef TRI_RECHERCHE_H
@@ -12,6 +16,16 @@
 
 #include "types.h"
 
+/**
+ * @enum CritereTri
+ * @brief Ordre d'un tri indirect
+ */
+typedef enum {
+    TRI_PAR_PLAQUE = 1,         /* Ordre alphabetique (strcmp) */
+    TRI_PAR_ENTREE = 2,         /* Date d'entree croissante */
+    TRI_PAR_MONTANT = 3         /* Montant paye decroissant */
+} CritereTri;
+
 /* ============================================================================
  * ALGORITHMES DE TRI
  * ============================================================================ */
@@ -50,6 +64,41 @@ void triPlacesParNumero(Place places[], int taille);
  */
 void triVehiculesParMontant(Vehicule vehicules[], int taille);
 
+/* ============================================================================
+ * TRI INDIRECT
+ * ============================================================================ */
+
+/**
+ * @brief Permutation qui ordonne un tableau de vehicules
+ * @param vehicules Tableau de vehicules (non modifie)
+ * @param taille Nombre d'elements
+ * @param critere Ordre voulu
+ * @param permutation Recoit les indices dans l'ordre (taille cases) :
+ *        vehicules[permutation[0]] est le premier
+ * @return SUCCES, ERREUR_PARAMETRE ou ERREUR_MEMOIRE
+ *
+ * Complexite : O(n log n), O(n) sur un tableau deja dans l'ordre
+ * Principe : tri fusion stable de paires (cle, indice) de 24 octets ; a
+ * cle egale, l'ordre du tableau est conserve
+ */
+int trierIndicesVehicules(const Vehicule vehicules[], int taille,
+                          CritereTri critere, int permutation[]);
+
+/**
+ * @brief Permutation qui ordonne l'historique du parking
+ * @param parking Pointeur vers le parking
+ * @param critere Ordre voulu
+ * @param permutation Recoit les indices (nombreVehicules cases), a lire
+ *        par lireVehicule
+ * @return SUCCES, ERREUR_PARAMETRE, ERREUR_MEMOIRE ou ERREUR_ENTREE_SORTIE
+ *         (segment archive illisible)
+ *
+ * L'historique est parcouru une fois, dans l'ordre, segments archives
+ * compris.
+ */
+int trierIndicesHistorique(const Parking *parking, CritereTri critere,
+                           int permutation[]);
+
 /* ============================================================================
  * ALGORITHMES DE RECHERCHE
  * ============================================================================ */
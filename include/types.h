@@ -10,19 +10,25 @@
 #ifndef TYPES_H
 #define TYPES_H
 
+#include <stdio.h>
+#include <stdint.h>
+
 /* ============================================================================
  * CONSTANTES DU SYSTEME
  * ============================================================================ */
 
-/** Nombre maximum de places dans le parking */
-#define MAX_PLACES 100
+/** Places par bloc de stockage (2^6 = 64) */
+#define DECALAGE_BLOC_PLACES 6
 
-/** Nombre maximum de vehicules dans l'historique */
-#define MAX_VEHICULES 500
+/** Vehicules par bloc d'historique (2^8 = 256) */
+#define DECALAGE_BLOC_HISTORIQUE 8
 
 /** Longueur maximale d'une chaine de caracteres */
 #define MAX_CHAINE 50
 
+/** Longueur maximale d'un chemin de fichier */
+#define MAX_CHEMIN 256
+
 /** Longueur d'une plaque d'immatriculation */
 #define TAILLE_PLAQUE 15
 
@@ -58,13 +64,58 @@ typedef enum {
     HORS_SERVICE = 3
 } EtatPlace;
 
+/**
+ * @enum SourceHorloge
+ * @brief Sources possibles de l'heure courante
+ */
+typedef enum {
+    HORLOGE_REELLE = 0,     /* Heure systeme, decomposee une fois par minute */
+    HORLOGE_MONOTONE = 1,   /* Heure de depart + temps ecoule monotone */
+    HORLOGE_SIMULEE = 2     /* Heure fixee et avancee par le programme */
+} SourceHorloge;
+
+/**
+ * @enum CodeErreur
+ * @brief Resultats des fonctions du coeur (negatifs en cas d'echec)
+ *
+ * Le coeur n'affiche rien : l'interface traduit ces codes en messages
+ * avec messageErreur.
+ */
+typedef enum {
+    SUCCES = 0,
+    ERREUR_PARAMETRE = -1,          /* Pointeur nul ou valeur hors bornes */
+    ERREUR_MEMOIRE = -2,
+    ERREUR_DEJA_PRESENT = -3,       /* Plaque deja dans le parking */
+    ERREUR_AUCUNE_PLACE = -4,       /* Aucune place libre pour ce type */
+    ERREUR_VEHICULE_ABSENT = -5,    /* Plaque inconnue du parking */
+    ERREUR_DEJA_SORTI = -6,
+    ERREUR_PLACE_INVALIDE = -7,     /* Numero de place hors du parking */
+    ERREUR_FICHIER_ABSENT = -8,
+    ERREUR_FICHIER_INVALIDE = -9,   /* Format, version ou controle incorrect */
+    ERREUR_ENTREE_SORTIE = -10,     /* Lecture, ecriture ou synchronisation */
+    ERREUR_PLACE_OCCUPEE = -11      /* Place portant un vehicule */
+} CodeErreur;
+
 /* ============================================================================
  * STRUCTURES DE DONNEES
  * ============================================================================ */
 
 /**
  * @struct Horodatage
- * @brief Structure pour representer une date et heure
+ * @brief Instant en minutes UTC depuis le 01/01/1970 00:00
+ *
+ * Une duree est une soustraction et une comparaison une comparaison
+ * d'entiers, justes meme a travers un changement d'heure ; l'heure
+ * locale n'est calculee que pour l'affichage et les tranches horaires
+ * (voir decomposerHorodatage et minutesLocales).
+ */
+typedef struct {
+    int32_t minutes;
+} Horodatage;
+
+/**
+ * @struct DateHeure
+ * @brief Champs calendaires d'un horodatage, pour l'affichage
  */
 typedef struct {
     int jour;
@@ -72,7 +123,22 @@ typedef struct {
     int annee;
     int heure;
     int minute;
-} Horodatage;
+} DateHeure;
+
+/**
+ * @struct Arene
+ * @brief Stockage extensible par blocs, sans deplacement des elements
+ */
+typedef struct {
+    void **blocs;
+    int nombreBlocs;
+    int capaciteBlocs;
+    int tailleElement;
+    int decalageBloc;
+    int nombreElements;
+    int debutEmprunt;
+    int finEmprunt;
+} Arene;
 
 /**
  * @struct Vehicule
@@ -84,6 +150,7 @@ typedef struct {
     TypeVehicule type;
     Horodatage entree;
     Horodatage sortie;
+    int numeroPlace;
     int estPresent;
     float montantPaye;
 } Vehicule;
@@ -99,18 +166,88 @@ typedef struct {
     Vehicule *vehiculeActuel;
 } Place;
 
+/**
+ * @struct ArchiveHistorique
+ * @brief Etat de l'archivage des segments anciens de l'historique
+ */
+typedef struct {
+    char fichier[MAX_CHEMIN];
+    int segmentsMax;
+    int ageMaxMinutes;
+    int premierBloc;
+    int blocEnCache;
+    Vehicule *cache;
+} ArchiveHistorique;
+
+/**
+ * @struct ControleHistorique
+ * @brief Sommes de controle des blocs pris dans la sauvegarde projetee
+ *
+ * Un bloc n'est controle qu'a son premier acces : ses pages ne sont lues
+ * qu'a ce moment-la.
+ */
+typedef struct {
+    int premierBloc;
+    int nombreBlocs;
+    const uint32_t *crcBlocs;
+    signed char *etats;         /* 0 : a controler, 1 : intact, -1 : corrompu */
+} ControleHistorique;
+
+/**
+ * @struct JournalParking
+ * @brief Journal des operations ouvert en ajout
+ */
+typedef struct {
+    char fichier[MAX_CHEMIN];
+    FILE *flux;
+    int groupeSynchro;
+    int delaiSynchroSecondes;
+    int enAttente;
+    long derniereSynchro;
+    long finValide;             /* Fin du dernier enregistrement complet */
+} JournalParking;
+
+/**
+ * @struct AgregatsParking
+ * @brief Compteurs cumules, tenus a jour a chaque entree et sortie
+ *
+ * Les tableaux sont indexes par type (indice 0 : type inconnu).
+ */
+typedef struct {
+    int entreesParType[5];
+    int sortiesParType[5];
+    int presentsParType[5];
+    float recettesParType[5];
+    int totalEntrees;
+    int totalSorties;
+    float sommeRecettes;
+    int nombreSortiesPayantes;
+} AgregatsParking;
+
 /**
  * @struct Parking
  * @brief Structure principale du parking
  */
 typedef struct {
     char nom[MAX_CHAINE];
-    Place places[MAX_PLACES];
+    Arene places;
     int nombrePlaces;
     int placesLibres;
     int placesOccupees;
-    Vehicule historique[MAX_VEHICULES];
+    unsigned long long *bitmapLibres[5];
+    int motsBitmap;
+    int placesLibresParType[5];
+    Arene historique;
     int nombreVehicules;
+    ArchiveHistorique *archive;
+    JournalParking *journal;
+    uint32_t sequenceJournal;
+    void *projection;
+    size_t tailleProjection;
+    ControleHistorique *controle;
+    int *indexPlaques;
+    int tailleIndex;
+    AgregatsParking agregats;
     float recetteJournaliere;
     float recetteTotale;
 } Parking;
@@ -82,16 +82,53 @@ const char* typeVehiculeEnChaine(TypeVehicule type);
  */
 const char* etatPlaceEnChaine(EtatPlace etat);
 
+/**
+ * @brief Message correspondant a un code d'erreur du coeur
+ * @param code Code retourne (CodeErreur, ou valeur negative quelconque)
+ * @return Message sans prefixe, termine par un point
+ */
+const char* messageErreur(int code);
+
 /* ============================================================================
  * FONCTIONS DE GESTION DU TEMPS
  * ============================================================================ */
 
 /**
- * @brief Obtient l'horodatage actuel du systeme
+ * @brief Obtient l'horodatage actuel de la source d'horloge choisie
  * @return Structure Horodatage avec la date et heure actuelles
  */
 Horodatage obtenirHorodatageActuel(void);
 
+/**
+ * @brief Choisit la source utilisee par obtenirHorodatageActuel
+ * @param source Horloge reelle (par defaut), monotone ou simulee
+ */
+void choisirSourceHorloge(SourceHorloge source);
+
+/**
+ * @brief Retourne la source d'horloge courante
+ * @return Source utilisee par obtenirHorodatageActuel
+ */
+SourceHorloge sourceHorlogeCourante(void);
+
+/**
+ * @brief Regle l'heure de l'horloge simulee
+ * @param h Nouvel horodatage courant
+ */
+void reglerHorlogeSimulee(Horodatage h);
+
+/**
+ * @brief Avance l'horloge simulee
+ * @param minutes Nombre de minutes a ajouter
+ */
+void avancerHorlogeSimulee(int minutes);
+
+/**
+ * @brief Instant monotone en secondes, insensible aux reglages d'heure
+ * @return Secondes depuis une origine arbitraire (mesure de durees)
+ */
+double instantMonotone(void);
+
 /**
  * @brief Calcule la duree en minutes entre deux horodatages
  * @param debut Horodatage de debut
@@ -100,6 +137,20 @@ Horodatage obtenirHorodatageActuel(void);
  */
 int calculerDureeMinutes(Horodatage debut, Horodatage fin);
 
+/**
+ * @brief Minutes en heure locale depuis le 01/01/1970 00:00 locale
+ * @param h Horodatage
+ * @return Minutes locales (heure du jour : minutes / 60 % 24)
+ */
+int32_t minutesLocales(Horodatage h);
+
+/**
+ * @brief Calcule les champs calendaires d'un horodatage en heure locale
+ * @param h Horodatage
+ * @return Jour, mois, annee, heure et minute correspondants
+ */
+DateHeure decomposerHorodatage(Horodatage h);
+
 /**
  * @brief Formate un horodatage en chaine lisible
  * @param h Horodatage a formater
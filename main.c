@@ -16,44 +16,200 @@
 #include "include/utilitaires.h"
 #include "include/parking.h"
 #include "include/statistiques.h"
+#include "include/persistance.h"
+#include "include/journal.h"
 #include "include/menu.h"
+#include "include/tarification.h"
+#include "include/mode_lot.h"
+#include "include/moteur_concurrent.h"
+#include "include/rendu.h"
+#include "include/tableau_bord.h"
+#include "include/serveur.h"
+#include "include/instrumentation.h"
+#include "include/metriques.h"
+#include "include/trace.h"
 
 /* Prototypes des fonctions locales */
 void executerMenuVehicules(Parking *parking);
 void executerMenuPlaces(Parking *parking);
 void executerMenuStatistiques(Parking *parking);
 void afficherBanniere(void);
+int chargerParking(Parking *parking);
+int ouvrirJournalParking(Parking *parking);
+void sauvegarderParking(Parking *parking);
+void signalerSauvegardeArrierePlan(int resultat);
+int executerModeLot(Parking *parking, const char *fichier);
+int executerModeVoies(Parking *parking, int nombreVoies, char *fichiers[]);
+int executerModeServeur(Parking *parking, const char *adresse);
+int executerModeTableau(Parking *parking, int periodeMillisecondes);
 
-/* Nom du fichier de sauvegarde */
+/* Fichier de configuration des tarifs */
+#define FICHIER_TARIFS "tarifs.cfg"
+
+/* Nom du fichier de sauvegarde et intervalle des sauvegardes periodiques */
 #define FICHIER_SAUVEGARDE "parking_data.dat"
+#define INTERVALLE_SAUVEGARDE_SECONDES 300
+
+/* Archivage de l'historique : fichier, segments gardes, age maximal */
+#define FICHIER_ARCHIVE "parking_archive.dat"
+#define SEGMENTS_EN_MEMOIRE 4
+#define AGE_ARCHIVAGE_MINUTES (7 * 24 * 60)
+
+/* Journal des operations : synchronisation par groupes d'operations */
+#define FICHIER_JOURNAL "parking_journal.dat"
+#define JOURNAL_GROUPE_SYNCHRO 16
+#define JOURNAL_DELAI_SYNCHRO_SECONDES 1
+
+/* Releve des latences et erreurs des operations (menu statistiques) */
+#define FICHIER_MESURES "parking_mesures.txt"
+
+/* Metriques pour le collecteur textfile de node_exporter ; la variable
+ * d'environnement PARKING_METRIQUES choisit un autre fichier (vide :
+ * aucun export) */
+#define FICHIER_METRIQUES "parking_metriques.prom"
+#define INTERVALLE_METRIQUES_SECONDES 1
+
+/* Trace Chrome des operations : activee par la variable d'environnement
+ * PARKING_TRACE (fichier ecrit en fin d'execution, au releve des mesures
+ * et, pour le serveur, a la reception de SIGUSR1) */
+
+/* Tampon des flux du mode par lot */
+#define TAILLE_TAMPON_LOT 65536
+
+/* Periode par defaut du tableau de bord (millisecondes) */
+#define PERIODE_TABLEAU_MS 250
+
+/* Flux des messages d'information et d'erreur (sortie d'erreur en mode par
+ * lot, en mode concurrent, en serveur et pour le tableau de bord, la sortie
+ * standard ne portant alors que les reponses ou l'ecran) */
+static FILE *fluxMessages;
 
 /* ============================================================================
  * FONCTION PRINCIPALE
  * ============================================================================ */
 
-int main(void)
+int main(int argc, char *argv[])
 {
     Parking parking;
+    const char *fichierMetriques;
     int choix;
     int continuer;
+    int modeLot;
+    int modeVoies;
+    int modeServeur;
+    int modeTableau;
+    int periode;
     
-    /* Affichage de la banniere d'accueil */
-    effacerEcran();
-    afficherBanniere();
+    /* Mode par lot : parking --lot <fichier|->
+     * Voies concurrentes : parking --voies <fichier> [fichier...]
+     * Serveur des bornes : parking --serveur <port|socket Unix>
+     * Tableau de bord : parking --tableau-bord [periode en ms] */
+    modeLot = argc == 3 && strcmp(argv[1], "--lot") == 0;
+    modeVoies = argc >= 3 && strcmp(argv[1], "--voies") == 0;
+    modeServeur = argc == 3 && strcmp(argv[1], "--serveur") == 0;
+    modeTableau = (argc == 2 || argc == 3) &&
+                  strcmp(argv[1], "--tableau-bord") == 0;
+    periode = argc == 3 && modeTableau ? atoi(argv[2]) : PERIODE_TABLEAU_MS;
+    fluxMessages = modeLot || modeVoies || modeServeur || modeTableau ?
+                   stderr : stdout;
+    
+    if ((argc > 1 && modeLot == 0 && modeVoies == 0 && modeServeur == 0 &&
+         modeTableau == 0) || periode <= 0) {
+        printf("Usage : %s [--lot <fichier de commandes|->]\n"
+               "       %s --voies <fichier de commandes> [fichier...]\n"
+               "       %s --serveur <port|chemin de socket Unix>\n"
+               "       %s --tableau-bord [periode en millisecondes]\n",
+               argv[0], argv[0], argv[0], argv[0]);
+        return 1;
+    }
+    
+    if (modeLot) {
+        /* Reponses tamponnees : a regler avant toute ecriture */
+        setvbuf(stdout, NULL, _IOFBF, TAILLE_TAMPON_LOT);
+    } else if (modeVoies == 0 && modeServeur == 0 && modeTableau == 0) {
+        /* Affichage de la banniere d'accueil */
+        effacerEcran();
+        afficherBanniere();
+    }
     
     /* Initialisation du parking */
     if (initialiserParking(&parking, "Parking Central", 50) == 0) {
-        printf("Erreur fatale : Impossible d'initialiser le parking.\n");
+        fprintf(fluxMessages,
+                "Erreur fatale : Impossible d'initialiser le parking.\n");
         return 1;
     }
     
-    /* Tentative de chargement des donnees existantes */
-    chargerDonnees(&parking, FICHIER_SAUVEGARDE);
+    /* Tarifs : fichier de configuration, sinon valeurs par defaut */
+    if (chargerTarifs(FICHIER_TARIFS) == 0) {
+        fprintf(fluxMessages,
+                "Information : Tarifs par defaut (%s absent ou invalide).\n",
+                FICHIER_TARIFS);
+        appliquerTarifsParDefaut();
+    }
+    
+    activerTrace(getenv("PARKING_TRACE"));
+    
+    if (modeTableau) {
+        continuer = executerModeTableau(&parking, periode);
+        exporterTrace();
+        libererParking(&parking);
+        libererRendu();
+        return continuer ? 0 : 1;
+    }
+    
+    /* Derniere sauvegarde, puis operations journalisees depuis */
+    if (chargerParking(&parking) == 0) {
+        fprintf(fluxMessages, "Erreur fatale : %s et %s laisses "
+                "intacts, a verifier.\n",
+                FICHIER_SAUVEGARDE, FICHIER_JOURNAL);
+        libererParking(&parking);
+        return 1;
+    }
+    configurerSauvegardePeriodique(FICHIER_SAUVEGARDE,
+                                   INTERVALLE_SAUVEGARDE_SECONDES);
+    fichierMetriques = getenv("PARKING_METRIQUES");
+    configurerExportMetriques(fichierMetriques != NULL ? fichierMetriques :
+                              FICHIER_METRIQUES,
+                              INTERVALLE_METRIQUES_SECONDES);
+    
+    if (modeLot) {
+        continuer = executerModeLot(&parking, argv[2]);
+        exporterTrace();
+        libererParking(&parking);
+        return continuer ? 0 : 1;
+    }
+    
+    if (modeVoies) {
+        continuer = executerModeVoies(&parking, argc - 2, argv + 2);
+        exporterTrace();
+        libererParking(&parking);
+        return continuer ? 0 : 1;
+    }
+    
+    if (modeServeur) {
+        continuer = executerModeServeur(&parking, argv[2]);
+        exporterTrace();
+        libererParking(&parking);
+        return continuer ? 0 : 1;
+    }
     
     /* Boucle principale du programme */
     continuer = 1;
     
     while (continuer == 1) {
+        /* Les segments anciens de l'historique partent sur disque */
+        archiverHistorique(&parking);
+        
+        /* Sauvegarde periodique en arriere-plan */
+        signalerSauvegardeArrierePlan(sauvegarderSiEcheance(&parking));
+        exporterMetriquesSiEcheance(&parking);
+        
+        /* Operations durables avant d'attendre l'operateur */
+        if (synchroniserJournal(&parking) == 0) {
+            printf("Erreur : Synchronisation du journal %s impossible.\n",
+                   FICHIER_JOURNAL);
+        }
+        
         choix = afficherMenuPrincipal();
         
         switch (choix) {
@@ -79,18 +235,26 @@ int main(void)
                 
             case 5:
                 /* Sauvegarde */
-                sauvegarderDonnees(&parking, FICHIER_SAUVEGARDE);
+                sauvegarderParking(&parking);
                 break;
                 
             case 6:
-                /* Chargement */
-                chargerDonnees(&parking, FICHIER_SAUVEGARDE);
+                /* Chargement : sauvegarde ou journal incoherents, arret
+                 * sans la sauvegarde automatique qui les remplacerait */
+                if (chargerParking(&parking) == 0) {
+                    fprintf(fluxMessages, "Erreur fatale : %s et %s laisses "
+                            "intacts, a verifier.\n",
+                            FICHIER_SAUVEGARDE, FICHIER_JOURNAL);
+                    continuer = -1;
+                }
                 break;
                 
             case 0:
                 /* Quitter */
                 printf("\nSauvegarde automatique en cours...\n");
-                sauvegarderDonnees(&parking, FICHIER_SAUVEGARDE);
+                sauvegarderParking(&parking);
+                exporterMetriques(&parking);
+                exporterTrace();
                 printf("\nMerci d'avoir utilise le systeme.\n");
                 printf("Au revoir !\n\n");
                 continuer = 0;
@@ -103,8 +267,9 @@ int main(void)
     
     /* Liberation des ressources */
     libererParking(&parking);
+    libererRendu();
     
-    return 0;
+    return continuer == 0 ? 0 : 1;
 }
 
 /* ============================================================================
@@ -148,6 +313,7 @@ void executerMenuPlaces(Parking *parking)
     int choix;
     int continuer;
     int numeroPlace;
+    int resultat;
     
     continuer = 1;
     
@@ -161,20 +327,33 @@ void executerMenuPlaces(Parking *parking)
             case 2:
                 printf("Place a mettre hors service : ");
                 numeroPlace = lireEntier(1, parking->nombrePlaces);
-                modifierEtatPlace(parking, numeroPlace, HORS_SERVICE);
-                printf("Place %d mise hors service.\n", numeroPlace);
+                resultat = modifierEtatPlace(parking, numeroPlace,
+                                             HORS_SERVICE);
+                if (resultat == SUCCES) {
+                    printf("Place %d mise hors service.\n", numeroPlace);
+                } else {
+                    printf("Erreur : %s\n", messageErreur(resultat));
+                }
                 break;
             case 3:
                 printf("Place a remettre en service : ");
                 numeroPlace = lireEntier(1, parking->nombrePlaces);
-                modifierEtatPlace(parking, numeroPlace, LIBRE);
-                printf("Place %d remise en service.\n", numeroPlace);
+                resultat = modifierEtatPlace(parking, numeroPlace, LIBRE);
+                if (resultat == SUCCES) {
+                    printf("Place %d remise en service.\n", numeroPlace);
+                } else {
+                    printf("Erreur : %s\n", messageErreur(resultat));
+                }
                 break;
             case 4:
                 printf("Place a reserver : ");
                 numeroPlace = lireEntier(1, parking->nombrePlaces);
-                modifierEtatPlace(parking, numeroPlace, RESERVEE);
-                printf("Place %d reservee.\n", numeroPlace);
+                resultat = modifierEtatPlace(parking, numeroPlace, RESERVEE);
+                if (resultat == SUCCES) {
+                    printf("Place %d reservee.\n", numeroPlace);
+                } else {
+                    printf("Erreur : %s\n", messageErreur(resultat));
+                }
                 break;
             case 0:
                 continuer = 0;
@@ -187,6 +366,7 @@ void executerMenuStatistiques(Parking *parking)
 {
     int choix;
     int continuer;
+    int resultat;
     
     continuer = 1;
     
@@ -206,6 +386,33 @@ void executerMenuStatistiques(Parking *parking)
             case 4:
                 afficherRecettesParType(parking);
                 break;
+            case 5:
+                afficherMesuresOperations();
+                resultat = ecrireMesures(FICHIER_MESURES);
+                if (resultat == SUCCES) {
+                    printf("Releve ecrit dans %s.\n", FICHIER_MESURES);
+                } else {
+                    printf("Erreur : %s : %s\n", FICHIER_MESURES,
+                           messageErreur(resultat));
+                }
+                /* Trace a la demande : derniers evenements de chaque thread */
+                if (traceActive) {
+                    resultat = exporterTrace();
+                    if (resultat == SUCCES) {
+                        printf("Trace ecrite (%s).\n",
+                               getenv("PARKING_TRACE"));
+                    } else {
+                        printf("Erreur : Trace : %s\n",
+                               messageErreur(resultat));
+                    }
+                }
+                break;
+            case 6:
+                printf("Ordre (1. Plaque  2. Date d'entree  "
+                       "3. Montant decroissant) : ");
+                afficherHistoriqueTrie(parking, (CritereTri)lireEntier(1, 3),
+                                       20);
+                break;
             case 0:
                 continuer = 0;
                 break;
@@ -230,3 +437,315 @@ void afficherBanniere(void)
     afficherLigne('=', 55);
     printf("\n");
 }
+
+/* ============================================================================
+ * MODE PAR LOT
+ * ============================================================================ */
+
+int executerModeLot(Parking *parking, const char *fichier)
+{
+    FILE *entree;
+    BilanLot bilan;
+    int resultat;
+    
+    /* "-" designe l'entree standard */
+    if (strcmp(fichier, "-") == 0) {
+        entree = stdin;
+    } else {
+        entree = fopen(fichier, "r");
+        if (entree == NULL) {
+            fprintf(stderr, "Erreur : Impossible d'ouvrir %s\n", fichier);
+            return 0;
+        }
+    }
+    setvbuf(entree, NULL, _IOFBF, TAILLE_TAMPON_LOT);
+    
+    resultat = executerLot(parking, entree, stdout, &bilan);
+    
+    if (entree != stdin) {
+        fclose(entree);
+    }
+    
+    /* Fin du lot : operations sur disque puis sauvegarde complete */
+    synchroniserJournal(parking);
+    sauvegarderParking(parking);
+    exporterMetriques(parking);
+    fflush(stdout);
+    
+    afficherBilanLot(&bilan, stderr);
+    
+    return resultat;
+}
+
+/* ============================================================================
+ * VOIES CONCURRENTES
+ * ============================================================================ */
+
+/**
+ * @brief Ouvre les commandes de chaque voie et son fichier de reponses
+ * @param entrees Recoit les flux des commandes
+ * @param sorties Recoit les flux des reponses (<fichier>.rep)
+ * @param nombreVoies Nombre de voies
+ * @param fichiers Fichiers de commandes
+ * @return 1 si tous les flux sont ouverts, 0 sinon
+ */
+static int ouvrirFluxVoies(FILE *entrees[], FILE *sorties[], int nombreVoies,
+                           char *fichiers[])
+{
+    char nomReponses[FILENAME_MAX];
+    int v;
+    
+    for (v = 0; v < nombreVoies; v++) {
+        entrees[v] = fopen(fichiers[v], "r");
+        if (entrees[v] == NULL) {
+            fprintf(stderr, "Erreur : Impossible d'ouvrir %s\n", fichiers[v]);
+            return 0;
+        }
+        setvbuf(entrees[v], NULL, _IOFBF, TAILLE_TAMPON_LOT);
+        
+        if (strlen(fichiers[v]) + 5 > sizeof(nomReponses)) {
+            fprintf(stderr, "Erreur : Nom trop long : %s\n", fichiers[v]);
+            return 0;
+        }
+        sprintf(nomReponses, "%s.rep", fichiers[v]);
+        
+        sorties[v] = fopen(nomReponses, "w");
+        if (sorties[v] == NULL) {
+            fprintf(stderr, "Erreur : Impossible de creer %s\n",
+                    nomReponses);
+            return 0;
+        }
+        setvbuf(sorties[v], NULL, _IOFBF, TAILLE_TAMPON_LOT);
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief Affiche le bilan de chaque voie puis celui de l'ensemble
+ * @param bilans Bilans des voies
+ * @param nombreVoies Nombre de voies
+ * @param fichiers Fichiers de commandes
+ * @param secondes Duree totale de l'execution
+ */
+static void afficherBilansVoies(const BilanLot bilans[], int nombreVoies,
+                                char *fichiers[], double secondes)
+{
+    BilanLot total;
+    int v;
+    
+    memset(&total, 0, sizeof(total));
+    
+    for (v = 0; v < nombreVoies; v++) {
+        fprintf(stderr, "\nVoie %d : %s\n", v + 1, fichiers[v]);
+        afficherBilanLot(&bilans[v], stderr);
+        
+        total.commandes += bilans[v].commandes;
+        total.entrees += bilans[v].entrees;
+        total.sorties += bilans[v].sorties;
+        total.changementsEtat += bilans[v].changementsEtat;
+        total.rapports += bilans[v].rapports;
+        total.consultations += bilans[v].consultations;
+        total.erreurs += bilans[v].erreurs;
+    }
+    
+    /* Debit d'ensemble : les voies s'executent en meme temps */
+    total.secondes = secondes;
+    fprintf(stderr, "\nEnsemble des %d voies\n", nombreVoies);
+    afficherBilanLot(&total, stderr);
+}
+
+int executerModeVoies(Parking *parking, int nombreVoies, char *fichiers[])
+{
+    MoteurConcurrent *moteur;
+    FILE **entrees;
+    FILE **sorties;
+    BilanLot *bilans;
+    double debut;
+    double secondes;
+    int fusionnees;
+    int resultat;
+    int v;
+    
+    entrees = (FILE**)calloc(nombreVoies, sizeof(FILE*));
+    sorties = (FILE**)calloc(nombreVoies, sizeof(FILE*));
+    bilans = (BilanLot*)calloc(nombreVoies, sizeof(BilanLot));
+    moteur = creerMoteurConcurrent(parking, nombreVoies);
+    resultat = 0;
+    
+    if (entrees == NULL || sorties == NULL || bilans == NULL ||
+        moteur == NULL) {
+        fprintf(stderr, "Erreur : %s\n", messageErreur(ERREUR_MEMOIRE));
+    } else if (ouvrirFluxVoies(entrees, sorties, nombreVoies, fichiers)) {
+        debut = instantMonotone();
+        resultat = executerLotConcurrent(moteur, entrees, sorties,
+                                         nombreVoies, bilans);
+        secondes = instantMonotone() - debut;
+        
+        /* Dernieres operations des voies reportees dans le parking et son
+         * journal ; sans elles, ni sauvegarde ni compaction du journal */
+        fusionnees = fusionnerMoteurConcurrent(moteur);
+        synchroniserJournal(parking);
+        if (fusionnees < 0) {
+            fprintf(stderr, "Erreur : Fusion des voies : %s\n",
+                    messageErreur(fusionnees));
+            resultat = 0;
+        } else {
+            sauvegarderParking(parking);
+        }
+        exporterMetriques(parking);
+        
+        afficherBilansVoies(bilans, nombreVoies, fichiers, secondes);
+    }
+    
+    for (v = 0; v < nombreVoies; v++) {
+        if (entrees != NULL && entrees[v] != NULL) {
+            fclose(entrees[v]);
+        }
+        if (sorties != NULL && sorties[v] != NULL) {
+            fclose(sorties[v]);
+        }
+    }
+    
+    detruireMoteurConcurrent(moteur);
+    free(entrees);
+    free(sorties);
+    free(bilans);
+    
+    return resultat;
+}
+
+/* ============================================================================
+ * SERVEUR DES BORNES
+ * ============================================================================ */
+
+int executerModeServeur(Parking *parking, const char *adresse)
+{
+    BilanLot bilan;
+    int resultat;
+    
+    fprintf(stderr, "Serveur des bornes sur %s (Ctrl+C pour arreter)\n",
+            adresse);
+    
+    resultat = executerServeur(parking, adresse, &bilan);
+    if (resultat != SUCCES) {
+        fprintf(stderr, "Erreur : Serveur %s : %s\n", adresse,
+                messageErreur(resultat));
+    }
+    
+    /* Arret : operations sur disque puis sauvegarde complete ; apres un
+     * echec, le journal reste seul a porter les operations confirmees */
+    if (resultat == SUCCES && synchroniserJournal(parking)) {
+        sauvegarderParking(parking);
+    }
+    exporterMetriques(parking);
+    
+    afficherBilanLot(&bilan, stderr);
+    
+    return resultat == SUCCES;
+}
+
+/* ============================================================================
+ * TABLEAU DE BORD
+ * ============================================================================ */
+
+int executerModeTableau(Parking *parking, int periodeMillisecondes)
+{
+    int resultat;
+    
+    /* Observateur : la sauvegarde est lue, le journal suivi sans etre
+     * ouvert en ecriture (il appartient a l'instance en service) */
+    resultat = chargerDonnees(parking, FICHIER_SAUVEGARDE);
+    if (resultat != SUCCES && resultat != ERREUR_FICHIER_ABSENT) {
+        fprintf(stderr, "Erreur : %s : %s\n", FICHIER_SAUVEGARDE,
+                messageErreur(resultat));
+        return 0;
+    }
+    
+    resultat = executerTableauBord(parking, FICHIER_SAUVEGARDE,
+                                   FICHIER_JOURNAL, periodeMillisecondes);
+    if (resultat != SUCCES) {
+        fprintf(stderr, "Erreur : %s\n", messageErreur(resultat));
+        return 0;
+    }
+    
+    return 1;
+}
+
+/* ============================================================================
+ * JOURNAL ET SAUVEGARDE
+ * ============================================================================ */
+
+int chargerParking(Parking *parking)
+{
+    int resultat;
+    
+    resultat = chargerDonnees(parking, FICHIER_SAUVEGARDE);
+    
+    if (resultat == SUCCES) {
+        fprintf(fluxMessages, "Donnees chargees avec succes depuis %s\n",
+                FICHIER_SAUVEGARDE);
+    } else if (resultat == ERREUR_FICHIER_ABSENT) {
+        fprintf(fluxMessages, "Information : Aucune sauvegarde trouvee.\n");
+    } else {
+        /* Le journal ne prolonge que la sauvegarde illisible : il n'est pas
+         * rejoue, et une nouvelle sauvegarde ne doit pas la remplacer */
+        fprintf(fluxMessages, "Erreur : %s : %s\n", FICHIER_SAUVEGARDE,
+                messageErreur(resultat));
+        return 0;
+    }
+    
+    configurerArchivage(parking, FICHIER_ARCHIVE,
+                        SEGMENTS_EN_MEMOIRE, AGE_ARCHIVAGE_MINUTES);
+    return ouvrirJournalParking(parking);
+}
+
+int ouvrirJournalParking(Parking *parking)
+{
+    int rejouees;
+    
+    rejouees = ouvrirJournal(parking, FICHIER_JOURNAL, JOURNAL_GROUPE_SYNCHRO,
+                             JOURNAL_DELAI_SYNCHRO_SECONDES);
+    
+    if (rejouees < 0) {
+        fprintf(fluxMessages, "Erreur : Journal %s : %s\n", FICHIER_JOURNAL,
+                messageErreur(rejouees));
+    } else if (rejouees > 0) {
+        fprintf(fluxMessages,
+                "Information : %d operation(s) du journal rejouee(s).\n",
+                rejouees);
+    }
+    
+    /* Journal sans rapport avec la sauvegarde : le service s'arrete plutot
+     * que d'ecrire une sauvegarde qui l'ignorerait */
+    return rejouees != ERREUR_FICHIER_INVALIDE;
+}
+
+void sauvegarderParking(Parking *parking)
+{
+    int resultat;
+    
+    signalerSauvegardeArrierePlan(attendreSauvegardeAsynchrone(parking));
+    
+    resultat = sauvegarderDonnees(parking, FICHIER_SAUVEGARDE);
+    
+    if (resultat != SUCCES) {
+        fprintf(fluxMessages, "Erreur : %s : %s\n", FICHIER_SAUVEGARDE,
+                messageErreur(resultat));
+        return;
+    }
+    
+    fprintf(fluxMessages, "Donnees sauvegardees avec succes dans %s\n",
+            FICHIER_SAUVEGARDE);
+    
+    /* Une sauvegarde complete rend le journal inutile jusqu'ici */
+    compacterJournal(parking, parking->sequenceJournal);
+}
+
+void signalerSauvegardeArrierePlan(int resultat)
+{
+    if (resultat == -1) {
+        fprintf(fluxMessages,
+                "Erreur : Echec de la sauvegarde en arriere-plan.\n");
+    }
+}
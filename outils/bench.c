@@ -0,0 +1,887 @@
+/**
+ * @file bench.c
+ * @brief Mesures de performance des operations du coeur (make bench)
+ * @date Decembre 2025
+ *
+ * Chaque mesure est repetee en echantillons : un echantillon execute un
+ * lot d'operations et donne son temps moyen par operation (ns/op). Les
+ * percentiles sont pris sur ces echantillons, apres un echantillon de
+ * chauffe ecarte. Graine aleatoire fixe, horloge simulee et tarifs par
+ * defaut : deux executions du meme binaire mesurent le meme travail.
+ *
+ * Les resultats sont ecrits en JSON sur la sortie standard, la
+ * progression sur la sortie d'erreur.
+ *
+ * Usage : bench_parking [--rapide]
+ *   --rapide  tailles et echantillons reduits (verification avant envoi)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/types.h"
+#include "../include/parking.h"
+#include "../include/utilitaires.h"
+#include "../include/tarification.h"
+#include "../include/statistiques.h"
+#include "../include/tri_recherche.h"
+
+/** Echantillons par mesure (hors chauffe) */
+#define ECHANTILLONS 31
+#define ECHANTILLONS_RAPIDES 11
+
+/** Duree visee d'un echantillon pour les operations sans etat (secondes) */
+#define DUREE_ECHANTILLON 0.002
+
+/** Valeurs aleatoires precalculees pour les operations sans etat */
+#define NOMBRE_VALEURS 4096
+
+/** Graine fixe du generateur */
+#define GRAINE_BENCH 20251201u
+
+/* ============================================================================
+ * CONTEXTE DES MESURES
+ * ============================================================================ */
+
+/**
+ * @struct ContexteBench
+ * @brief Donnees preparees pour une mesure
+ */
+typedef struct {
+    Parking parking;
+    int parkingPret;
+    char (*plaques)[TAILLE_PLAQUE];
+    int nombrePlaques;
+    int prochaineNouvelle;
+    Vehicule *vehicules;
+    Vehicule *travail;
+    Place *places;
+    Place *travailPlaces;
+    int taille;
+    int durees[NOMBRE_VALEURS];
+    TypeVehicule types[NOMBRE_VALEURS];
+    Horodatage debuts[NOMBRE_VALEURS];
+    Horodatage fins[NOMBRE_VALEURS];
+} ContexteBench;
+
+/**
+ * @brief Execute un lot d'operations mesurees
+ * @return Duree mesuree en secondes (preparation exclue)
+ */
+typedef double (*FonctionBench)(ContexteBench *contexte, int nombre);
+
+/** Etat du generateur pseudo-aleatoire */
+static unsigned int etatAleatoire = GRAINE_BENCH;
+
+/** Resultats consommes, pour que le compilateur garde les appels */
+static volatile double puits;
+
+/** Echantillons par mesure */
+static int nombreEchantillons = ECHANTILLONS;
+
+/** Premier resultat ecrit (separateur JSON) */
+static int premierResultat = 1;
+
+/**
+ * @brief Generateur xorshift32 (suite identique a chaque execution)
+ * @return Entier pseudo-aleatoire
+ */
+static unsigned int tirerAleatoire(void)
+{
+    etatAleatoire ^= etatAleatoire << 13;
+    etatAleatoire ^= etatAleatoire >> 17;
+    etatAleatoire ^= etatAleatoire << 5;
+
+    return etatAleatoire;
+}
+
+/**
+ * @brief Forme une plaque unique et triable a partir d'un numero
+ * @param numero Numero de la plaque
+ * @param plaque Recoit la plaque
+ */
+static void formerPlaque(int numero, char *plaque)
+{
+    sprintf(plaque, "BE%08d", numero);
+}
+
+/**
+ * @brief Indice de la cle cherchee par la i-eme operation, reparti sur
+ *        tout le tableau meme pour un petit lot
+ * @param i Rang de l'operation
+ * @param taille Nombre d'elements
+ * @return Indice dans [0, taille)
+ */
+static int indiceCle(int i, int taille)
+{
+    return (int)(((unsigned int)i * 2654435761u) % (unsigned int)taille);
+}
+
+/* ============================================================================
+ * MESURE ET RESULTATS
+ * ============================================================================ */
+
+static int comparerDurees(const void *a, const void *b)
+{
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Percentile par rang le plus proche
+ * @param valeurs Valeurs triees
+ * @param nombre Nombre de valeurs
+ * @param percentile Percentile (0 a 100)
+ * @return Valeur du percentile
+ */
+static double percentile(const double valeurs[], int nombre, int percentile)
+{
+    int rang;
+
+    rang = (percentile * nombre + 99) / 100;
+    if (rang < 1) {
+        rang = 1;
+    }
+
+    return valeurs[rang - 1];
+}
+
+/**
+ * @brief Choisit le nombre d'operations d'un echantillon
+ * @param fonction Operation mesuree (sans etat)
+ * @param contexte Contexte prepare
+ * @return Nombre d'operations pour environ DUREE_ECHANTILLON secondes
+ */
+static int calibrerLot(FonctionBench fonction, ContexteBench *contexte)
+{
+    int nombre;
+
+    nombre = 1;
+    while (nombre < (1 << 24) &&
+           fonction(contexte, nombre) < DUREE_ECHANTILLON) {
+        nombre *= 2;
+    }
+
+    return nombre;
+}
+
+/**
+ * @brief Mesure une operation et ecrit son resultat JSON
+ * @param nom Nom de l'operation (fonction du coeur)
+ * @param dimension Grandeur variee : places, historique ou elements
+ * @param taille Valeur de la grandeur
+ * @param fonction Operation mesuree
+ * @param contexte Contexte prepare
+ * @param lot Operations par echantillon, 0 pour calibrer
+ */
+static void mesurer(const char *nom, const char *dimension, int taille,
+                    FonctionBench fonction, ContexteBench *contexte, int lot)
+{
+    double *durees;
+    double somme;
+    int i;
+
+    durees = (double*)malloc(nombreEchantillons * sizeof(double));
+    if (durees == NULL) {
+        return;
+    }
+
+    if (lot == 0) {
+        lot = calibrerLot(fonction, contexte);
+    }
+
+    /* Echantillon de chauffe (caches, pages) ecarte */
+    fonction(contexte, lot);
+
+    somme = 0.0;
+    for (i = 0; i < nombreEchantillons; i++) {
+        durees[i] = fonction(contexte, lot) * 1e9 / lot;
+        somme += durees[i];
+    }
+
+    qsort(durees, nombreEchantillons, sizeof(double), comparerDurees);
+
+    printf("%s\n    {\"operation\": \"%s\", \"dimension\": \"%s\", "
+           "\"taille\": %d, \"operations_par_echantillon\": %d, "
+           "\"echantillons\": %d,\n     \"ns_par_op\": {\"min\": %.1f, "
+           "\"p50\": %.1f, \"p90\": %.1f, \"p99\": %.1f, \"max\": %.1f, "
+           "\"moyenne\": %.1f}}",
+           premierResultat ? "" : ",", nom, dimension, taille, lot,
+           nombreEchantillons, durees[0],
+           percentile(durees, nombreEchantillons, 50),
+           percentile(durees, nombreEchantillons, 90),
+           percentile(durees, nombreEchantillons, 99),
+           durees[nombreEchantillons - 1], somme / nombreEchantillons);
+    fflush(stdout);
+    premierResultat = 0;
+
+    fprintf(stderr, "  %-28s %-11s %8d : %10.1f ns/op (p50)\n", nom,
+            dimension, taille, percentile(durees, nombreEchantillons, 50));
+
+    free(durees);
+}
+
+/* ============================================================================
+ * PREPARATION
+ * ============================================================================ */
+
+/**
+ * @brief Prepare un parking et la liste des plaques presentes
+ * @param contexte Contexte a preparer
+ * @param nombrePlaces Nombre de places
+ * @param historique Sejours termines a placer dans l'historique
+ * @param presents Pourcentage de places occupees par un vehicule
+ * @return 1 si succes, 0 si memoire insuffisante
+ */
+static int preparerParking(ContexteBench *contexte, int nombrePlaces,
+                           int historique, int presents)
+{
+    char plaque[TAILLE_PLAQUE];
+    int nombre;
+    int i;
+
+    memset(contexte, 0, sizeof(*contexte));
+    etatAleatoire = GRAINE_BENCH;
+
+    if (initialiserParking(&contexte->parking, "Bench", nombrePlaces) == 0) {
+        return 0;
+    }
+    contexte->parkingPret = 1;
+
+    /* Sejours termines : l'historique grandit, le parking reste vide */
+    for (i = 0; i < historique; i++) {
+        formerPlaque(90000000 + i % 1000000, plaque);
+        if (enregistrerEntree(&contexte->parking, plaque, "Historique",
+                              VOITURE) < 0 ||
+            enregistrerSortie(&contexte->parking, plaque, NULL) != SUCCES) {
+            return 0;
+        }
+    }
+
+    /* Vehicules presents, de tous types, repartis dans le parking */
+    nombre = (int)((long)nombrePlaces * presents / 100);
+    contexte->plaques = (char(*)[TAILLE_PLAQUE])malloc(
+                            (nombre + 1) * sizeof(*contexte->plaques));
+    if (contexte->plaques == NULL) {
+        return 0;
+    }
+
+    for (i = 0; i < nombre; i++) {
+        formerPlaque(i, contexte->plaques[contexte->nombrePlaques]);
+        if (enregistrerEntree(&contexte->parking,
+                              contexte->plaques[contexte->nombrePlaques],
+                              "Bench",
+                              (TypeVehicule)(VOITURE + i % 4)) > 0) {
+            contexte->nombrePlaques++;
+        }
+    }
+
+    contexte->prochaineNouvelle = 50000000;
+    contexte->taille = nombrePlaces;
+
+    return 1;
+}
+
+/**
+ * @brief Prepare des valeurs aleatoires (durees, types, horodatages)
+ * @param contexte Contexte a preparer
+ */
+static void preparerValeurs(ContexteBench *contexte)
+{
+    int i;
+
+    memset(contexte, 0, sizeof(*contexte));
+    etatAleatoire = GRAINE_BENCH;
+
+    for (i = 0; i < NOMBRE_VALEURS; i++) {
+        contexte->durees[i] = (int)(tirerAleatoire() % (3 * 24 * 60));
+        contexte->types[i] = (TypeVehicule)(VOITURE + tirerAleatoire() % 4);
+        contexte->debuts[i].minutes = (int32_t)(29000000 +
+                                                tirerAleatoire() % 500000);
+        contexte->fins[i].minutes = contexte->debuts[i].minutes +
+                                    contexte->durees[i];
+    }
+}
+
+/**
+ * @brief Prepare des tableaux de vehicules et de places (tris, recherches)
+ * @param contexte Contexte a preparer
+ * @param taille Nombre d'elements
+ * @param melange 1 : ordre aleatoire, 0 : trie par plaque
+ * @return 1 si succes, 0 si memoire insuffisante
+ */
+static int preparerTableaux(ContexteBench *contexte, int taille, int melange)
+{
+    Vehicule temporaire;
+    int i;
+    int j;
+
+    memset(contexte, 0, sizeof(*contexte));
+    etatAleatoire = GRAINE_BENCH;
+
+    contexte->vehicules = (Vehicule*)calloc(taille, sizeof(Vehicule));
+    contexte->travail = (Vehicule*)calloc(taille, sizeof(Vehicule));
+    contexte->places = (Place*)calloc(taille, sizeof(Place));
+    contexte->travailPlaces = (Place*)calloc(taille, sizeof(Place));
+    if (contexte->vehicules == NULL || contexte->travail == NULL ||
+        contexte->places == NULL || contexte->travailPlaces == NULL) {
+        return 0;
+    }
+
+    for (i = 0; i < taille; i++) {
+        formerPlaque(i, contexte->vehicules[i].plaque);
+        strcpy(contexte->vehicules[i].proprietaire, "Bench");
+        contexte->vehicules[i].type = (TypeVehicule)(VOITURE + i % 4);
+        contexte->vehicules[i].entree.minutes =
+            (int32_t)(29000000 + tirerAleatoire() % 500000);
+        contexte->vehicules[i].montantPaye =
+            (float)(tirerAleatoire() % 100000) / 10.0f;
+        initialiserPlace(&contexte->places[i], i + 1,
+                         (TypeVehicule)(VOITURE + i % 4));
+    }
+
+    if (melange) {
+        /* Melange de Fisher-Yates, vehicules et places */
+        for (i = taille - 1; i > 0; i--) {
+            j = (int)(tirerAleatoire() % (unsigned int)(i + 1));
+            temporaire = contexte->vehicules[i];
+            contexte->vehicules[i] = contexte->vehicules[j];
+            contexte->vehicules[j] = temporaire;
+            contexte->places[i].numero = contexte->places[j].numero;
+            contexte->places[j].numero = i + 1;
+        }
+    }
+
+    contexte->taille = taille;
+
+    return 1;
+}
+
+/**
+ * @brief Libere ce qu'une preparation a alloue
+ * @param contexte Contexte a liberer
+ */
+static void libererContexte(ContexteBench *contexte)
+{
+    if (contexte->parkingPret) {
+        libererParking(&contexte->parking);
+    }
+
+    free(contexte->plaques);
+    free(contexte->vehicules);
+    free(contexte->travail);
+    free(contexte->places);
+    free(contexte->travailPlaces);
+    memset(contexte, 0, sizeof(*contexte));
+}
+
+/* ============================================================================
+ * OPERATIONS MESUREES
+ * ============================================================================ */
+
+static double benchPlaceLibre(ContexteBench *contexte, int nombre)
+{
+    double debut;
+    long somme;
+    int i;
+
+    somme = 0;
+    debut = instantMonotone();
+    for (i = 0; i < nombre; i++) {
+        somme += rechercherPlaceLibre(&contexte->parking,
+                                      (TypeVehicule)(VOITURE + i % 4));
+    }
+    debut = instantMonotone() - debut;
+    puits = (double)somme;
+
+    return debut;
+}
+
+/**
+ * @brief Entrees (mesurees ou non) de nouveaux vehicules
+ * @param contexte Contexte prepare
+ * @param nombre Nombre d'entrees
+ * @return Duree des entrees
+ */
+static double entrerNouveaux(ContexteBench *contexte, int nombre)
+{
+    char plaque[TAILLE_PLAQUE];
+    double debut;
+    int i;
+
+    debut = instantMonotone();
+    for (i = 0; i < nombre; i++) {
+        formerPlaque(contexte->prochaineNouvelle + i, plaque);
+        enregistrerEntree(&contexte->parking, plaque, "Bench",
+                          (TypeVehicule)(VOITURE + i % 4));
+    }
+
+    return instantMonotone() - debut;
+}
+
+/**
+ * @brief Sorties des vehicules entres par entrerNouveaux
+ * @param contexte Contexte prepare
+ * @param nombre Nombre de sorties
+ * @return Duree des sorties
+ */
+static double sortirNouveaux(ContexteBench *contexte, int nombre)
+{
+    char plaque[TAILLE_PLAQUE];
+    double debut;
+    float montant;
+    int i;
+
+    debut = instantMonotone();
+    for (i = 0; i < nombre; i++) {
+        formerPlaque(contexte->prochaineNouvelle + i, plaque);
+        enregistrerSortie(&contexte->parking, plaque, &montant);
+    }
+    debut = instantMonotone() - debut;
+
+    contexte->prochaineNouvelle += nombre;
+
+    return debut;
+}
+
+static double benchEntree(ContexteBench *contexte, int nombre)
+{
+    double duree;
+
+    duree = entrerNouveaux(contexte, nombre);
+    sortirNouveaux(contexte, nombre);
+
+    return duree;
+}
+
+static double benchSortie(ContexteBench *contexte, int nombre)
+{
+    entrerNouveaux(contexte, nombre);
+
+    return sortirNouveaux(contexte, nombre);
+}
+
+static double benchRechercheVehicule(ContexteBench *contexte, int nombre)
+{
+    double debut;
+    long somme;
+    int i;
+
+    somme = 0;
+    debut = instantMonotone();
+    for (i = 0; i < nombre; i++) {
+        somme += rechercherVehicule(&contexte->parking,
+                     contexte->plaques[indiceCle(i,
+                                       contexte->nombrePlaques)]) != NULL;
+    }
+    debut = instantMonotone() - debut;
+    puits = (double)somme;
+
+    return debut;
+}
+
+static double benchStatistiques(ContexteBench *contexte, int nombre)
+{
+    Statistiques stats;
+    double debut;
+    double somme;
+    int i;
+
+    somme = 0.0;
+    debut = instantMonotone();
+    for (i = 0; i < nombre; i++) {
+        calculerStatistiques(&contexte->parking, &stats);
+        somme += stats.recetteMoyenne;
+    }
+    debut = instantMonotone() - debut;
+    puits = somme;
+
+    return debut;
+}
+
+static double benchMontant(ContexteBench *contexte, int nombre)
+{
+    double debut;
+    double somme;
+    int i;
+    int k;
+
+    somme = 0.0;
+    debut = instantMonotone();
+    for (i = 0; i < nombre; i++) {
+        k = i & (NOMBRE_VALEURS - 1);
+        somme += calculerMontant(contexte->durees[k], contexte->types[k]);
+    }
+    debut = instantMonotone() - debut;
+    puits = somme;
+
+    return debut;
+}
+
+static double benchDuree(ContexteBench *contexte, int nombre)
+{
+    double debut;
+    long somme;
+    int i;
+    int k;
+
+    somme = 0;
+    debut = instantMonotone();
+    for (i = 0; i < nombre; i++) {
+        k = i & (NOMBRE_VALEURS - 1);
+        somme += calculerDureeMinutes(contexte->debuts[k], contexte->fins[k]);
+    }
+    debut = instantMonotone() - debut;
+    puits = (double)somme;
+
+    return debut;
+}
+
+/**
+ * @brief Copie les vehicules melanges dans le tableau de travail (non
+ *        mesure), pour que chaque tri parte du meme desordre
+ * @param contexte Contexte prepare
+ */
+static void recopierVehicules(ContexteBench *contexte)
+{
+    memcpy(contexte->travail, contexte->vehicules,
+           contexte->taille * sizeof(Vehicule));
+}
+
+static double benchTriSelection(ContexteBench *contexte, int nombre)
+{
+    double duree;
+    double debut;
+    int i;
+
+    duree = 0.0;
+    for (i = 0; i < nombre; i++) {
+        recopierVehicules(contexte);
+        debut = instantMonotone();
+        triSelectionVehicules(contexte->travail, contexte->taille);
+        duree += instantMonotone() - debut;
+    }
+
+    return duree;
+}
+
+static double benchTriInsertion(ContexteBench *contexte, int nombre)
+{
+    double duree;
+    double debut;
+    int i;
+
+    duree = 0.0;
+    for (i = 0; i < nombre; i++) {
+        recopierVehicules(contexte);
+        debut = instantMonotone();
+        triInsertionVehicules(contexte->travail, contexte->taille);
+        duree += instantMonotone() - debut;
+    }
+
+    return duree;
+}
+
+static double benchTriMontant(ContexteBench *contexte, int nombre)
+{
+    double duree;
+    double debut;
+    int i;
+
+    duree = 0.0;
+    for (i = 0; i < nombre; i++) {
+        recopierVehicules(contexte);
+        debut = instantMonotone();
+        triVehiculesParMontant(contexte->travail, contexte->taille);
+        duree += instantMonotone() - debut;
+    }
+
+    return duree;
+}
+
+static double benchTriPlaces(ContexteBench *contexte, int nombre)
+{
+    double duree;
+    double debut;
+    int i;
+
+    duree = 0.0;
+    for (i = 0; i < nombre; i++) {
+        memcpy(contexte->travailPlaces, contexte->places,
+               contexte->taille * sizeof(Place));
+        debut = instantMonotone();
+        triPlacesParNumero(contexte->travailPlaces, contexte->taille);
+        duree += instantMonotone() - debut;
+    }
+
+    return duree;
+}
+
+static double benchTriIndirect(ContexteBench *contexte, int nombre)
+{
+    int *permutation;
+    double duree;
+    double debut;
+    int i;
+
+    permutation = (int*)malloc(contexte->taille * sizeof(int));
+    if (permutation == NULL) {
+        return 0.0;
+    }
+
+    /* Tableau non modifie : pas de recopie entre deux tris */
+    duree = 0.0;
+    for (i = 0; i < nombre; i++) {
+        debut = instantMonotone();
+        trierIndicesVehicules(contexte->vehicules, contexte->taille,
+                              TRI_PAR_PLAQUE, permutation);
+        duree += instantMonotone() - debut;
+    }
+    puits = permutation[0];
+    free(permutation);
+
+    return duree;
+}
+
+static double benchTriHistorique(ContexteBench *contexte, int nombre)
+{
+    int *permutation;
+    double duree;
+    double debut;
+    int i;
+
+    permutation = (int*)malloc(contexte->parking.nombreVehicules *
+                               sizeof(int));
+    if (permutation == NULL) {
+        return 0.0;
+    }
+
+    duree = 0.0;
+    for (i = 0; i < nombre; i++) {
+        debut = instantMonotone();
+        trierIndicesHistorique(&contexte->parking, TRI_PAR_MONTANT,
+                               permutation);
+        duree += instantMonotone() - debut;
+    }
+    puits = permutation[0];
+    free(permutation);
+
+    return duree;
+}
+
+static double benchRechercheSequentielle(ContexteBench *contexte, int nombre)
+{
+    const char *cle;
+    double debut;
+    long somme;
+    int i;
+
+    somme = 0;
+    debut = instantMonotone();
+    for (i = 0; i < nombre; i++) {
+        cle = contexte->vehicules[indiceCle(i, contexte->taille)].plaque;
+        somme += rechercheSequentielle(contexte->vehicules, contexte->taille,
+                                       cle);
+    }
+    debut = instantMonotone() - debut;
+    puits = (double)somme;
+
+    return debut;
+}
+
+static double benchRechercheDichotomique(ContexteBench *contexte, int nombre)
+{
+    const char *cle;
+    double debut;
+    long somme;
+    int i;
+
+    somme = 0;
+    debut = instantMonotone();
+    for (i = 0; i < nombre; i++) {
+        cle = contexte->vehicules[indiceCle(i, contexte->taille)].plaque;
+        somme += rechercheDichotomique(contexte->vehicules, contexte->taille,
+                                       cle);
+    }
+    debut = instantMonotone() - debut;
+    puits = (double)somme;
+
+    return debut;
+}
+
+static double benchRechercheDrapeau(ContexteBench *contexte, int nombre)
+{
+    const char *cle;
+    double debut;
+    long somme;
+    int trouve;
+    int i;
+
+    somme = 0;
+    debut = instantMonotone();
+    for (i = 0; i < nombre; i++) {
+        cle = contexte->vehicules[indiceCle(i, contexte->taille)].plaque;
+        somme += rechercheAvecDrapeau(contexte->vehicules, contexte->taille,
+                                      cle, &trouve);
+    }
+    debut = instantMonotone() - debut;
+    puits = (double)somme;
+
+    return debut;
+}
+
+/* ============================================================================
+ * PROGRAMME
+ * ============================================================================ */
+
+int main(int argc, char *argv[])
+{
+    static const int placesNormales[] = { 100, 1000, 10000, 100000 };
+    static const int historiquesNormaux[] = { 10000, 100000, 1000000 };
+    static const int trisNormaux[] = { 100, 1000, 10000 };
+    static const int recherchesNormales[] = { 1000, 100000, 1000000 };
+    static const int placesRapides[] = { 100, 10000 };
+    static const int historiquesRapides[] = { 10000 };
+    static const int trisRapides[] = { 100, 1000 };
+    static const int recherchesRapides[] = { 1000, 100000 };
+    const int *places;
+    const int *historiques;
+    const int *tris;
+    const int *recherches;
+    ContexteBench *contexte;
+    Horodatage origine;
+    int nombreParkings;
+    int nombreTailles;
+    int nombreHistoriques;
+    int lot;
+    int i;
+
+    if (argc > 2 || (argc == 2 && strcmp(argv[1], "--rapide") != 0)) {
+        fprintf(stderr, "Usage : %s [--rapide]\n", argv[0]);
+        return 1;
+    }
+
+    if (argc == 2) {
+        nombreEchantillons = ECHANTILLONS_RAPIDES;
+        places = placesRapides;
+        historiques = historiquesRapides;
+        tris = trisRapides;
+        recherches = recherchesRapides;
+        nombreParkings = 2;
+        nombreTailles = 2;
+        nombreHistoriques = 1;
+    } else {
+        places = placesNormales;
+        historiques = historiquesNormaux;
+        tris = trisNormaux;
+        recherches = recherchesNormales;
+        nombreParkings = 4;
+        nombreTailles = 3;
+        nombreHistoriques = 3;
+    }
+
+    /* Contexte volumineux (valeurs precalculees) : hors de la pile */
+    contexte = (ContexteBench*)calloc(1, sizeof(ContexteBench));
+    if (contexte == NULL) {
+        fprintf(stderr, "Erreur : %s\n", messageErreur(ERREUR_MEMOIRE));
+        return 1;
+    }
+
+    /* Meme travail a chaque execution : heure et tarifs fixes */
+    appliquerTarifsParDefaut();
+    choisirSourceHorloge(HORLOGE_SIMULEE);
+    origine.minutes = 29000000;
+    reglerHorlogeSimulee(origine);
+
+    printf("{\n  \"programme\": \"bench_parking\",\n  \"unite\": \"ns/op\","
+           "\n  \"echantillons\": %d,\n  \"resultats\": [",
+           nombreEchantillons);
+
+    /* Operations du parking selon le nombre de places */
+    for (i = 0; i < nombreParkings; i++) {
+        fprintf(stderr, "Parking de %d places\n", places[i]);
+        if (preparerParking(contexte, places[i], 0, 90) == 0) {
+            break;
+        }
+        lot = places[i] / 20 > 256 ? 256 : places[i] / 20;
+
+        mesurer("rechercherPlaceLibre", "places", places[i],
+                benchPlaceLibre, contexte, 0);
+        mesurer("enregistrerEntree", "places", places[i], benchEntree,
+                contexte, lot);
+        mesurer("enregistrerSortie", "places", places[i], benchSortie,
+                contexte, lot);
+        mesurer("rechercherVehicule", "places", places[i],
+                benchRechercheVehicule, contexte, 0);
+        libererContexte(contexte);
+    }
+
+    /* Operations selon la taille de l'historique (parking de 1000 places) */
+    for (i = 0; i < nombreHistoriques; i++) {
+        fprintf(stderr, "Historique de %d sejours\n", historiques[i]);
+        if (preparerParking(contexte, 1000, historiques[i], 50) == 0) {
+            break;
+        }
+
+        mesurer("enregistrerEntree", "historique", historiques[i],
+                benchEntree, contexte, 256);
+        mesurer("enregistrerSortie", "historique", historiques[i],
+                benchSortie, contexte, 256);
+        mesurer("rechercherVehicule", "historique", historiques[i],
+                benchRechercheVehicule, contexte, 0);
+        mesurer("calculerStatistiques", "historique", historiques[i],
+                benchStatistiques, contexte, 0);
+        mesurer("trierIndicesHistorique", "historique", historiques[i],
+                benchTriHistorique, contexte, 1);
+        libererContexte(contexte);
+    }
+
+    /* Calculs sans etat */
+    fprintf(stderr, "Tarification et durees\n");
+    preparerValeurs(contexte);
+    mesurer("calculerMontant", "aucune", 0, benchMontant, contexte, 0);
+    mesurer("calculerDureeMinutes", "aucune", 0, benchDuree, contexte, 0);
+
+    /* Tris (quadratiques, puis indirect) : un tri par operation */
+    for (i = 0; i < nombreTailles; i++) {
+        fprintf(stderr, "Tris de %d elements\n", tris[i]);
+        if (preparerTableaux(contexte, tris[i], 1) == 0) {
+            break;
+        }
+        mesurer("triSelectionVehicules", "elements", tris[i],
+                benchTriSelection, contexte, 1);
+        mesurer("triInsertionVehicules", "elements", tris[i],
+                benchTriInsertion, contexte, 1);
+        mesurer("triVehiculesParMontant", "elements", tris[i],
+                benchTriMontant, contexte, 1);
+        mesurer("triPlacesParNumero", "elements", tris[i], benchTriPlaces,
+                contexte, 1);
+        mesurer("trierIndicesVehicules", "elements", tris[i],
+                benchTriIndirect, contexte, 1);
+        libererContexte(contexte);
+    }
+
+    /* Recherches dans un tableau trie par plaque */
+    for (i = 0; i < nombreTailles; i++) {
+        fprintf(stderr, "Recherches parmi %d elements\n", recherches[i]);
+        if (preparerTableaux(contexte, recherches[i], 0) == 0) {
+            break;
+        }
+        mesurer("rechercheSequentielle", "elements", recherches[i],
+                benchRechercheSequentielle, contexte, 0);
+        mesurer("rechercheDichotomique", "elements", recherches[i],
+                benchRechercheDichotomique, contexte, 0);
+        mesurer("rechercheAvecDrapeau", "elements", recherches[i],
+                benchRechercheDrapeau, contexte, 0);
+        libererContexte(contexte);
+    }
+
+    libererContexte(contexte);
+    free(contexte);
+
+    printf("\n  ]\n}\n");
+
+    return 0;
+}
@@ -0,0 +1,197 @@
+/**
+ * @file client_parking.c
+ * @brief Client local du serveur des bornes (parking --serveur)
+ * @date Decembre 2025
+ *
+ * Envoie les commandes d'un fichier (ou de l'entree standard) et ecrit
+ * les reponses sur la sortie standard, dans l'ordre des commandes. Les
+ * commandes partent sans attendre les reponses : envoi et reception
+ * avancent ensemble (poll), le serveur traite donc plusieurs requetes a
+ * la fois.
+ *
+ * Usage : client_parking <port|chemin de socket Unix> [fichier]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+
+/** Taille des tampons d'envoi et de reception */
+#define TAILLE_TAMPON 65536
+
+/**
+ * @brief Se connecte au serveur
+ * @param adresse Numero de port (127.0.0.1) ou chemin de socket Unix
+ * @return Descripteur, -1 en cas d'echec
+ */
+static int connecterServeur(const char *adresse)
+{
+    struct sockaddr_in inet;
+    struct sockaddr_un local;
+    const char *c;
+    int descripteur;
+    int resultat;
+
+    for (c = adresse; *c >= '0' && *c <= '9'; c++) {
+    }
+
+    if (*adresse != '\0' && *c == '\0') {
+        descripteur = socket(AF_INET, SOCK_STREAM, 0);
+        if (descripteur == -1) {
+            return -1;
+        }
+        memset(&inet, 0, sizeof(inet));
+        inet.sin_family = AF_INET;
+        inet.sin_port = htons((unsigned short)atoi(adresse));
+        inet.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        resultat = connect(descripteur, (struct sockaddr*)&inet,
+                           sizeof(inet));
+    } else {
+        if (strlen(adresse) >= sizeof(local.sun_path)) {
+            return -1;
+        }
+        descripteur = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (descripteur == -1) {
+            return -1;
+        }
+        memset(&local, 0, sizeof(local));
+        local.sun_family = AF_UNIX;
+        strcpy(local.sun_path, adresse);
+        resultat = connect(descripteur, (struct sockaddr*)&local,
+                           sizeof(local));
+    }
+
+    if (resultat == -1) {
+        close(descripteur);
+        return -1;
+    }
+
+    return descripteur;
+}
+
+/**
+ * @brief Envoie les commandes et recopie les reponses
+ * @param descripteur Socket connectee
+ * @param entree Flux des commandes
+ * @return 1 si tout a ete echange, 0 sinon
+ */
+static int echangerCommandes(int descripteur, FILE *entree)
+{
+    static char envoi[TAILLE_TAMPON];
+    static char reception[TAILLE_TAMPON];
+    struct pollfd attente;
+    size_t aEnvoyer;
+    size_t envoyes;
+    ssize_t resultat;
+    int finEntree;
+
+    aEnvoyer = 0;
+    envoyes = 0;
+    finEntree = 0;
+
+    for (;;) {
+        /* Commandes suivantes lues des que le tampon est parti */
+        if (envoyes == aEnvoyer && finEntree == 0) {
+            aEnvoyer = fread(envoi, 1, sizeof(envoi), entree);
+            envoyes = 0;
+            if (aEnvoyer == 0) {
+                finEntree = 1;
+                shutdown(descripteur, SHUT_WR);
+            }
+        }
+
+        attente.fd = descripteur;
+        attente.events = POLLIN;
+        if (envoyes < aEnvoyer) {
+            attente.events |= POLLOUT;
+        }
+
+        if (poll(&attente, 1, -1) == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return 0;
+        }
+
+        if (attente.revents & POLLOUT) {
+            /* Jamais bloque en envoi : le serveur peut attendre que ses
+             * reponses soient lues */
+            resultat = send(descripteur, envoi + envoyes, aEnvoyer - envoyes,
+                            MSG_NOSIGNAL | MSG_DONTWAIT);
+            if (resultat == -1 && errno != EINTR && errno != EAGAIN) {
+                return 0;
+            }
+            if (resultat > 0) {
+                envoyes += (size_t)resultat;
+            }
+        }
+
+        if (attente.revents & (POLLIN | POLLHUP | POLLERR)) {
+            resultat = read(descripteur, reception, sizeof(reception));
+            if (resultat == 0) {
+                /* Serveur ferme : toutes les reponses sont arrivees */
+                return finEntree;
+            }
+            if (resultat == -1 && errno != EINTR && errno != EAGAIN) {
+                return 0;
+            }
+            if (resultat > 0) {
+                fwrite(reception, 1, (size_t)resultat, stdout);
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    FILE *entree;
+    int descripteur;
+    int resultat;
+
+    if (argc != 2 && argc != 3) {
+        fprintf(stderr, "Usage : %s <port|chemin de socket Unix> "
+                "[fichier de commandes]\n", argv[0]);
+        return 1;
+    }
+
+    entree = stdin;
+    if (argc == 3 && strcmp(argv[2], "-") != 0) {
+        entree = fopen(argv[2], "r");
+        if (entree == NULL) {
+            fprintf(stderr, "Erreur : Impossible d'ouvrir %s\n", argv[2]);
+            return 1;
+        }
+    }
+
+    descripteur = connecterServeur(argv[1]);
+    if (descripteur == -1) {
+        fprintf(stderr, "Erreur : Connexion a %s impossible.\n", argv[1]);
+        if (entree != stdin) {
+            fclose(entree);
+        }
+        return 1;
+    }
+
+    resultat = echangerCommandes(descripteur, entree);
+
+    close(descripteur);
+    if (entree != stdin) {
+        fclose(entree);
+    }
+    fflush(stdout);
+
+    if (resultat == 0) {
+        fprintf(stderr, "Erreur : Echange interrompu avec le serveur.\n");
+        return 1;
+    }
+
+    return 0;
+}
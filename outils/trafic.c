@@ -0,0 +1,778 @@
+/**
+ * @file trafic.c
+ * @brief Generateur de trafic synthetique et rejeu de traces
+ * @date Decembre 2025
+ *
+ * generer : produit une trace de commandes du mode par lot (CLOCK, ENTRY,
+ * EXIT) pour une journee type. Les arrivees suivent un processus de
+ * Poisson par type de vehicule, module heure par heure par un profil
+ * d'affluence (pointes du matin et du soir par defaut). La duree de
+ * chaque sejour suit une loi log-normale de moyenne donnee par type. La
+ * trace ne depend pas de la taille du parking : la meme journee peut etre
+ * rejouee contre plusieurs dimensionnements ou envoyee a parking --lot
+ * (le serveur des bornes refuse CLOCK).
+ *
+ * rejouer : execute une trace contre le moteur sur l'horloge simulee
+ * (depart a minuit) et mesure la latence de chaque entree et sortie, les
+ * entrees refusees faute de place, l'occupation maximale et la recette
+ * finale. Les lignes sont lues et decoupees par le mode par lot : une ligne
+ * qu'il refuserait est signalee et ignoree.
+ *
+ * Usage :
+ *   trafic_parking generer [--heures n] [--taux v,m,c,b]
+ *                  [--sejours v,m,c,b] [--dispersion s]
+ *                  [--profil p0,...,p23] [--graine n]
+ *   trafic_parking rejouer <trace|-> [--places n]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../include/types.h"
+#include "../include/parking.h"
+#include "../include/utilitaires.h"
+#include "../include/tarification.h"
+#include "../include/mode_lot.h"
+#include "../include/prototypes.h"
+
+/** Commandes rejouees entre deux archivages de l'historique */
+#define COMMANDES_PAR_ENTRETIEN 4096
+
+/** Nombre de places du parking rejoue par defaut */
+#define PLACES_PAR_DEFAUT 100
+
+/** Nombre maximal de places du parking rejoue */
+#define PLACES_MAXIMALES 10000000
+
+/* ============================================================================
+ * GENERATION
+ * ============================================================================ */
+
+/**
+ * @struct ParametresTrafic
+ * @brief Parametres de la journee generee
+ *
+ * Les tableaux par type sont indexes de 0 (VOITURE) a 3 (BUS).
+ */
+typedef struct {
+    int heures;
+    double taux[4];
+    double sejours[4];
+    double dispersion;
+    double profil[24];
+    unsigned long long graine;
+} ParametresTrafic;
+
+/**
+ * @struct DepartPrevu
+ * @brief Sortie a venir d'un vehicule genere
+ */
+typedef struct {
+    int minute;
+    long numero;
+} DepartPrevu;
+
+/**
+ * @struct FileDeparts
+ * @brief Tas binaire des sorties, la plus proche en tete
+ */
+typedef struct {
+    DepartPrevu *departs;
+    int nombre;
+    int capacite;
+} FileDeparts;
+
+/** Etat du generateur pseudo-aleatoire */
+static unsigned long long etatTrafic;
+
+/**
+ * @brief Tirage uniforme dans ]0, 1[ (xorshift64*)
+ * @return Reel pseudo-aleatoire
+ */
+static double tirerUniforme(void)
+{
+    etatTrafic ^= etatTrafic >> 12;
+    etatTrafic ^= etatTrafic << 25;
+    etatTrafic ^= etatTrafic >> 27;
+
+    return ((etatTrafic * 2685821657736338717ULL >> 11) + 0.5) /
+           9007199254740992.0;
+}
+
+/**
+ * @brief Tirage d'une loi exponentielle
+ * @param taux Intensite (evenements par minute)
+ * @return Delai jusqu'a l'evenement suivant, en minutes
+ */
+static double tirerExponentielle(double taux)
+{
+    return -log(tirerUniforme()) / taux;
+}
+
+/**
+ * @brief Tirage d'une loi normale centree reduite (Box-Muller)
+ * @return Reel pseudo-aleatoire
+ */
+static double tirerNormale(void)
+{
+    return sqrt(-2.0 * log(tirerUniforme())) *
+           cos(6.283185307179586 * tirerUniforme());
+}
+
+/**
+ * @brief Duree d'un sejour (loi log-normale)
+ * @param moyenne Duree moyenne en minutes
+ * @param dispersion Ecart type du logarithme (0 : duree fixe)
+ * @return Duree en minutes, au moins 1
+ */
+static int tirerSejour(double moyenne, double dispersion)
+{
+    double duree;
+
+    duree = exp(log(moyenne) - dispersion * dispersion / 2.0 +
+                dispersion * tirerNormale());
+
+    return duree < 1.0 ? 1 : (int)(duree + 0.5);
+}
+
+/**
+ * @brief Ajoute une sortie a la file
+ * @param file File des sorties
+ * @param depart Sortie a ajouter
+ * @return 1 si succes, 0 si memoire insuffisante
+ */
+static int ajouterDepart(FileDeparts *file, DepartPrevu depart)
+{
+    DepartPrevu *departs;
+    int i;
+
+    if (file->nombre == file->capacite) {
+        departs = (DepartPrevu*)realloc(file->departs,
+                      (file->capacite * 2 + 64) * sizeof(DepartPrevu));
+        if (departs == NULL) {
+            return 0;
+        }
+        file->departs = departs;
+        file->capacite = file->capacite * 2 + 64;
+    }
+
+    /* Remontee dans le tas */
+    i = file->nombre++;
+    while (i > 0 && file->departs[(i - 1) / 2].minute > depart.minute) {
+        file->departs[i] = file->departs[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    file->departs[i] = depart;
+
+    return 1;
+}
+
+/**
+ * @brief Retire la sortie la plus proche
+ * @param file File des sorties (non vide)
+ * @return Sortie retiree
+ */
+static DepartPrevu retirerDepart(FileDeparts *file)
+{
+    DepartPrevu premier;
+    DepartPrevu dernier;
+    int i;
+    int enfant;
+
+    premier = file->departs[0];
+    dernier = file->departs[--file->nombre];
+
+    /* Descente du dernier element depuis la racine */
+    i = 0;
+    while ((enfant = 2 * i + 1) < file->nombre) {
+        if (enfant + 1 < file->nombre &&
+            file->departs[enfant + 1].minute < file->departs[enfant].minute) {
+            enfant++;
+        }
+        if (dernier.minute <= file->departs[enfant].minute) {
+            break;
+        }
+        file->departs[i] = file->departs[enfant];
+        i = enfant;
+    }
+    if (file->nombre > 0) {
+        file->departs[i] = dernier;
+    }
+
+    return premier;
+}
+
+/**
+ * @brief Ecrit la commande CLOCK qui amene la trace a une minute donnee
+ * @param sortie Flux de la trace
+ * @param minuteCourante Minute courante de la trace, mise a jour
+ * @param minute Minute de l'evenement suivant
+ */
+static void avancerTrace(FILE *sortie, int *minuteCourante, int minute)
+{
+    if (minute > *minuteCourante) {
+        fprintf(sortie, "CLOCK %d\n", minute - *minuteCourante);
+        *minuteCourante = minute;
+    }
+}
+
+/**
+ * @brief Genere la trace d'une periode de trafic
+ * @param parametres Parametres de la periode
+ * @param sortie Flux de la trace
+ * @return 1 si succes, 0 si memoire insuffisante
+ *
+ * Processus de Poisson non homogene par amincissement : des arrivees
+ * candidates sont tirees a l'intensite de pointe, puis conservees avec la
+ * probabilite profil(heure) / profil maximal.
+ */
+static int genererTrafic(const ParametresTrafic *parametres, FILE *sortie)
+{
+    FileDeparts file;
+    DepartPrevu depart;
+    double tauxTotal;
+    double profilMaximal;
+    double instant;
+    double tirage;
+    long arrivees;
+    long sorties;
+    int minuteCourante;
+    int minute;
+    int fin;
+    int type;
+
+    memset(&file, 0, sizeof(file));
+    etatTrafic = parametres->graine != 0 ? parametres->graine : 1;
+
+    tauxTotal = 0.0;
+    for (type = 0; type < 4; type++) {
+        tauxTotal += parametres->taux[type];
+    }
+    profilMaximal = 0.0;
+    for (minute = 0; minute < 24; minute++) {
+        if (parametres->profil[minute] > profilMaximal) {
+            profilMaximal = parametres->profil[minute];
+        }
+    }
+
+    fprintf(sortie, "# trafic_parking : %d h, graine %llu, debut 00:00\n",
+            parametres->heures, parametres->graine);
+    fprintf(sortie, "# arrivees/h (pointe x1) : VOITURE %.1f, MOTO %.1f, "
+            "CAMION %.1f, BUS %.1f\n", parametres->taux[0],
+            parametres->taux[1], parametres->taux[2], parametres->taux[3]);
+
+    fin = parametres->heures * 60;
+    minuteCourante = 0;
+    arrivees = 0;
+    sorties = 0;
+    instant = 0.0;
+
+    for (;;) {
+        /* Arrivee candidate suivante a l'intensite de pointe */
+        if (tauxTotal > 0.0 && profilMaximal > 0.0) {
+            instant += tirerExponentielle(tauxTotal * profilMaximal / 60.0);
+        } else {
+            instant = fin;
+        }
+        minute = instant < fin ? (int)instant : fin;
+
+        /* Sorties echues avant cette minute (sorties d'abord : elles
+         * liberent des places) */
+        while (file.nombre > 0 && file.departs[0].minute <= minute &&
+               file.departs[0].minute < fin) {
+            depart = retirerDepart(&file);
+            avancerTrace(sortie, &minuteCourante, depart.minute);
+            fprintf(sortie, "EXIT TR%07ld\n", depart.numero);
+            sorties++;
+        }
+
+        if (minute >= fin) {
+            break;
+        }
+
+        if (tirerUniforme() * profilMaximal >=
+            parametres->profil[(minute / 60) % 24]) {
+            continue;
+        }
+
+        /* Type tire selon les taux relatifs */
+        tirage = tirerUniforme() * tauxTotal;
+        for (type = 0; type < 3 && tirage >= parametres->taux[type]; type++) {
+            tirage -= parametres->taux[type];
+        }
+
+        arrivees++;
+        avancerTrace(sortie, &minuteCourante, minute);
+        fprintf(sortie, "ENTRY TR%07ld Trafic %s\n", arrivees,
+                nomTypeLot(VOITURE + type));
+
+        depart.numero = arrivees;
+        depart.minute = minute + tirerSejour(parametres->sejours[type],
+                                             parametres->dispersion);
+        if (ajouterDepart(&file, depart) == 0) {
+            free(file.departs);
+            return 0;
+        }
+    }
+
+    fprintf(sortie, "# %ld arrivees, %ld sorties, %d vehicules restants\n",
+            arrivees, sorties, file.nombre);
+    free(file.departs);
+
+    return 1;
+}
+
+/**
+ * @brief Lit une liste de reels separes par des virgules
+ * @param texte Texte de l'option
+ * @param valeurs Recoit les valeurs
+ * @param nombre Nombre de valeurs attendues
+ * @return 1 si la liste est complete et positive, 0 sinon
+ */
+static int lireListeReels(const char *texte, double valeurs[], int nombre)
+{
+    char *fin;
+    int i;
+
+    for (i = 0; i < nombre; i++) {
+        valeurs[i] = strtod(texte, &fin);
+        if (fin == texte || valeurs[i] < 0.0 ||
+            *fin != (i == nombre - 1 ? '\0' : ',')) {
+            return 0;
+        }
+        texte = fin + 1;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Lit les options de generation
+ * @param argc Nombre d'arguments
+ * @param argv Arguments (argv[2] : premiere option)
+ * @param parametres Parametres, initialises aux valeurs par defaut
+ * @return 1 si les options sont valides, 0 sinon
+ */
+static int lireParametresTrafic(int argc, char *argv[],
+                                ParametresTrafic *parametres)
+{
+    /* Journee de semaine : pointes a 8 h et a 18 h, creux la nuit */
+    static const double profilDefaut[24] = {
+        0.10, 0.05, 0.05, 0.05, 0.10, 0.30, 0.80, 1.60,
+        2.00, 1.40, 0.90, 0.90, 1.10, 1.00, 0.90, 1.00,
+        1.30, 1.80, 1.90, 1.20, 0.70, 0.50, 0.30, 0.20
+    };
+    static const double tauxDefaut[4] = { 40.0, 10.0, 4.0, 1.0 };
+    static const double sejoursDefaut[4] = { 150.0, 90.0, 60.0, 240.0 };
+    char *fin;
+    int valide;
+    int i;
+
+    parametres->heures = 24;
+    memcpy(parametres->taux, tauxDefaut, sizeof(tauxDefaut));
+    memcpy(parametres->sejours, sejoursDefaut, sizeof(sejoursDefaut));
+    memcpy(parametres->profil, profilDefaut, sizeof(profilDefaut));
+    parametres->dispersion = 0.8;
+    parametres->graine = 2025;
+
+    for (i = 2; i < argc; i += 2) {
+        if (i + 1 >= argc) {
+            return 0;
+        }
+
+        if (strcmp(argv[i], "--heures") == 0) {
+            parametres->heures = (int)strtol(argv[i + 1], &fin, 10);
+            valide = *fin == '\0' && parametres->heures > 0 &&
+                     parametres->heures <= 24 * 366;
+        } else if (strcmp(argv[i], "--taux") == 0) {
+            valide = lireListeReels(argv[i + 1], parametres->taux, 4);
+        } else if (strcmp(argv[i], "--sejours") == 0) {
+            valide = lireListeReels(argv[i + 1], parametres->sejours, 4) &&
+                     parametres->sejours[0] > 0.0 &&
+                     parametres->sejours[1] > 0.0 &&
+                     parametres->sejours[2] > 0.0 &&
+                     parametres->sejours[3] > 0.0;
+        } else if (strcmp(argv[i], "--dispersion") == 0) {
+            valide = lireListeReels(argv[i + 1], &parametres->dispersion, 1);
+        } else if (strcmp(argv[i], "--profil") == 0) {
+            valide = lireListeReels(argv[i + 1], parametres->profil, 24);
+        } else if (strcmp(argv[i], "--graine") == 0) {
+            parametres->graine = strtoull(argv[i + 1], &fin, 10);
+            valide = *fin == '\0';
+        } else {
+            valide = 0;
+        }
+
+        if (valide == 0) {
+            fprintf(stderr, "Erreur : option invalide : %s %s\n", argv[i],
+                    argv[i + 1]);
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/* ============================================================================
+ * REJEU
+ * ============================================================================ */
+
+/**
+ * @struct Latences
+ * @brief Latences mesurees d'une operation, en secondes
+ */
+typedef struct {
+    double *valeurs;
+    long nombre;
+    long capacite;
+} Latences;
+
+/**
+ * @struct BilanRejeu
+ * @brief Resultats du rejeu d'une trace
+ */
+typedef struct {
+    Latences entrees;
+    Latences sorties;
+    long acceptees[4];
+    long refusees[4];
+    long refusParHeure[24];
+    long autresErreurs;
+    long sortiesAbsentes;
+    long lignesIgnorees;
+    BilanLot commandes;         /* Compteurs de analyserCommandeLot */
+    int occupationMaximale;
+    int minuteMaximale;
+    int minutes;
+} BilanRejeu;
+
+/**
+ * @brief Ajoute une latence mesuree
+ * @param latences Latences de l'operation
+ * @param duree Duree en secondes
+ * @return 1 si succes, 0 si memoire insuffisante
+ */
+static int ajouterLatence(Latences *latences, double duree)
+{
+    double *valeurs;
+
+    if (latences->nombre == latences->capacite) {
+        valeurs = (double*)realloc(latences->valeurs,
+                      (latences->capacite * 2 + 1024) * sizeof(double));
+        if (valeurs == NULL) {
+            return 0;
+        }
+        latences->valeurs = valeurs;
+        latences->capacite = latences->capacite * 2 + 1024;
+    }
+
+    latences->valeurs[latences->nombre++] = duree;
+
+    return 1;
+}
+
+static int comparerLatences(const void *a, const void *b)
+{
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Affiche les percentiles d'une serie de latences
+ * @param nom Nom de l'operation
+ * @param latences Latences mesurees (triees par la fonction)
+ */
+static void afficherLatences(const char *nom, Latences *latences)
+{
+    double somme;
+    long n;
+    long i;
+
+    n = latences->nombre;
+    if (n == 0) {
+        printf("Latence %-10s: aucune operation\n", nom);
+        return;
+    }
+
+    qsort(latences->valeurs, n, sizeof(double), comparerLatences);
+    somme = 0.0;
+    for (i = 0; i < n; i++) {
+        somme += latences->valeurs[i];
+    }
+
+    /* Percentiles par rang le plus proche, en microsecondes */
+    printf("Latence %-10s: p50 %.2f us, p90 %.2f us, p99 %.2f us, "
+           "max %.2f us, moyenne %.2f us\n", nom,
+           latences->valeurs[(50 * n + 99) / 100 - 1] * 1e6,
+           latences->valeurs[(90 * n + 99) / 100 - 1] * 1e6,
+           latences->valeurs[(99 * n + 99) / 100 - 1] * 1e6,
+           latences->valeurs[n - 1] * 1e6, somme / n * 1e6);
+}
+
+/**
+ * @brief Rejoue une ligne de la trace
+ * @param parking Parking rejoue
+ * @param ligne Ligne lue (sans caractere de fin de ligne)
+ * @param numeroLigne Numero de la ligne, pour les messages d'erreur
+ * @param bilan Resultats mis a jour
+ * @return 1 si succes, 0 si memoire insuffisante
+ *
+ * La ligne est decoupee par le mode par lot : une ligne qu'il refuserait
+ * (champ trop long, type inconnu...) est signalee sur la sortie d'erreur
+ * et ignoree.
+ */
+static int rejouerLigne(Parking *parking, const char *ligne,
+                        long numeroLigne, BilanRejeu *bilan)
+{
+    CommandeLot commande;
+    double debut;
+    double duree;
+    float montant;
+    int type;
+    int resultat;
+
+    resultat = analyserCommandeLot(ligne, numeroLigne, &commande, stderr,
+                                   &bilan->commandes);
+    if (resultat != 1) {
+        if (resultat == 0) {
+            bilan->lignesIgnorees++;
+        }
+        return 1;
+    }
+
+    switch (commande.nature) {
+        case COMMANDE_HORLOGE:
+            avancerHorlogeSimulee(commande.numero);
+            bilan->minutes += commande.numero;
+            return 1;
+
+        case COMMANDE_ENTREE:
+            type = commande.type;
+            debut = instantMonotone();
+            resultat = enregistrerEntree(parking, commande.plaque,
+                                         commande.proprietaire,
+                                         (TypeVehicule)type);
+            duree = instantMonotone() - debut;
+
+            if (resultat > 0) {
+                bilan->acceptees[type - VOITURE]++;
+                if (parking->placesOccupees > bilan->occupationMaximale) {
+                    bilan->occupationMaximale = parking->placesOccupees;
+                    bilan->minuteMaximale = bilan->minutes;
+                }
+            } else if (resultat == ERREUR_AUCUNE_PLACE) {
+                /* rechercherPlaceLibre n'a rien trouve pour ce type */
+                bilan->refusees[type - VOITURE]++;
+                bilan->refusParHeure[(bilan->minutes / 60) % 24]++;
+            } else {
+                bilan->autresErreurs++;
+            }
+
+            return ajouterLatence(&bilan->entrees, duree);
+
+        case COMMANDE_SORTIE:
+            montant = 0.0f;
+            debut = instantMonotone();
+            resultat = enregistrerSortie(parking, commande.plaque, &montant);
+            duree = instantMonotone() - debut;
+
+            if (resultat == ERREUR_VEHICULE_ABSENT) {
+                /* Vehicule refuse a l'entree : sa sortie n'a pas lieu */
+                bilan->sortiesAbsentes++;
+                return 1;
+            }
+            if (resultat != SUCCES) {
+                bilan->autresErreurs++;
+            }
+
+            return ajouterLatence(&bilan->sorties, duree);
+
+        default:
+            /* Commandes de l'exploitant et consultations : hors trafic */
+            bilan->lignesIgnorees++;
+            return 1;
+    }
+}
+
+/**
+ * @brief Affiche les resultats d'un rejeu
+ * @param parking Parking apres le rejeu
+ * @param bilan Resultats du rejeu
+ */
+static void afficherRejeu(const Parking *parking, BilanRejeu *bilan)
+{
+    long refus;
+    int type;
+    int heure;
+
+    printf("Places            : %d\n", parking->nombrePlaces);
+    printf("Duree simulee     : %d h %02d min\n", bilan->minutes / 60,
+           bilan->minutes % 60);
+
+    refus = 0;
+    for (type = 0; type < 4; type++) {
+        printf("%-18s: %ld entrees, %ld refusees\n",
+               nomTypeLot(VOITURE + type), bilan->acceptees[type],
+               bilan->refusees[type]);
+        refus += bilan->refusees[type];
+    }
+
+    printf("Sorties           : %ld\n", bilan->sorties.nombre);
+    printf("Occupation max    : %d places (a %02d:%02d)\n",
+           bilan->occupationMaximale, (bilan->minuteMaximale / 60) % 24,
+           bilan->minuteMaximale % 60);
+    printf("Presents a la fin : %d\n", parking->placesOccupees);
+    printf("Recette finale    : %.2f FCFA\n", parking->recetteTotale);
+
+    if (refus > 0) {
+        printf("Refus par heure   :");
+        for (heure = 0; heure < 24; heure++) {
+            if (bilan->refusParHeure[heure] > 0) {
+                printf(" %02dh=%ld", heure, bilan->refusParHeure[heure]);
+            }
+        }
+        printf("\n");
+    }
+
+    if (bilan->autresErreurs > 0 || bilan->lignesIgnorees > 0) {
+        printf("Autres erreurs    : %ld (lignes ignorees : %ld)\n",
+               bilan->autresErreurs, bilan->lignesIgnorees);
+    }
+
+    afficherLatences("ENTRY", &bilan->entrees);
+    afficherLatences("EXIT", &bilan->sorties);
+}
+
+/**
+ * @brief Rejoue une trace contre un parking neuf
+ * @param entree Flux de la trace
+ * @param nombrePlaces Nombre de places du parking
+ * @return 0 si succes, 1 sinon
+ */
+static int rejouerTrace(FILE *entree, int nombrePlaces)
+{
+    char ligne[TAILLE_LIGNE_LOT];
+    BilanRejeu bilan;
+    Parking parking;
+    long lignes;
+    int lecture;
+    int resultat;
+
+    memset(&bilan, 0, sizeof(bilan));
+
+    if (initialiserParking(&parking, "Trafic", nombrePlaces) == 0) {
+        fprintf(stderr, "Erreur : %s\n", messageErreur(ERREUR_MEMOIRE));
+        return 1;
+    }
+
+    /* Tarifs par defaut et journee simulee commencant a minuit : les
+     * tarifs horaires s'appliquent aux heures de la trace */
+    appliquerTarifsParDefaut();
+    choisirSourceHorloge(HORLOGE_SIMULEE);
+    reglerHorlogeSimulee(creerHorodatage(1, 12, 2025, 0, 0));
+
+    resultat = 1;
+    lignes = 0;
+    while (resultat &&
+           (lecture = lireLigneLot(entree, ligne, sizeof(ligne))) != 0) {
+        lignes++;
+
+        if (lecture == 1) {
+            resultat = rejouerLigne(&parking, ligne, lignes, &bilan);
+        } else {
+            fprintf(stderr, "ERR %ld ligne trop longue\n", lignes);
+            bilan.lignesIgnorees++;
+        }
+
+        /* Entretien periodique hors mesure, comme en mode par lot */
+        if (lignes % COMMANDES_PAR_ENTRETIEN == 0) {
+            archiverHistorique(&parking);
+        }
+    }
+
+    if (resultat) {
+        afficherRejeu(&parking, &bilan);
+    } else {
+        fprintf(stderr, "Erreur : %s\n", messageErreur(ERREUR_MEMOIRE));
+    }
+
+    free(bilan.entrees.valeurs);
+    free(bilan.sorties.valeurs);
+    libererParking(&parking);
+
+    return resultat ? 0 : 1;
+}
+
+/* ============================================================================
+ * PROGRAMME
+ * ============================================================================ */
+
+static void afficherUsageTrafic(const char *programme)
+{
+    fprintf(stderr,
+            "Usage : %s generer [--heures n] [--taux v,m,c,b] "
+            "[--sejours v,m,c,b]\n"
+            "                   [--dispersion s] [--profil p0,...,p23] "
+            "[--graine n]\n"
+            "        %s rejouer <trace|-> [--places n]\n",
+            programme, programme);
+}
+
+int main(int argc, char *argv[])
+{
+    ParametresTrafic parametres;
+    FILE *entree;
+    char *fin;
+    long places;
+    int resultat;
+
+    if (argc >= 2 && strcmp(argv[1], "generer") == 0) {
+        if (lireParametresTrafic(argc, argv, &parametres) == 0) {
+            afficherUsageTrafic(argv[0]);
+            return 1;
+        }
+        if (genererTrafic(&parametres, stdout) == 0) {
+            fprintf(stderr, "Erreur : %s\n", messageErreur(ERREUR_MEMOIRE));
+            return 1;
+        }
+        return 0;
+    }
+
+    if (argc >= 3 && strcmp(argv[1], "rejouer") == 0) {
+        places = PLACES_PAR_DEFAUT;
+        if (argc == 5 && strcmp(argv[3], "--places") == 0) {
+            places = strtol(argv[4], &fin, 10);
+            if (*fin != '\0' || places < 1 || places > PLACES_MAXIMALES) {
+                fprintf(stderr, "Erreur : nombre de places invalide : %s\n",
+                        argv[4]);
+                return 1;
+            }
+        } else if (argc != 3) {
+            afficherUsageTrafic(argv[0]);
+            return 1;
+        }
+
+        entree = stdin;
+        if (strcmp(argv[2], "-") != 0) {
+            entree = fopen(argv[2], "r");
+            if (entree == NULL) {
+                fprintf(stderr, "Erreur : Impossible d'ouvrir %s\n", argv[2]);
+                return 1;
+            }
+        }
+
+        resultat = rejouerTrace(entree, (int)places);
+
+        if (entree != stdin) {
+            fclose(entree);
+        }
+        return resultat;
+    }
+
+    afficherUsageTrafic(argv[0]);
+
+    return 1;
+}
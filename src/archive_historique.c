@@ -0,0 +1,256 @@
+/**
+ * @file archive_historique.c
+ * @brief Segmentation et archivage de l'historique des vehicules
+ * @date Decembre 2025
+ *
+ * Chaque bloc de l'arene d'historique forme un segment. Le segment le
+ * plus ancien est scelle des qu'il est complet et que tous ses
+ * vehicules sont sortis ; au-dela d'un nombre de segments ou d'un age
+ * configurables, il est ecrit dans le fichier d'archive puis libere.
+ * Le chemin des entrees et sorties ne manipule ainsi que les segments
+ * recents. Les rapports relisent les segments archives a la demande,
+ * et ne lisent un segment venu de la sauvegarde qu'apres son controle.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/parking.h"
+#include "../include/utilitaires.h"
+#include "../include/tri_recherche.h"
+#include "../include/persistance.h"
+#include "../include/prototypes.h"
+
+/** Nombre de vehicules par segment */
+#define VEHICULES_PAR_SEGMENT (1 << DECALAGE_BLOC_HISTORIQUE)
+
+/* ============================================================================
+ * CONFIGURATION
+ * ============================================================================ */
+
+int configurerArchivage(Parking *parking, const char *fichier,
+                        int segmentsMax, int ageMaxMinutes)
+{
+    ArchiveHistorique *archive;
+
+    if (parking == NULL || fichier == NULL || segmentsMax < 0) {
+        return 0;
+    }
+
+    archive = parking->archive;
+
+    if (archive == NULL) {
+        archive = (ArchiveHistorique*)calloc(1, sizeof(ArchiveHistorique));
+        if (archive == NULL) {
+            return 0;
+        }
+        archive->blocEnCache = -1;
+        parking->archive = archive;
+    }
+
+    /* Des segments deja archives imposent de garder leur fichier */
+    if (archive->premierBloc == 0) {
+        strncpy(archive->fichier, fichier, MAX_CHEMIN - 1);
+        archive->fichier[MAX_CHEMIN - 1] = '\0';
+    }
+
+    archive->segmentsMax = segmentsMax;
+    archive->ageMaxMinutes = ageMaxMinutes;
+
+    return 1;
+}
+
+void libererArchive(Parking *parking)
+{
+    if (parking == NULL || parking->archive == NULL) {
+        return;
+    }
+
+    free(parking->archive->cache);
+    free(parking->archive);
+    parking->archive = NULL;
+}
+
+int premierVehiculeEnMemoire(const Parking *parking)
+{
+    if (parking == NULL || parking->archive == NULL) {
+        return 0;
+    }
+
+    return parking->archive->premierBloc << DECALAGE_BLOC_HISTORIQUE;
+}
+
+/* ============================================================================
+ * SCELLEMENT ET ARCHIVAGE
+ * ============================================================================ */
+
+/**
+ * @brief Indique si le segment le plus ancien en memoire doit partir
+ * @param parking Pointeur vers le parking
+ * @param maintenant Horodatage courant pour le critere d'age
+ * @return 1 si le segment est scelle et a depasse un seuil, 0 sinon
+ */
+static int segmentAArchiver(const Parking *parking, Horodatage maintenant)
+{
+    const ArchiveHistorique *archive;
+    const Vehicule *segment;
+    const Vehicule *plusRecent;
+    int segmentsEnMemoire;
+    int i;
+
+    archive = parking->archive;
+
+    /* Le segment de queue, incomplet, reste toujours en memoire */
+    if ((archive->premierBloc + 1) << DECALAGE_BLOC_HISTORIQUE >
+        parking->nombreVehicules) {
+        return 0;
+    }
+
+    /* Un segment corrompu de la sauvegarde n'est pas recopie dans
+     * l'archive */
+    if (controlerBlocHistorique(parking, archive->premierBloc) == 0) {
+        return 0;
+    }
+
+    segment = obtenirVehicule(parking,
+                              archive->premierBloc << DECALAGE_BLOC_HISTORIQUE);
+    plusRecent = NULL;
+
+    /* Scelle seulement si tous ses vehicules sont sortis */
+    for (i = 0; i < VEHICULES_PAR_SEGMENT; i++) {
+        if (segment[i].estPresent == 1) {
+            return 0;
+        }
+        if (plusRecent == NULL ||
+            comparerHorodatages(segment[i].sortie, plusRecent->sortie) > 0) {
+            plusRecent = &segment[i];
+        }
+    }
+
+    /* Critere de taille : segments complets au-dela du seuil */
+    segmentsEnMemoire = parking->historique.nombreBlocs - archive->premierBloc - 1;
+    if (segmentsEnMemoire > archive->segmentsMax) {
+        return 1;
+    }
+
+    /* Critere d'age : derniere sortie du segment trop ancienne */
+    return archive->ageMaxMinutes > 0 &&
+           calculerDureeMinutes(plusRecent->sortie, maintenant) >=
+           archive->ageMaxMinutes;
+}
+
+int archiverHistorique(Parking *parking)
+{
+    ArchiveHistorique *archive;
+    FILE *fichier;
+    Horodatage maintenant;
+    long position;
+    int premier;
+    int ecrit;
+    int bloc;
+
+    if (parking == NULL || parking->archive == NULL) {
+        return 0;
+    }
+
+    archive = parking->archive;
+    maintenant = obtenirHorodatageActuel();
+    premier = archive->premierBloc;
+    fichier = NULL;
+
+    while (segmentAArchiver(parking, maintenant)) {
+        if (fichier == NULL) {
+            /* Creation au besoin, puis ecriture a la position du segment */
+            fichier = fopen(archive->fichier, "r+b");
+            if (fichier == NULL) {
+                fichier = fopen(archive->fichier, "w+b");
+            }
+            if (fichier == NULL) {
+                return 0;
+            }
+        }
+
+        position = (long)archive->premierBloc * VEHICULES_PAR_SEGMENT *
+                   (long)sizeof(Vehicule);
+        ecrit = fseek(fichier, position, SEEK_SET) == 0 &&
+                fwrite(parking->historique.blocs[archive->premierBloc],
+                       sizeof(Vehicule), VEHICULES_PAR_SEGMENT, fichier) ==
+                VEHICULES_PAR_SEGMENT;
+
+        if (ecrit == 0) {
+            break;
+        }
+
+        /* Segment ecrit, encore en memoire jusqu'a la synchronisation */
+        archive->premierBloc++;
+    }
+
+    if (fichier == NULL) {
+        return 0;
+    }
+
+    /* Une seule synchronisation pour le lot : la sauvegarde suivante ne
+     * porte plus ces segments, ils doivent etre sur disque avant */
+    if (archive->premierBloc > premier && synchroniserFlux(fichier) == 0) {
+        archive->premierBloc = premier;
+    }
+    fclose(fichier);
+
+    for (bloc = premier; bloc < archive->premierBloc; bloc++) {
+        libererBlocArene(&parking->historique, bloc);
+    }
+
+    return archive->premierBloc - premier;
+}
+
+/* ============================================================================
+ * LECTURE A TRAVERS LES SEGMENTS
+ * ============================================================================ */
+
+const Vehicule* lireVehicule(const Parking *parking, int indice)
+{
+    ArchiveHistorique *archive;
+    FILE *fichier;
+    int bloc;
+    int lu;
+
+    bloc = indice >> DECALAGE_BLOC_HISTORIQUE;
+    archive = parking->archive;
+
+    /* Segment encore en memoire, controle a son premier acces */
+    if (archive == NULL || bloc >= archive->premierBloc) {
+        return controlerBlocHistorique(parking, bloc) ?
+               obtenirVehicule(parking, indice) : NULL;
+    }
+
+    /* Segment archive : relu dans le cache s'il n'y est pas deja */
+    if (archive->blocEnCache != bloc) {
+        if (archive->cache == NULL) {
+            archive->cache = (Vehicule*)malloc(VEHICULES_PAR_SEGMENT *
+                                               sizeof(Vehicule));
+            if (archive->cache == NULL) {
+                return NULL;
+            }
+        }
+
+        fichier = fopen(archive->fichier, "rb");
+        lu = fichier != NULL &&
+             fseek(fichier, (long)bloc * VEHICULES_PAR_SEGMENT *
+                   (long)sizeof(Vehicule), SEEK_SET) == 0 &&
+             fread(archive->cache, sizeof(Vehicule), VEHICULES_PAR_SEGMENT,
+                   fichier) == VEHICULES_PAR_SEGMENT;
+
+        if (fichier != NULL) {
+            fclose(fichier);
+        }
+
+        if (lu == 0) {
+            archive->blocEnCache = -1;
+            return NULL;
+        }
+
+        archive->blocEnCache = bloc;
+    }
+
+    return &archive->cache[indice & (VEHICULES_PAR_SEGMENT - 1)];
+}
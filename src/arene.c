@@ -0,0 +1,204 @@
+/**
+ * @file arene.c
+ * @brief Stockage extensible par blocs de taille fixe
+ * @date Decembre 2025
+ *
+ * Une arene range des elements de meme taille dans des blocs alloues
+ * au fur et a mesure. Seul le tableau des pointeurs de blocs est
+ * realloue : un element ne change jamais d'adresse, ce qui garde
+ * valides les pointeurs Place::vehiculeActuel.
+ *
+ * Des blocs peuvent aussi etre empruntes a une memoire externe (fichier
+ * projete en memoire) : ils sont utilises comme les autres mais ne sont
+ * jamais liberes par l'arene.
+ */
+
+#include <stdlib.h>
+#include "../include/types.h"
+#include "../include/prototypes.h"
+
+/* ============================================================================
+ * GESTION DE L'ARENE
+ * ============================================================================ */
+
+void initialiserArene(Arene *arene, int tailleElement, int decalageBloc)
+{
+    if (arene == NULL) {
+        return;
+    }
+
+    arene->blocs = NULL;
+    arene->nombreBlocs = 0;
+    arene->capaciteBlocs = 0;
+    arene->tailleElement = tailleElement;
+    arene->decalageBloc = decalageBloc;
+    arene->nombreElements = 0;
+    arene->debutEmprunt = 0;
+    arene->finEmprunt = 0;
+}
+
+/**
+ * @brief Indique si un bloc appartient a une memoire empruntee
+ * @param arene Pointeur vers l'arene
+ * @param bloc Indice du bloc
+ * @return 1 si le bloc est emprunte, 0 s'il a ete alloue par l'arene
+ */
+static int blocEmprunte(const Arene *arene, int bloc)
+{
+    return bloc >= arene->debutEmprunt && bloc < arene->finEmprunt;
+}
+
+/**
+ * @brief Garantit la place de nouveaux blocs dans le tableau des blocs
+ * @param arene Pointeur vers l'arene (dont le dernier bloc est complet)
+ * @param nombre Nombre de blocs a ajouter
+ * @return 1 si succes, 0 sinon
+ */
+static int reserverBlocs(Arene *arene, int nombre)
+{
+    int nouvelleCapacite;
+    void **nouveauxBlocs;
+
+    if (nombre < 0 ||
+        arene->nombreElements != arene->nombreBlocs << arene->decalageBloc) {
+        return 0;
+    }
+
+    if (arene->nombreBlocs + nombre > arene->capaciteBlocs) {
+        nouvelleCapacite = arene->nombreBlocs + nombre + 8;
+        nouveauxBlocs = (void**)realloc(arene->blocs,
+                                        nouvelleCapacite * sizeof(void*));
+        if (nouveauxBlocs == NULL) {
+            return 0;
+        }
+        arene->blocs = nouveauxBlocs;
+        arene->capaciteBlocs = nouvelleCapacite;
+    }
+
+    return 1;
+}
+
+void* ajouterElementArene(Arene *arene)
+{
+    int elementsParBloc;
+    int nouvelleCapacite;
+    void **nouveauxBlocs;
+    void *bloc;
+    int indice;
+
+    if (arene == NULL) {
+        return NULL;
+    }
+
+    elementsParBloc = 1 << arene->decalageBloc;
+    indice = arene->nombreElements;
+
+    /* Nouveau bloc necessaire */
+    if (indice >> arene->decalageBloc >= arene->nombreBlocs) {
+        if (arene->nombreBlocs == arene->capaciteBlocs) {
+            nouvelleCapacite = arene->capaciteBlocs == 0 ?
+                               8 : arene->capaciteBlocs * 2;
+            nouveauxBlocs = (void**)realloc(arene->blocs,
+                                            nouvelleCapacite * sizeof(void*));
+            if (nouveauxBlocs == NULL) {
+                return NULL;
+            }
+            arene->blocs = nouveauxBlocs;
+            arene->capaciteBlocs = nouvelleCapacite;
+        }
+
+        bloc = calloc((size_t)elementsParBloc, (size_t)arene->tailleElement);
+        if (bloc == NULL) {
+            return NULL;
+        }
+        arene->blocs[arene->nombreBlocs++] = bloc;
+    }
+
+    arene->nombreElements++;
+
+    return elementArene(arene, indice);
+}
+
+int ajouterBlocsVidesArene(Arene *arene, int nombre)
+{
+    if (arene == NULL || reserverBlocs(arene, nombre) == 0) {
+        return 0;
+    }
+
+    /* Blocs sans memoire : leurs elements vivent ailleurs (archive) */
+    while (nombre-- > 0) {
+        arene->blocs[arene->nombreBlocs++] = NULL;
+        arene->nombreElements += 1 << arene->decalageBloc;
+    }
+
+    return 1;
+}
+
+int emprunterBlocsArene(Arene *arene, void *memoire, int nombre)
+{
+    size_t tailleBloc;
+    int i;
+
+    if (arene == NULL || memoire == NULL || reserverBlocs(arene, nombre) == 0) {
+        return 0;
+    }
+
+    /* Un seul intervalle de blocs empruntes par arene */
+    if (arene->finEmprunt > arene->debutEmprunt &&
+        arene->finEmprunt != arene->nombreBlocs) {
+        return 0;
+    }
+    if (arene->finEmprunt == arene->debutEmprunt) {
+        arene->debutEmprunt = arene->nombreBlocs;
+    }
+
+    tailleBloc = (size_t)arene->tailleElement << arene->decalageBloc;
+
+    for (i = 0; i < nombre; i++) {
+        arene->blocs[arene->nombreBlocs++] = (char*)memoire + i * tailleBloc;
+        arene->nombreElements += 1 << arene->decalageBloc;
+    }
+    arene->finEmprunt = arene->nombreBlocs;
+
+    return 1;
+}
+
+void libererBlocArene(Arene *arene, int bloc)
+{
+    if (arene == NULL || bloc < 0 || bloc >= arene->nombreBlocs) {
+        return;
+    }
+
+    if (blocEmprunte(arene, bloc) == 0) {
+        free(arene->blocs[bloc]);
+    }
+    arene->blocs[bloc] = NULL;
+}
+
+void* elementArene(const Arene *arene, int indice)
+{
+    char *bloc;
+
+    bloc = (char*)arene->blocs[indice >> arene->decalageBloc];
+
+    return bloc + (size_t)(indice & ((1 << arene->decalageBloc) - 1)) *
+                  (size_t)arene->tailleElement;
+}
+
+void libererArene(Arene *arene)
+{
+    int i;
+
+    if (arene == NULL) {
+        return;
+    }
+
+    for (i = 0; i < arene->nombreBlocs; i++) {
+        if (blocEmprunte(arene, i) == 0) {
+            free(arene->blocs[i]);
+        }
+    }
+
+    free(arene->blocs);
+    initialiserArene(arene, arene->tailleElement, arene->decalageBloc);
+}
@@ -0,0 +1,257 @@
+/**
+ * @file index_plaques.c
+ * @brief Index de hachage des plaques des vehicules presents
+ * @date Decembre 2025
+ *
+ * Table a adressage ouvert (sondage lineaire) associant une plaque
+ * normalisee a l'indice du vehicule present dans l'historique.
+ * La recherche reste en temps constant quelle que soit la taille
+ * de l'historique.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "../include/parking.h"
+#include "../include/prototypes.h"
+
+/** Marqueur d'une case vide dans l'index */
+#define CASE_VIDE -1
+
+/* ============================================================================
+ * NORMALISATION ET HACHAGE
+ * ============================================================================ */
+
+/**
+ * @brief Retourne le prochain caractere significatif d'une plaque
+ * @param plaque Pointeur sur la position courante (avance)
+ * @return Caractere en majuscule, '\0' en fin de chaine
+ *
+ * Les espaces et tirets sont ignores : "ab-123 cd" equivaut a "AB123CD".
+ */
+static int caractereSuivant(const char **plaque)
+{
+    while (**plaque == ' ' || **plaque == '-') {
+        (*plaque)++;
+    }
+
+    if (**plaque == '\0') {
+        return '\0';
+    }
+
+    return toupper((unsigned char)*(*plaque)++);
+}
+
+unsigned int hacherPlaque(const char *plaque)
+{
+    unsigned int empreinte;
+    int c;
+
+    /* FNV-1a sur la plaque normalisee */
+    empreinte = 2166136261u;
+
+    while ((c = caractereSuivant(&plaque)) != '\0') {
+        empreinte ^= (unsigned int)c;
+        empreinte *= 16777619u;
+    }
+
+    return empreinte;
+}
+
+int plaquesEquivalentes(const char *plaque1, const char *plaque2)
+{
+    int c1;
+    int c2;
+
+    do {
+        c1 = caractereSuivant(&plaque1);
+        c2 = caractereSuivant(&plaque2);
+
+        if (c1 != c2) {
+            return 0;
+        }
+    } while (c1 != '\0');
+
+    return 1;
+}
+
+/* ============================================================================
+ * GESTION DE L'INDEX
+ * ============================================================================ */
+
+void viderIndexPlaques(Parking *parking)
+{
+    int i;
+
+    if (parking == NULL) {
+        return;
+    }
+
+    for (i = 0; i < parking->tailleIndex; i++) {
+        parking->indexPlaques[i] = CASE_VIDE;
+    }
+}
+
+int indexerVehicule(Parking *parking, int indiceVehicule)
+{
+    unsigned int masque;
+    unsigned int position;
+    int i;
+
+    if (parking == NULL || indiceVehicule < 0) {
+        return 0;
+    }
+
+    masque = (unsigned int)parking->tailleIndex - 1;
+    position = hacherPlaque(obtenirVehicule(parking, indiceVehicule)->plaque) &
+               masque;
+
+    /* Sondage lineaire jusqu'a la premiere case vide */
+    for (i = 0; i < parking->tailleIndex; i++) {
+        if (parking->indexPlaques[position] == CASE_VIDE) {
+            parking->indexPlaques[position] = indiceVehicule;
+            return 1;
+        }
+        position = (position + 1) & masque;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Localise la case de l'index contenant une plaque
+ * @param parking Pointeur vers le parking
+ * @param plaque Plaque recherchee
+ * @return Position dans l'index, -1 si absente
+ */
+static int localiserPlaque(const Parking *parking, const char *plaque)
+{
+    unsigned int masque;
+    unsigned int position;
+    int indice;
+    int i;
+
+    masque = (unsigned int)parking->tailleIndex - 1;
+    position = hacherPlaque(plaque) & masque;
+
+    for (i = 0; i < parking->tailleIndex; i++) {
+        indice = parking->indexPlaques[position];
+
+        if (indice == CASE_VIDE) {
+            return -1;
+        }
+
+        if (plaquesEquivalentes(obtenirVehicule(parking, indice)->plaque,
+                                plaque)) {
+            return (int)position;
+        }
+
+        position = (position + 1) & masque;
+    }
+
+    return -1;
+}
+
+int rechercherIndexPlaque(const Parking *parking, const char *plaque)
+{
+    int position;
+
+    if (parking == NULL || plaque == NULL) {
+        return -1;
+    }
+
+    position = localiserPlaque(parking, plaque);
+
+    if (position == -1) {
+        return -1;
+    }
+
+    return parking->indexPlaques[position];
+}
+
+void retirerIndexPlaque(Parking *parking, const char *plaque)
+{
+    unsigned int masque;
+    unsigned int trou;
+    unsigned int position;
+    unsigned int ideale;
+    int indice;
+    int trouve;
+
+    if (parking == NULL || plaque == NULL) {
+        return;
+    }
+
+    trouve = localiserPlaque(parking, plaque);
+
+    if (trouve == -1) {
+        return;
+    }
+
+    /* Suppression par decalage arriere : pas de pierre tombale, les
+     * elements suivants de la sequence remontent dans le trou */
+    masque = (unsigned int)parking->tailleIndex - 1;
+    trou = (unsigned int)trouve;
+    position = (trou + 1) & masque;
+
+    while ((indice = parking->indexPlaques[position]) != CASE_VIDE) {
+        ideale = hacherPlaque(obtenirVehicule(parking, indice)->plaque) &
+                 masque;
+
+        /* L'element peut remonter si sa case ideale ne se trouve
+         * pas strictement entre le trou et sa position actuelle */
+        if (((position - ideale) & masque) >= ((position - trou) & masque)) {
+            parking->indexPlaques[trou] = indice;
+            trou = position;
+        }
+
+        position = (position + 1) & masque;
+    }
+
+    parking->indexPlaques[trou] = CASE_VIDE;
+}
+
+int redimensionnerIndexPlaques(Parking *parking, int nombrePlaces)
+{
+    int *ancienne;
+    int ancienneTaille;
+    int taille;
+    int i;
+
+    if (parking == NULL) {
+        return 0;
+    }
+
+    /* Puissance de 2 au moins double du nombre de places */
+    taille = 16;
+    while (taille < 2 * nombrePlaces) {
+        taille *= 2;
+    }
+
+    if (taille <= parking->tailleIndex) {
+        return 1;
+    }
+
+    ancienne = parking->indexPlaques;
+    ancienneTaille = parking->tailleIndex;
+
+    parking->indexPlaques = (int*)malloc(taille * sizeof(int));
+    if (parking->indexPlaques == NULL) {
+        parking->indexPlaques = ancienne;
+        return 0;
+    }
+    parking->tailleIndex = taille;
+    viderIndexPlaques(parking);
+
+    /* Redistribution des vehicules deja indexes */
+    for (i = 0; i < ancienneTaille; i++) {
+        if (ancienne[i] != CASE_VIDE) {
+            indexerVehicule(parking, ancienne[i]);
+        }
+    }
+
+    free(ancienne);
+
+    return 1;
+}
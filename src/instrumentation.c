@@ -0,0 +1,439 @@
+/**
+ * @file instrumentation.c
+ * @brief Implementation de la mesure des operations du coeur
+ * @date Decembre 2025
+ *
+ * Chaque thread recoit a sa premiere mesure un bloc de compteurs, chaine
+ * dans la liste de tous les blocs. Seul son thread ecrit dans un bloc
+ * (chargement et rangement atomiques, sans instruction verrouillee) ; les
+ * lectures parcourent la liste sous verrou. Les blocs survivent aux
+ * threads : leurs mesures restent comptees.
+ *
+ * Seule l'operation la plus externe d'un thread est chronometree : la
+ * recherche de place faite par une entree compte ses codes de retour mais
+ * ne charge pas l'entree de deux lectures d'horloge supplementaires.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "../include/instrumentation.h"
+#include "../include/utilitaires.h"
+
+/** Subdivisions par puissance de deux (precision relative 1/16) */
+#define SUBDIVISIONS 16
+
+/** Seuil des valeurs comptees une a une (nanosecondes) */
+#define SEUIL_LINEAIRE (2 * SUBDIVISIONS)
+
+/** Plus grande puissance de deux couverte (2^40 ns, environ 18 min) */
+#define EXPOSANT_MAXIMAL 39
+
+/** Nombre d'intervalles d'un histogramme */
+#define TAILLE_HISTOGRAMME (SEUIL_LINEAIRE + \
+                            (EXPOSANT_MAXIMAL - 4) * SUBDIVISIONS)
+
+/**
+ * @struct BlocMesures
+ * @brief Compteurs d'un thread
+ */
+typedef struct BlocMesures {
+    long long histogrammes[NOMBRE_MESURES][TAILLE_HISTOGRAMME];
+    long long retours[NOMBRE_MESURES][CODES_MESURES];
+    long long sommes[NOMBRE_MESURES];
+    long long maximums[NOMBRE_MESURES];
+    struct BlocMesures *suivant;
+} BlocMesures;
+
+/** Blocs de tous les threads (ajouts et lectures sous verrouBlocs) */
+static BlocMesures *premierBloc = NULL;
+static pthread_mutex_t verrouBlocs = PTHREAD_MUTEX_INITIALIZER;
+
+/** Bloc du thread courant et nombre d'operations mesurees en cours */
+#if defined(__GNUC__)
+static __thread BlocMesures *blocThread = NULL;
+static __thread int profondeurThread = 0;
+#else
+static BlocMesures *blocThread = NULL;
+static int profondeurThread = 0;
+#endif
+
+/** Noms des operations, dans l'ordre de OperationMesuree */
+static const char *nomsMesures[NOMBRE_MESURES] = {
+    "enregistrerEntree",
+    "enregistrerSortie",
+    "rechercherVehicule",
+    "rechercherPlaceLibre",
+    "modifierEtatPlace"
+};
+
+/** Noms courts des codes de retour, indices par -code */
+static const char *nomsCodesMesures[CODES_MESURES] = {
+    "SUCCES",
+    "PARAMETRE",
+    "MEMOIRE",
+    "DEJA_PRESENT",
+    "AUCUNE_PLACE",
+    "VEHICULE_ABSENT",
+    "DEJA_SORTI",
+    "PLACE_INVALIDE",
+    "FICHIER_ABSENT",
+    "FICHIER_INVALIDE",
+    "ENTREE_SORTIE",
+    "PLACE_OCCUPEE"
+};
+
+/* ============================================================================
+ * HISTOGRAMMES
+ * ============================================================================ */
+
+#ifndef PARKING_SANS_MESURES
+
+/**
+ * @brief Indice du bit de poids fort actif d'un mot non nul
+ * @param mot Mot de 64 bits (non nul)
+ * @return Position du dernier bit a 1
+ */
+static int dernierBitActif(unsigned long long mot)
+{
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(mot);
+#else
+    int position;
+
+    position = 0;
+    while (mot > 1ULL) {
+        mot >>= 1;
+        position++;
+    }
+    return position;
+#endif
+}
+
+/**
+ * @brief Intervalle de l'histogramme d'une duree
+ * @param nanosecondes Duree mesuree
+ * @return Indice de l'intervalle
+ *
+ * En dessous de SEUIL_LINEAIRE, un intervalle par nanoseconde ; au-dela,
+ * SUBDIVISIONS intervalles egaux par puissance de deux.
+ */
+static int intervalleHistogramme(unsigned long long nanosecondes)
+{
+    int exposant;
+
+    if (nanosecondes < SEUIL_LINEAIRE) {
+        return (int)nanosecondes;
+    }
+
+    exposant = dernierBitActif(nanosecondes);
+    if (exposant > EXPOSANT_MAXIMAL) {
+        return TAILLE_HISTOGRAMME - 1;
+    }
+
+    return SEUIL_LINEAIRE + (exposant - 5) * SUBDIVISIONS +
+           (int)((nanosecondes >> (exposant - 4)) & (SUBDIVISIONS - 1));
+}
+
+#endif /* PARKING_SANS_MESURES */
+
+/**
+ * @brief Valeur representative (milieu) d'un intervalle
+ * @param indice Indice de l'intervalle
+ * @return Duree en nanosecondes
+ */
+static double valeurIntervalle(int indice)
+{
+    int exposant;
+    unsigned long long largeur;
+    unsigned long long debut;
+
+    if (indice < SEUIL_LINEAIRE) {
+        return (double)indice;
+    }
+
+    exposant = (indice - SEUIL_LINEAIRE) / SUBDIVISIONS + 5;
+    largeur = 1ULL << (exposant - 4);
+    debut = (unsigned long long)(SUBDIVISIONS +
+                                 (indice - SEUIL_LINEAIRE) % SUBDIVISIONS) *
+            largeur;
+
+    return (double)debut + (double)largeur / 2.0;
+}
+
+/* ============================================================================
+ * ENREGISTREMENT
+ * ============================================================================ */
+
+#ifndef PARKING_SANS_MESURES
+
+/**
+ * @brief Ajoute a un compteur ecrit par un seul thread
+ * @param compteur Compteur du bloc du thread courant
+ * @param valeur Valeur a ajouter
+ */
+static void ajouterMesure(long long *compteur, long long valeur)
+{
+    __atomic_store_n(compteur,
+                     __atomic_load_n(compteur, __ATOMIC_RELAXED) + valeur,
+                     __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Bloc du thread courant, cree a sa premiere mesure
+ * @return Bloc, NULL si memoire insuffisante
+ */
+static BlocMesures* obtenirBlocThread(void)
+{
+    BlocMesures *bloc;
+
+    if (blocThread != NULL) {
+        return blocThread;
+    }
+
+    bloc = (BlocMesures*)calloc(1, sizeof(BlocMesures));
+    if (bloc == NULL) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&verrouBlocs);
+    bloc->suivant = premierBloc;
+    premierBloc = bloc;
+    pthread_mutex_unlock(&verrouBlocs);
+
+    blocThread = bloc;
+
+    return bloc;
+}
+
+#endif /* PARKING_SANS_MESURES */
+
+double debuterMesure(void)
+{
+#ifdef PARKING_SANS_MESURES
+    return 0.0;
+#else
+    /* Operation appelee par une autre operation mesuree : comptee, pas
+     * chronometree (deux lectures d'horloge de moins) */
+    if (profondeurThread++ > 0) {
+        return -1.0;
+    }
+
+    return instantMonotone();
+#endif
+}
+
+void terminerMesure(OperationMesuree operation, double debut, int code)
+{
+#ifdef PARKING_SANS_MESURES
+    (void)operation;
+    (void)debut;
+    (void)code;
+#else
+    BlocMesures *bloc;
+    double duree;
+    long long nanosecondes;
+
+    duree = debut >= 0.0 ? instantMonotone() - debut : -1.0;
+    profondeurThread--;
+
+    bloc = obtenirBlocThread();
+    if (bloc == NULL || operation < 0 || operation >= NOMBRE_MESURES) {
+        return;
+    }
+
+    if (code > 0 || code <= -CODES_MESURES) {
+        code = SUCCES;
+    }
+    ajouterMesure(&bloc->retours[operation][-code], 1);
+
+    if (duree < 0.0) {
+        return;
+    }
+
+    nanosecondes = (long long)(duree * 1e9);
+    ajouterMesure(&bloc->histogrammes[operation]
+                                     [intervalleHistogramme(nanosecondes)], 1);
+    ajouterMesure(&bloc->sommes[operation], nanosecondes);
+    if (nanosecondes > bloc->maximums[operation]) {
+        __atomic_store_n(&bloc->maximums[operation], nanosecondes,
+                         __ATOMIC_RELAXED);
+    }
+#endif
+}
+
+/* ============================================================================
+ * CONSULTATION
+ * ============================================================================ */
+
+/**
+ * @brief Valeur du percentile dans un histogramme cumule
+ * @param histogramme Comptes par intervalle
+ * @param nombre Nombre total de mesures (non nul)
+ * @param percentile Percentile (0 a 100)
+ * @param maximum Plus grande duree mesuree
+ * @return Duree en nanosecondes
+ */
+static double percentileHistogramme(const long long histogramme[],
+                                    long long nombre, int percentile,
+                                    double maximum)
+{
+    long long rang;
+    long long cumul;
+    double valeur;
+    int i;
+
+    /* Rang le plus proche */
+    rang = (percentile * nombre + 99) / 100;
+    if (rang < 1) {
+        rang = 1;
+    }
+
+    cumul = 0;
+    for (i = 0; i < TAILLE_HISTOGRAMME; i++) {
+        cumul += histogramme[i];
+        if (cumul >= rang) {
+            break;
+        }
+    }
+
+    valeur = valeurIntervalle(i < TAILLE_HISTOGRAMME ?
+                              i : TAILLE_HISTOGRAMME - 1);
+
+    return valeur < maximum ? valeur : maximum;
+}
+
+void resumerMesure(OperationMesuree operation, ResumeMesure *resume)
+{
+    long long histogramme[TAILLE_HISTOGRAMME];
+    long long somme;
+    long long maximum;
+    long long valeur;
+    BlocMesures *bloc;
+    int i;
+
+    if (resume == NULL) {
+        return;
+    }
+
+    memset(resume, 0, sizeof(*resume));
+    if (operation < 0 || operation >= NOMBRE_MESURES) {
+        return;
+    }
+
+    memset(histogramme, 0, sizeof(histogramme));
+    somme = 0;
+    maximum = 0;
+
+    pthread_mutex_lock(&verrouBlocs);
+    for (bloc = premierBloc; bloc != NULL; bloc = bloc->suivant) {
+        for (i = 0; i < TAILLE_HISTOGRAMME; i++) {
+            valeur = __atomic_load_n(&bloc->histogrammes[operation][i],
+                                     __ATOMIC_RELAXED);
+            histogramme[i] += valeur;
+            resume->chronometrees += valeur;
+        }
+        for (i = 0; i < CODES_MESURES; i++) {
+            valeur = __atomic_load_n(&bloc->retours[operation][i],
+                                     __ATOMIC_RELAXED);
+            resume->retours[i] += valeur;
+            resume->nombre += valeur;
+        }
+        somme += __atomic_load_n(&bloc->sommes[operation], __ATOMIC_RELAXED);
+        valeur = __atomic_load_n(&bloc->maximums[operation],
+                                 __ATOMIC_RELAXED);
+        if (valeur > maximum) {
+            maximum = valeur;
+        }
+    }
+    pthread_mutex_unlock(&verrouBlocs);
+
+    if (resume->chronometrees == 0) {
+        return;
+    }
+
+    resume->maximum = (double)maximum;
+    resume->moyenne = (double)somme / resume->chronometrees;
+    resume->p50 = percentileHistogramme(histogramme, resume->chronometrees,
+                                        50, resume->maximum);
+    resume->p90 = percentileHistogramme(histogramme, resume->chronometrees,
+                                        90, resume->maximum);
+    resume->p99 = percentileHistogramme(histogramme, resume->chronometrees,
+                                        99, resume->maximum);
+}
+
+void reinitialiserMesures(void)
+{
+    BlocMesures *bloc;
+    BlocMesures *suivant;
+
+    pthread_mutex_lock(&verrouBlocs);
+    for (bloc = premierBloc; bloc != NULL; bloc = bloc->suivant) {
+        suivant = bloc->suivant;
+        memset(bloc, 0, sizeof(*bloc));
+        bloc->suivant = suivant;
+    }
+    pthread_mutex_unlock(&verrouBlocs);
+}
+
+const char* nomMesure(OperationMesuree operation)
+{
+    if (operation < 0 || operation >= NOMBRE_MESURES) {
+        return "inconnue";
+    }
+
+    return nomsMesures[operation];
+}
+
+const char* nomCodeMesure(int code)
+{
+    if (code > 0 || code <= -CODES_MESURES) {
+        return "INCONNU";
+    }
+
+    return nomsCodesMesures[-code];
+}
+
+int ecrireMesures(const char *fichier)
+{
+    ResumeMesure resume;
+    FILE *flux;
+    int operation;
+    int code;
+    int resultat;
+
+    if (fichier == NULL) {
+        return ERREUR_PARAMETRE;
+    }
+
+    flux = fopen(fichier, "w");
+    if (flux == NULL) {
+        return ERREUR_ENTREE_SORTIE;
+    }
+
+    for (operation = 0; operation < NOMBRE_MESURES; operation++) {
+        resumerMesure((OperationMesuree)operation, &resume);
+
+        fprintf(flux, "%s nombre=%lld chronometrees=%lld p50_ns=%.0f "
+                "p90_ns=%.0f p99_ns=%.0f max_ns=%.0f moyenne_ns=%.1f",
+                nomsMesures[operation], resume.nombre, resume.chronometrees,
+                resume.p50, resume.p90, resume.p99, resume.maximum,
+                resume.moyenne);
+
+        for (code = 1; code < CODES_MESURES; code++) {
+            if (resume.retours[code] > 0) {
+                fprintf(flux, " %s=%lld", nomsCodesMesures[code],
+                        resume.retours[code]);
+            }
+        }
+        fprintf(flux, "\n");
+    }
+
+    resultat = ferror(flux) ? ERREUR_ENTREE_SORTIE : SUCCES;
+    if (fclose(flux) != 0) {
+        resultat = ERREUR_ENTREE_SORTIE;
+    }
+
+    return resultat;
+}
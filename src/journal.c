@@ -0,0 +1,591 @@
+/**
+ * @file journal.c
+ * @brief Implementation du journal des operations (ecriture anticipee)
+ * @date Decembre 2025
+ *
+ * Le journal est une suite d'enregistrements de taille fixe, numerotes
+ * et proteges par un CRC32C. Les ecritures sont regroupees : le flux
+ * n'est synchronise sur disque qu'apres un nombre d'enregistrements ou
+ * un delai configurables, ou a la demande (avant d'attendre l'operateur).
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#include "../include/journal.h"
+#include "../include/parking.h"
+#include "../include/persistance.h"
+#include "../include/trace.h"
+#include "../include/prototypes.h"
+
+/* ============================================================================
+ * FORMAT DES ENREGISTREMENTS
+ * ============================================================================ */
+
+/**
+ * @enum OperationJournal
+ * @brief Nature d'une operation journalisee
+ */
+typedef enum {
+    JOURNAL_ENTREE = 1,
+    JOURNAL_SORTIE = 2,
+    JOURNAL_ETAT_PLACE = 3
+} OperationJournal;
+
+/**
+ * @struct EnregistrementJournal
+ * @brief Operation telle qu'ecrite dans le journal
+ *
+ * valeur contient le type du vehicule (entree) ou le nouvel etat de la
+ * place (changement d'etat). Le CRC couvre tout ce qui le suit.
+ */
+typedef struct {
+    uint32_t sequence;
+    uint32_t crc;
+    int32_t operation;
+    int32_t numeroPlace;
+    int32_t valeur;
+    int32_t minutes;
+    float montant;
+    char plaque[TAILLE_PLAQUE];
+    char proprietaire[MAX_CHAINE];
+} EnregistrementJournal;
+
+/**
+ * @brief Somme de controle d'un enregistrement
+ * @param enregistrement Enregistrement a controler
+ * @return CRC32C des champs suivant crc, numero de sequence compris
+ */
+static uint32_t crcEnregistrement(const EnregistrementJournal *enregistrement)
+{
+    uint32_t crc;
+
+    crc = calculerCrc32c(0, &enregistrement->sequence,
+                         sizeof(enregistrement->sequence));
+    return calculerCrc32c(crc, &enregistrement->operation,
+                          sizeof(EnregistrementJournal) -
+                          offsetof(EnregistrementJournal, operation));
+}
+
+/* ============================================================================
+ * SYNCHRONISATION
+ * ============================================================================ */
+
+int synchroniserJournal(Parking *parking)
+{
+    JournalParking *journal;
+    int synchronise;
+
+    if (parking == NULL || parking->journal == NULL) {
+        return 1;
+    }
+
+    journal = parking->journal;
+
+    if (journal->flux == NULL) {
+        return 0;
+    }
+    if (journal->enAttente == 0) {
+        return 1;
+    }
+
+    TRACER_DEBUT(TRACE_JOURNAL);
+    synchronise = synchroniserFlux(journal->flux);
+    TRACER_FIN(TRACE_JOURNAL);
+
+    if (synchronise == 0) {
+        return 0;
+    }
+
+    journal->enAttente = 0;
+    journal->derniereSynchro = (long)time(NULL);
+
+    return 1;
+}
+
+void fermerJournal(Parking *parking)
+{
+    if (parking == NULL || parking->journal == NULL) {
+        return;
+    }
+
+    synchroniserJournal(parking);
+    if (parking->journal->flux != NULL) {
+        fclose(parking->journal->flux);
+    }
+    free(parking->journal);
+    parking->journal = NULL;
+}
+
+int compacterJournal(Parking *parking, uint32_t sequenceSauvegardee)
+{
+    JournalParking *journal;
+    FILE *copie;
+    char nomTemporaire[MAX_CHEMIN + 8];
+    EnregistrementJournal enregistrement;
+    int erreur;
+
+    if (parking == NULL || parking->journal == NULL) {
+        return 0;
+    }
+
+    journal = parking->journal;
+    if (synchroniserJournal(parking) == 0) {
+        return 0;
+    }
+
+    sprintf(nomTemporaire, "%s.tmp", journal->fichier);
+    copie = fopen(nomTemporaire, "wb");
+    if (copie == NULL) {
+        return 0;
+    }
+
+    /* Copie des seules operations posterieures a la sauvegarde */
+    erreur = fseek(journal->flux, 0, SEEK_SET) != 0;
+
+    while (erreur == 0 &&
+           fread(&enregistrement, sizeof(enregistrement), 1,
+                 journal->flux) == 1) {
+        if (enregistrement.sequence > sequenceSauvegardee) {
+            erreur = fwrite(&enregistrement, sizeof(enregistrement), 1,
+                            copie) != 1;
+        }
+    }
+
+    erreur = erreur || synchroniserFlux(copie) == 0;
+    erreur = fclose(copie) != 0 || erreur;
+
+    if (erreur) {
+        remove(nomTemporaire);
+        fseek(journal->flux, 0, SEEK_END);
+        return 0;
+    }
+
+    /* Remplacement du journal, puis reprise des ajouts en fin de fichier */
+    fclose(journal->flux);
+#ifdef _WIN32
+    remove(journal->fichier);
+#endif
+    if (rename(nomTemporaire, journal->fichier) != 0) {
+        remove(nomTemporaire);
+    }
+
+    journal->flux = fopen(journal->fichier, "r+b");
+    if (journal->flux == NULL || fseek(journal->flux, 0, SEEK_END) != 0) {
+        if (journal->flux != NULL) {
+            fclose(journal->flux);
+        }
+        free(journal);
+        parking->journal = NULL;
+        return 0;
+    }
+    journal->finValide = ftell(journal->flux);
+
+    return 1;
+}
+
+/* ============================================================================
+ * ECRITURE DES OPERATIONS
+ * ============================================================================ */
+
+/**
+ * @brief Ramene le fichier du journal a son dernier enregistrement complet
+ * @param journal Journal dont une ecriture a echoue
+ *
+ * Le flux est ferme (son tampon part, meme incomplet) puis rouvert et
+ * tronque : aucun enregistrement dechire ne reste suivi d'enregistrements
+ * valides. Si le fichier ne peut etre ramene, ou s'il a perdu des
+ * enregistrements deja comptes (tampon jamais ecrit), le flux reste
+ * ferme et tout ajout suivant echoue.
+ */
+static void revenirFinValide(JournalParking *journal)
+{
+    fclose(journal->flux);
+
+    journal->flux = fopen(journal->fichier, "r+b");
+    if (journal->flux == NULL) {
+        return;
+    }
+
+    if (fseek(journal->flux, 0, SEEK_END) != 0 ||
+        ftell(journal->flux) < journal->finValide ||
+#ifdef _WIN32
+        _chsize(_fileno(journal->flux), journal->finValide) != 0 ||
+#else
+        ftruncate(fileno(journal->flux), (off_t)journal->finValide) != 0 ||
+#endif
+        fseek(journal->flux, journal->finValide, SEEK_SET) != 0) {
+        fclose(journal->flux);
+        journal->flux = NULL;
+    }
+}
+
+/**
+ * @brief Numerote et ajoute un enregistrement au journal
+ * @param parking Pointeur vers le parking
+ * @param enregistrement Enregistrement rempli (sequence et crc exceptes)
+ * @return SUCCES (ou journal ferme), ERREUR_ENTREE_SORTIE si
+ *         l'enregistrement n'a pu etre ecrit ou synchronise (il est alors
+ *         retire du fichier)
+ */
+static int ajouterEnregistrement(Parking *parking,
+                                 EnregistrementJournal *enregistrement)
+{
+    JournalParking *journal;
+
+    journal = parking->journal;
+    if (journal == NULL) {
+        return SUCCES;
+    }
+    if (journal->flux == NULL) {
+        return ERREUR_ENTREE_SORTIE;
+    }
+
+    enregistrement->sequence = parking->sequenceJournal + 1;
+    enregistrement->crc = crcEnregistrement(enregistrement);
+
+    if (fwrite(enregistrement, sizeof(EnregistrementJournal), 1,
+               journal->flux) != 1) {
+        revenirFinValide(journal);
+        return ERREUR_ENTREE_SORTIE;
+    }
+
+    parking->sequenceJournal = enregistrement->sequence;
+    journal->finValide += (long)sizeof(EnregistrementJournal);
+    journal->enAttente++;
+
+    /* Synchronisation groupee : nombre d'enregistrements ou delai atteint */
+    if ((journal->enAttente >= journal->groupeSynchro ||
+         (journal->delaiSynchroSecondes > 0 &&
+          (long)time(NULL) - journal->derniereSynchro >=
+          journal->delaiSynchroSecondes)) &&
+        synchroniserJournal(parking) == 0) {
+        annulerDernierEnregistrement(parking);
+        return ERREUR_ENTREE_SORTIE;
+    }
+
+    return SUCCES;
+}
+
+void annulerDernierEnregistrement(Parking *parking)
+{
+    JournalParking *journal;
+
+    if (parking == NULL || parking->journal == NULL ||
+        parking->journal->flux == NULL) {
+        return;
+    }
+
+    journal = parking->journal;
+    journal->finValide -= (long)sizeof(EnregistrementJournal);
+    parking->sequenceJournal--;
+    if (journal->enAttente > 0) {
+        journal->enAttente--;
+    }
+
+    revenirFinValide(journal);
+}
+
+int journaliserEntree(Parking *parking, const char *plaque,
+                      const char *proprietaire, TypeVehicule type,
+                      int numeroPlace, Horodatage entree)
+{
+    EnregistrementJournal enregistrement;
+
+    if (parking == NULL || parking->journal == NULL) {
+        return SUCCES;
+    }
+
+    /* Memes troncatures que appliquerEntree */
+    memset(&enregistrement, 0, sizeof(enregistrement));
+    enregistrement.operation = JOURNAL_ENTREE;
+    enregistrement.numeroPlace = numeroPlace;
+    enregistrement.valeur = type;
+    enregistrement.minutes = entree.minutes;
+    strncpy(enregistrement.plaque, plaque, TAILLE_PLAQUE - 1);
+    strncpy(enregistrement.proprietaire, proprietaire, MAX_CHAINE - 1);
+
+    return ajouterEnregistrement(parking, &enregistrement);
+}
+
+int journaliserSortie(Parking *parking, const Vehicule *vehicule,
+                      Horodatage sortie, float montant)
+{
+    EnregistrementJournal enregistrement;
+
+    if (parking == NULL || parking->journal == NULL || vehicule == NULL) {
+        return SUCCES;
+    }
+
+    memset(&enregistrement, 0, sizeof(enregistrement));
+    enregistrement.operation = JOURNAL_SORTIE;
+    enregistrement.numeroPlace = vehicule->numeroPlace;
+    enregistrement.minutes = sortie.minutes;
+    enregistrement.montant = montant;
+    strcpy(enregistrement.plaque, vehicule->plaque);
+
+    return ajouterEnregistrement(parking, &enregistrement);
+}
+
+int journaliserEtatPlace(Parking *parking, int numeroPlace, EtatPlace etat)
+{
+    EnregistrementJournal enregistrement;
+
+    if (parking == NULL || parking->journal == NULL) {
+        return SUCCES;
+    }
+
+    memset(&enregistrement, 0, sizeof(enregistrement));
+    enregistrement.operation = JOURNAL_ETAT_PLACE;
+    enregistrement.numeroPlace = numeroPlace;
+    enregistrement.valeur = etat;
+
+    return ajouterEnregistrement(parking, &enregistrement);
+}
+
+/* ============================================================================
+ * REJEU AU DEMARRAGE
+ * ============================================================================ */
+
+/**
+ * @brief Applique une operation du journal au parking
+ * @param parking Pointeur vers le parking
+ * @param enregistrement Operation a rejouer
+ * @return 1 si l'operation est coherente avec l'etat du parking, 0 sinon
+ */
+static int rejouerEnregistrement(Parking *parking,
+                                 const EnregistrementJournal *enregistrement)
+{
+    Horodatage horodatage;
+    Vehicule *vehicule;
+    Place *place;
+
+    horodatage.minutes = enregistrement->minutes;
+
+    switch (enregistrement->operation) {
+        case JOURNAL_ENTREE:
+            place = obtenirPlaceParNumero(parking,
+                                          enregistrement->numeroPlace);
+            if (place == NULL || place->etat != LIBRE ||
+                rechercherVehicule(parking, enregistrement->plaque) != NULL) {
+                return 0;
+            }
+            return appliquerEntree(parking, enregistrement->plaque,
+                                   enregistrement->proprietaire,
+                                   (TypeVehicule)enregistrement->valeur,
+                                   enregistrement->numeroPlace,
+                                   horodatage) != -1;
+
+        case JOURNAL_SORTIE:
+            vehicule = rechercherVehicule(parking, enregistrement->plaque);
+            if (vehicule == NULL) {
+                return 0;
+            }
+            appliquerSortie(parking, vehicule, horodatage,
+                            enregistrement->montant);
+            return 1;
+
+        case JOURNAL_ETAT_PLACE:
+            return appliquerEtatPlace(parking, enregistrement->numeroPlace,
+                                      (EtatPlace)enregistrement->valeur);
+
+        default:
+            return 0;
+    }
+}
+
+int suivreJournal(Parking *parking, const char *fichier, long *position)
+{
+    FILE *flux;
+    EnregistrementJournal enregistrement;
+    long taille;
+    int appliquees;
+    int resultat;
+
+    if (parking == NULL || fichier == NULL || position == NULL) {
+        return ERREUR_PARAMETRE;
+    }
+
+    /* Pas encore de journal : rien a suivre */
+    flux = fopen(fichier, "rb");
+    if (flux == NULL) {
+        return 0;
+    }
+
+    /* Fichier raccourci : remplace par une compaction, relu depuis le debut */
+    if (fseek(flux, 0, SEEK_END) != 0 || (taille = ftell(flux)) < 0) {
+        fclose(flux);
+        return ERREUR_ENTREE_SORTIE;
+    }
+    if (taille < *position) {
+        *position = 0;
+    }
+    if (fseek(flux, *position, SEEK_SET) != 0) {
+        fclose(flux);
+        return ERREUR_ENTREE_SORTIE;
+    }
+
+    appliquees = 0;
+    resultat = 0;
+
+    /* Un enregistrement incomplet ou en cours d'ecriture attend l'appel
+     * suivant */
+    while (fread(&enregistrement, sizeof(enregistrement), 1, flux) == 1 &&
+           enregistrement.crc == crcEnregistrement(&enregistrement)) {
+        enregistrement.plaque[TAILLE_PLAQUE - 1] = '\0';
+        enregistrement.proprietaire[MAX_CHAINE - 1] = '\0';
+
+        if (enregistrement.sequence > parking->sequenceJournal) {
+            /* Operations manquantes : le journal ne prolonge plus l'etat */
+            if (enregistrement.sequence != parking->sequenceJournal + 1 ||
+                rejouerEnregistrement(parking, &enregistrement) == 0) {
+                resultat = ERREUR_FICHIER_INVALIDE;
+                break;
+            }
+            parking->sequenceJournal = enregistrement.sequence;
+            appliquees++;
+        }
+
+        *position += (long)sizeof(enregistrement);
+    }
+
+    fclose(flux);
+
+    return resultat != 0 ? resultat : appliquees;
+}
+
+/**
+ * @brief Indique si la suite du journal ne contient plus aucun
+ *        enregistrement valide
+ * @param flux Journal, positionne apres un enregistrement invalide
+ * @return 1 pour une fin dechiree (arret pendant les ecritures d'un groupe
+ *         non synchronise), 0 si un enregistrement valide suit
+ */
+static int finDechiree(FILE *flux)
+{
+    EnregistrementJournal enregistrement;
+
+    while (fread(&enregistrement, sizeof(enregistrement), 1, flux) == 1) {
+        if (enregistrement.crc == crcEnregistrement(&enregistrement)) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+int ouvrirJournal(Parking *parking, const char *fichier,
+                  int groupeSynchro, int delaiSynchroSecondes)
+{
+    FILE *flux;
+    JournalParking *journal;
+    EnregistrementJournal enregistrement;
+    long finValide;
+    uint32_t precedente;
+    int rejouees;
+    int incoherent;
+
+    if (parking == NULL || fichier == NULL) {
+        return ERREUR_PARAMETRE;
+    }
+
+    /* Un journal deja ouvert est remplace */
+    fermerJournal(parking);
+
+    flux = fopen(fichier, "r+b");
+    if (flux == NULL) {
+        flux = fopen(fichier, "w+b");
+    }
+    if (flux == NULL) {
+        return ERREUR_ENTREE_SORTIE;
+    }
+
+    /* Lecture sequentielle jusqu'a la fin ou au premier enregistrement
+     * invalide */
+    finValide = 0;
+    precedente = 0;
+    rejouees = 0;
+    incoherent = 0;
+
+    while (fread(&enregistrement, sizeof(enregistrement), 1, flux) == 1) {
+        /* CRC faux : seule une fin dechiree peut etre retiree */
+        if (enregistrement.crc != crcEnregistrement(&enregistrement)) {
+            incoherent = finDechiree(flux) == 0;
+            break;
+        }
+
+        /* Numeros non consecutifs dans le fichier, ou operations manquantes
+         * entre la sauvegarde et le journal (sauvegarde absente ou plus
+         * ancienne que la derniere compaction) */
+        if ((finValide > 0 && enregistrement.sequence != precedente + 1) ||
+            (enregistrement.sequence > parking->sequenceJournal &&
+             enregistrement.sequence != parking->sequenceJournal + 1)) {
+            incoherent = 1;
+            break;
+        }
+
+        enregistrement.plaque[TAILLE_PLAQUE - 1] = '\0';
+        enregistrement.proprietaire[MAX_CHAINE - 1] = '\0';
+
+        /* Operations posterieures a la sauvegarde : rejouees dans l'ordre */
+        if (enregistrement.sequence > parking->sequenceJournal) {
+            if (rejouerEnregistrement(parking, &enregistrement) == 0) {
+                incoherent = 1;
+                break;
+            }
+            parking->sequenceJournal = enregistrement.sequence;
+            rejouees++;
+        }
+
+        precedente = enregistrement.sequence;
+        finValide += (long)sizeof(enregistrement);
+    }
+
+    /* Journal qui ne prolonge pas la sauvegarde : laisse intact, sans
+     * ajouts, les operations qu'il porte restant a recuperer */
+    if (incoherent) {
+        fclose(flux);
+        return ERREUR_FICHIER_INVALIDE;
+    }
+
+    /* Seule une fin dechiree (incomplete ou illisible jusqu'au bout du
+     * fichier) est retiree avant les ajouts */
+    if (fflush(flux) != 0 ||
+#ifdef _WIN32
+        _chsize(_fileno(flux), finValide) != 0 ||
+#else
+        ftruncate(fileno(flux), (off_t)finValide) != 0 ||
+#endif
+        fseek(flux, finValide, SEEK_SET) != 0) {
+        fclose(flux);
+        return ERREUR_ENTREE_SORTIE;
+    }
+
+    journal = (JournalParking*)calloc(1, sizeof(JournalParking));
+    if (journal == NULL) {
+        fclose(flux);
+        return ERREUR_MEMOIRE;
+    }
+
+    strncpy(journal->fichier, fichier, MAX_CHEMIN - 1);
+    journal->fichier[MAX_CHEMIN - 1] = '\0';
+    journal->flux = flux;
+    journal->groupeSynchro = groupeSynchro > 0 ? groupeSynchro : 1;
+    journal->delaiSynchroSecondes = delaiSynchroSecondes;
+    journal->enAttente = 0;
+    journal->derniereSynchro = (long)time(NULL);
+    journal->finValide = finValide;
+    parking->journal = journal;
+
+    return rejouees;
+}
@@ -9,6 +9,7 @@
 #include <string.h>
 #include "../include/menu.h"
 #include "../include/utilitaires.h"
+#include "../include/rendu.h"
 #include "../include/prototypes.h"
 
 /* ============================================================================
@@ -19,20 +20,24 @@ int afficherMenuPrincipal(void)
 {
     int choix;
     
-    printf("\n");
-    afficherLigne('=', 50);
-    printf("     SYSTEME DE GESTION DE PARKING\n");
-    afficherLigne('=', 50);
-    printf("\n");
-    printf("  1. Gestion des vehicules\n");
-    printf("  2. Gestion des places\n");
-    printf("  3. Statistiques et rapports\n");
-    printf("  4. Afficher la carte du parking\n");
-    printf("  5. Sauvegarder les donnees\n");
-    printf("  6. Charger les donnees\n");
-    printf("  0. Quitter\n");
-    printf("\n");
-    afficherLigne('-', 50);
+    commencerRendu();
+    
+    rendreTexte("\n");
+    rendreLigne('=', 50);
+    rendreTexte("     SYSTEME DE GESTION DE PARKING\n");
+    rendreLigne('=', 50);
+    rendreTexte("\n");
+    rendreTexte("  1. Gestion des vehicules\n");
+    rendreTexte("  2. Gestion des places\n");
+    rendreTexte("  3. Statistiques et rapports\n");
+    rendreTexte("  4. Afficher la carte du parking\n");
+    rendreTexte("  5. Sauvegarder les donnees\n");
+    rendreTexte("  6. Charger les donnees\n");
+    rendreTexte("  0. Quitter\n");
+    rendreTexte("\n");
+    rendreLigne('-', 50);
+    
+    terminerRendu();
     
     choix = lireEntier(0, 6);
     
@@ -43,18 +48,22 @@ int afficherMenuVehicules(void)
 {
     int choix;
     
-    printf("\n");
-    afficherLigne('=', 50);
-    printf("     GESTION DES VEHICULES\n");
-    afficherLigne('=', 50);
-    printf("\n");
-    printf("  1. Enregistrer une entree\n");
-    printf("  2. Enregistrer une sortie\n");
-    printf("  3. Rechercher un vehicule\n");
-    printf("  4. Afficher les vehicules presents\n");
-    printf("  0. Retour au menu principal\n");
-    printf("\n");
-    afficherLigne('-', 50);
+    commencerRendu();
+    
+    rendreTexte("\n");
+    rendreLigne('=', 50);
+    rendreTexte("     GESTION DES VEHICULES\n");
+    rendreLigne('=', 50);
+    rendreTexte("\n");
+    rendreTexte("  1. Enregistrer une entree\n");
+    rendreTexte("  2. Enregistrer une sortie\n");
+    rendreTexte("  3. Rechercher un vehicule\n");
+    rendreTexte("  4. Afficher les vehicules presents\n");
+    rendreTexte("  0. Retour au menu principal\n");
+    rendreTexte("\n");
+    rendreLigne('-', 50);
+    
+    terminerRendu();
     
     choix = lireEntier(0, 4);
     
@@ -65,20 +74,26 @@ int afficherMenuStatistiques(void)
 {
     int choix;
     
-    printf("\n");
-    afficherLigne('=', 50);
-    printf("     STATISTIQUES ET RAPPORTS\n");
-    afficherLigne('=', 50);
-    printf("\n");
-    printf("  1. Resume journalier\n");
-    printf("  2. Rapport complet\n");
-    printf("  3. Historique des vehicules\n");
-    printf("  4. Recettes par type de vehicule\n");
-    printf("  0. Retour au menu principal\n");
-    printf("\n");
-    afficherLigne('-', 50);
+    commencerRendu();
+    
+    rendreTexte("\n");
+    rendreLigne('=', 50);
+    rendreTexte("     STATISTIQUES ET RAPPORTS\n");
+    rendreLigne('=', 50);
+    rendreTexte("\n");
+    rendreTexte("  1. Resume journalier\n");
+    rendreTexte("  2. Rapport complet\n");
+    rendreTexte("  3. Historique des vehicules\n");
+    rendreTexte("  4. Recettes par type de vehicule\n");
+    rendreTexte("  5. Latences et erreurs des operations\n");
+    rendreTexte("  6. Historique trie (plaque, entree, montant)\n");
+    rendreTexte("  0. Retour au menu principal\n");
+    rendreTexte("\n");
+    rendreLigne('-', 50);
+    
+    terminerRendu();
     
-    choix = lireEntier(0, 4);
+    choix = lireEntier(0, 6);
     
     return choix;
 }
@@ -87,18 +102,22 @@ int afficherMenuPlaces(void)
 {
     int choix;
     
-    printf("\n");
-    afficherLigne('=', 50);
-    printf("     GESTION DES PLACES\n");
-    afficherLigne('=', 50);
-    printf("\n");
-    printf("  1. Afficher l'etat des places\n");
-    printf("  2. Mettre une place hors service\n");
-    printf("  3. Remettre une place en service\n");
-    printf("  4. Reserver une place\n");
-    printf("  0. Retour au menu principal\n");
-    printf("\n");
-    afficherLigne('-', 50);
+    commencerRendu();
+    
+    rendreTexte("\n");
+    rendreLigne('=', 50);
+    rendreTexte("     GESTION DES PLACES\n");
+    rendreLigne('=', 50);
+    rendreTexte("\n");
+    rendreTexte("  1. Afficher l'etat des places\n");
+    rendreTexte("  2. Mettre une place hors service\n");
+    rendreTexte("  3. Remettre une place en service\n");
+    rendreTexte("  4. Reserver une place\n");
+    rendreTexte("  0. Retour au menu principal\n");
+    rendreTexte("\n");
+    rendreLigne('-', 50);
+    
+    terminerRendu();
     
     choix = lireEntier(0, 4);
     
@@ -117,11 +136,15 @@ TypeVehicule saisirTypeVehicule(void)
 {
     int choix;
     
-    printf("\nType de vehicule :\n");
-    printf("  1. Voiture\n");
-    printf("  2. Moto\n");
-    printf("  3. Camion\n");
-    printf("  4. Bus\n");
+    commencerRendu();
+    
+    rendreTexte("\nType de vehicule :\n");
+    rendreTexte("  1. Voiture\n");
+    rendreTexte("  2. Moto\n");
+    rendreTexte("  3. Camion\n");
+    rendreTexte("  4. Bus\n");
+    
+    terminerRendu();
     
     choix = lireEntier(1, 4);
     
@@ -144,27 +167,33 @@ void afficherTicketSortie(const Parking *parking, const Vehicule *vehicule,
         return;
     }
     
-    sortie = obtenirHorodatageActuel();
+    /* Heure de sortie enregistree, sinon heure courante */
+    sortie = vehicule->estPresent == 0 ? vehicule->sortie :
+                                         obtenirHorodatageActuel();
     formaterHorodatage(vehicule->entree, bufferEntree);
     formaterHorodatage(sortie, bufferSortie);
     duree = calculerDureeMinutes(vehicule->entree, sortie);
     
-    printf("\n");
-    afficherLigne('*', 45);
-    printf("*          TICKET DE SORTIE               *\n");
-    afficherLigne('*', 45);
-    printf("  Parking       : %s\n", parking->nom);
-    printf("  Plaque        : %s\n", vehicule->plaque);
-    printf("  Proprietaire  : %s\n", vehicule->proprietaire);
-    printf("  Type          : %s\n", typeVehiculeEnChaine(vehicule->type));
-    afficherLigne('-', 45);
-    printf("  Entree        : %s\n", bufferEntree);
-    printf("  Sortie        : %s\n", bufferSortie);
-    printf("  Duree         : %d h %02d min\n", duree / 60, duree % 60);
-    afficherLigne('-', 45);
-    printf("  MONTANT A PAYER : %.2f FCFA\n", montant);
-    afficherLigne('*', 45);
-    printf("       Merci de votre visite !\n");
-    afficherLigne('*', 45);
-    printf("\n");
+    commencerRendu();
+    
+    rendreTexte("\n");
+    rendreLigne('*', 45);
+    rendreTexte("*          TICKET DE SORTIE               *\n");
+    rendreLigne('*', 45);
+    rendreTexte("  Parking       : %s\n", parking->nom);
+    rendreTexte("  Plaque        : %s\n", vehicule->plaque);
+    rendreTexte("  Proprietaire  : %s\n", vehicule->proprietaire);
+    rendreTexte("  Type          : %s\n", typeVehiculeEnChaine(vehicule->type));
+    rendreLigne('-', 45);
+    rendreTexte("  Entree        : %s\n", bufferEntree);
+    rendreTexte("  Sortie        : %s\n", bufferSortie);
+    rendreTexte("  Duree         : %d h %02d min\n", duree / 60, duree % 60);
+    rendreLigne('-', 45);
+    rendreTexte("  MONTANT A PAYER : %.2f FCFA\n", montant);
+    rendreLigne('*', 45);
+    rendreTexte("       Merci de votre visite !\n");
+    rendreLigne('*', 45);
+    rendreTexte("\n");
+    
+    terminerRendu();
 }
@@ -56,10 +56,13 @@ void traiterEntreeVehicule(Parking *parking)
     /* Enregistrement de l'entree */
     numeroPlace = enregistrerEntree(parking, plaque, proprietaire, type);
     
-    if (numeroPlace != -1) {
-        printf("\nVehicule enregistre avec succes !\n");
-        afficherTicketEntree(parking, plaque, numeroPlace);
+    if (numeroPlace < 0) {
+        printf("Erreur : %s\n", messageErreur(numeroPlace));
+        return;
     }
+    
+    printf("\nVehicule enregistre avec succes !\n");
+    afficherTicketEntree(parking, plaque, numeroPlace);
 }
 
 /* ============================================================================
@@ -70,6 +73,7 @@ void traiterSortieVehicule(Parking *parking)
 {
     char plaque[TAILLE_PLAQUE];
     float montant;
+    int resultat;
     Vehicule *vehicule;
     Vehicule copieVehicule;
     
@@ -88,7 +92,7 @@ void traiterSortieVehicule(Parking *parking)
         return;
     }
     
-    /* Recherche du vehicule pour copier ses infos avant la sortie */
+    /* Recherche du vehicule : son enregistrement ne bouge pas a la sortie */
     vehicule = rechercherVehicule(parking, plaque);
     
     if (vehicule == NULL) {
@@ -96,15 +100,17 @@ void traiterSortieVehicule(Parking *parking)
         return;
     }
     
-    /* Copie des informations pour le ticket */
-    copieVehicule = *vehicule;
-    
     /* Enregistrement de la sortie */
-    montant = enregistrerSortie(parking, plaque);
+    resultat = enregistrerSortie(parking, plaque, &montant);
     
-    if (montant >= 0) {
-        afficherTicketSortie(parking, &copieVehicule, montant);
+    if (resultat != SUCCES) {
+        printf("Erreur : %s\n", messageErreur(resultat));
+        return;
     }
+    
+    /* Copie des informations, heure de sortie comprise, pour le ticket */
+    copieVehicule = *vehicule;
+    afficherTicketSortie(parking, &copieVehicule, montant);
 }
 
 /* ============================================================================
@@ -154,8 +160,8 @@ void traiterRechercheVehicule(Parking *parking)
     formaterHorodatage(vehicule->entree, buffer);
     printf("Heure entree   : %s\n", buffer);
     
-    numeroPlace = rechercherPlaceParVehicule(parking, plaque);
-    if (numeroPlace != -1) {
+    numeroPlace = vehicule->numeroPlace;
+    if (numeroPlace >= 1) {
         printf("Place          : %d\n", numeroPlace);
     }
     
@@ -170,6 +176,7 @@ void traiterRechercheVehicule(Parking *parking)
 void traiterModificationPlace(Parking *parking, EtatPlace nouvelEtat)
 {
     int numeroPlace;
+    int resultat;
     
     if (parking == NULL) {
         return;
@@ -178,7 +185,11 @@ void traiterModificationPlace(Parking *parking, EtatPlace nouvelEtat)
     printf("Numero de la place (1-%d) : ", parking->nombrePlaces);
     numeroPlace = lireEntier(1, parking->nombrePlaces);
     
-    if (modifierEtatPlace(parking, numeroPlace, nouvelEtat)) {
+    resultat = modifierEtatPlace(parking, numeroPlace, nouvelEtat);
+    
+    if (resultat == SUCCES) {
         printf("Place %d modifiee avec succes.\n", numeroPlace);
+    } else {
+        printf("Erreur : %s\n", messageErreur(resultat));
     }
 }
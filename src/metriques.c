@@ -0,0 +1,245 @@
+/**
+ * @file metriques.c
+ * @brief Implementation de l'export des metriques (format texte Prometheus)
+ * @date Decembre 2025
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../include/metriques.h"
+#include "../include/instrumentation.h"
+
+/** Noms des types de vehicule dans les etiquettes, indices par type */
+static const char *etiquettesTypes[5] = {
+    "inconnu", "voiture", "moto", "camion", "bus"
+};
+
+/* Export periodique : fichier, intervalle et date du dernier export */
+static char fichierMetriques[MAX_CHEMIN] = "";
+static int intervalleMetriques = 0;
+static long dernierExport = 0;
+
+/* ============================================================================
+ * ECRITURE
+ * ============================================================================ */
+
+/**
+ * @brief Ecrit l'en-tete HELP/TYPE d'une metrique
+ * @param flux Flux de destination
+ * @param nom Nom de la metrique
+ * @param type gauge, counter ou summary
+ * @param aide Description
+ */
+static void ecrireEnteteMetrique(FILE *flux, const char *nom,
+                                 const char *type, const char *aide)
+{
+    fprintf(flux, "# HELP %s %s\n# TYPE %s %s\n", nom, aide, nom, type);
+}
+
+/**
+ * @brief Ecrit une metrique par type de vehicule
+ * @param flux Flux de destination
+ * @param nom Nom de la metrique
+ * @param type gauge ou counter
+ * @param aide Description
+ * @param valeurs Valeurs indicees par type (VOITURE a BUS)
+ */
+static void ecrireParType(FILE *flux, const char *nom, const char *type,
+                          const char *aide, const int valeurs[5])
+{
+    int t;
+
+    ecrireEnteteMetrique(flux, nom, type, aide);
+    for (t = VOITURE; t <= BUS; t++) {
+        fprintf(flux, "%s{type=\"%s\"} %d\n", nom, etiquettesTypes[t],
+                valeurs[t]);
+    }
+}
+
+/**
+ * @brief Ecrit les latences et les codes de retour des operations
+ * @param flux Flux de destination
+ */
+static void ecrireOperations(FILE *flux)
+{
+    ResumeMesure resumes[NOMBRE_MESURES];
+    const char *nom;
+    int operation;
+    int code;
+
+    for (operation = 0; operation < NOMBRE_MESURES; operation++) {
+        resumerMesure((OperationMesuree)operation, &resumes[operation]);
+    }
+
+    ecrireEnteteMetrique(flux, "parking_operation_duree_secondes", "summary",
+                         "Duree des operations du coeur.");
+    for (operation = 0; operation < NOMBRE_MESURES; operation++) {
+        nom = nomMesure((OperationMesuree)operation);
+        if (resumes[operation].chronometrees == 0) {
+            /* Quantiles sans observation : NaN, comme les clients officiels */
+            fprintf(flux,
+                    "parking_operation_duree_secondes{operation=\"%s\","
+                    "quantile=\"0.5\"} NaN\n"
+                    "parking_operation_duree_secondes{operation=\"%s\","
+                    "quantile=\"0.9\"} NaN\n"
+                    "parking_operation_duree_secondes{operation=\"%s\","
+                    "quantile=\"0.99\"} NaN\n",
+                    nom, nom, nom);
+        } else {
+            fprintf(flux,
+                    "parking_operation_duree_secondes{operation=\"%s\","
+                    "quantile=\"0.5\"} %.9f\n"
+                    "parking_operation_duree_secondes{operation=\"%s\","
+                    "quantile=\"0.9\"} %.9f\n"
+                    "parking_operation_duree_secondes{operation=\"%s\","
+                    "quantile=\"0.99\"} %.9f\n",
+                    nom, resumes[operation].p50 / 1e9,
+                    nom, resumes[operation].p90 / 1e9,
+                    nom, resumes[operation].p99 / 1e9);
+        }
+        fprintf(flux,
+                "parking_operation_duree_secondes_sum{operation=\"%s\"} "
+                "%.9f\n"
+                "parking_operation_duree_secondes_count{operation=\"%s\"} "
+                "%lld\n",
+                nom, resumes[operation].moyenne *
+                     resumes[operation].chronometrees / 1e9,
+                nom, resumes[operation].chronometrees);
+    }
+
+    ecrireEnteteMetrique(flux, "parking_operation_duree_max_secondes",
+                         "gauge", "Plus longue duree de chaque operation.");
+    for (operation = 0; operation < NOMBRE_MESURES; operation++) {
+        fprintf(flux, "parking_operation_duree_max_secondes"
+                "{operation=\"%s\"} %.9f\n",
+                nomMesure((OperationMesuree)operation),
+                resumes[operation].maximum / 1e9);
+    }
+
+    ecrireEnteteMetrique(flux, "parking_operation_retours_total", "counter",
+                         "Appels des operations par code de retour.");
+    for (operation = 0; operation < NOMBRE_MESURES; operation++) {
+        for (code = 0; code < CODES_MESURES; code++) {
+            /* Succes toujours present, echecs des qu'ils apparaissent */
+            if (code == 0 || resumes[operation].retours[code] > 0) {
+                fprintf(flux, "parking_operation_retours_total"
+                        "{operation=\"%s\",code=\"%s\"} %lld\n",
+                        nomMesure((OperationMesuree)operation),
+                        nomCodeMesure(-code),
+                        resumes[operation].retours[code]);
+            }
+        }
+    }
+}
+
+int ecrireMetriques(const Parking *parking, const char *nomFichier)
+{
+    char nomTemporaire[MAX_CHEMIN + 8];
+    const AgregatsParking *agregats;
+    FILE *flux;
+    int resultat;
+
+    if (parking == NULL || nomFichier == NULL ||
+        strlen(nomFichier) >= MAX_CHEMIN) {
+        return ERREUR_PARAMETRE;
+    }
+
+    /* Ecriture a cote puis renommage : le collecteur lit un export entier */
+    sprintf(nomTemporaire, "%s.tmp", nomFichier);
+    flux = fopen(nomTemporaire, "w");
+    if (flux == NULL) {
+        return ERREUR_ENTREE_SORTIE;
+    }
+
+    agregats = &parking->agregats;
+
+    ecrireEnteteMetrique(flux, "parking_places", "gauge",
+                         "Nombre de places du parking.");
+    fprintf(flux, "parking_places %d\n", parking->nombrePlaces);
+    ecrireEnteteMetrique(flux, "parking_places_libres", "gauge",
+                         "Places libres.");
+    fprintf(flux, "parking_places_libres %d\n", parking->placesLibres);
+    ecrireEnteteMetrique(flux, "parking_places_occupees", "gauge",
+                         "Places occupees.");
+    fprintf(flux, "parking_places_occupees %d\n", parking->placesOccupees);
+
+    ecrireParType(flux, "parking_places_libres_par_type", "gauge",
+                  "Places libres par type de place.",
+                  parking->placesLibresParType);
+    ecrireParType(flux, "parking_vehicules_presents", "gauge",
+                  "Vehicules presents par type.", agregats->presentsParType);
+    ecrireParType(flux, "parking_entrees_total", "counter",
+                  "Entrees enregistrees par type.", agregats->entreesParType);
+    ecrireParType(flux, "parking_sorties_total", "counter",
+                  "Sorties enregistrees par type.", agregats->sortiesParType);
+
+    ecrireEnteteMetrique(flux, "parking_recette_journaliere", "gauge",
+                         "Recette du jour (FCFA).");
+    fprintf(flux, "parking_recette_journaliere %.2f\n",
+            parking->recetteJournaliere);
+    ecrireEnteteMetrique(flux, "parking_recette_totale", "gauge",
+                         "Recette cumulee (FCFA).");
+    fprintf(flux, "parking_recette_totale %.2f\n", parking->recetteTotale);
+
+    ecrireOperations(flux);
+
+    resultat = ferror(flux) ? ERREUR_ENTREE_SORTIE : SUCCES;
+    if (fclose(flux) != 0) {
+        resultat = ERREUR_ENTREE_SORTIE;
+    }
+
+    if (resultat != SUCCES || rename(nomTemporaire, nomFichier) != 0) {
+        remove(nomTemporaire);
+        return ERREUR_ENTREE_SORTIE;
+    }
+
+    return SUCCES;
+}
+
+/* ============================================================================
+ * EXPORT PERIODIQUE
+ * ============================================================================ */
+
+void configurerExportMetriques(const char *nomFichier,
+                               int intervalleSecondes)
+{
+    if (nomFichier == NULL || strlen(nomFichier) >= MAX_CHEMIN) {
+        fichierMetriques[0] = '\0';
+        return;
+    }
+
+    strcpy(fichierMetriques, nomFichier);
+    intervalleMetriques = intervalleSecondes;
+    dernierExport = 0;
+}
+
+int exporterMetriquesSiEcheance(const Parking *parking)
+{
+    long maintenant;
+
+    if (intervalleMetriques <= 0 || fichierMetriques[0] == '\0') {
+        return SUCCES;
+    }
+
+    maintenant = (long)time(NULL);
+    if (maintenant - dernierExport < intervalleMetriques) {
+        return SUCCES;
+    }
+
+    dernierExport = maintenant;
+
+    return ecrireMetriques(parking, fichierMetriques);
+}
+
+int exporterMetriques(const Parking *parking)
+{
+    if (fichierMetriques[0] == '\0') {
+        return SUCCES;
+    }
+
+    dernierExport = (long)time(NULL);
+
+    return ecrireMetriques(parking, fichierMetriques);
+}
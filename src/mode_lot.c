@@ -0,0 +1,792 @@
+/**
+ * @file mode_lot.c
+ * @brief Implementation du mode par lot (commandes non interactives)
+ * @date Decembre 2025
+ *
+ * Les commandes des bornes d'entree et de sortie arrivent par un
+ * fichier ou l'entree standard. Elles sont executees directement, sans
+ * menu ni saisie, et les reponses sont ecrites dans un flux tamponne.
+ * En mode concurrent, chaque voie a ses flux et son thread ; les
+ * commandes passent par le moteur concurrent au lieu du parking.
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "../include/mode_lot.h"
+#include "../include/parking.h"
+#include "../include/utilitaires.h"
+#include "../include/persistance.h"
+#include "../include/metriques.h"
+#include "../include/tarification.h"
+#include "../include/trace.h"
+#include "../include/prototypes.h"
+
+/** Commandes entre deux archivages de l'historique */
+#define COMMANDES_PAR_ENTRETIEN 4096
+
+/** Intervalle de mise a l'heure et de fusion des voies concurrentes */
+#define PERIODE_HORLOGE_VOIES_MS 50
+
+/* ============================================================================
+ * LECTURE DES CHAMPS
+ * ============================================================================ */
+
+/** Noms des types de vehicule dans les commandes et les reponses */
+static const char *nomsTypesLot[] = { "VOITURE", "MOTO", "CAMION", "BUS" };
+
+const char* nomTypeLot(int type)
+{
+    if (type < VOITURE || type > BUS) {
+        return "?";
+    }
+
+    return nomsTypesLot[type - VOITURE];
+}
+
+/**
+ * @brief Convertit un type de vehicule (nom ou numero)
+ * @param champ Champ lu (VOITURE, MOTO, CAMION, BUS ou 1 a 4)
+ * @return Type correspondant, 0 si invalide
+ */
+static int lireTypeLot(const char *champ)
+{
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        if (strcmp(champ, nomsTypesLot[i]) == 0) {
+            return VOITURE + i;
+        }
+    }
+
+    if (champ[0] >= '1' && champ[0] <= '4' && champ[1] == '\0') {
+        return champ[0] - '0';
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Convertit un etat de place (nom ou numero)
+ * @param champ Champ lu (LIBRE, OCCUPEE, RESERVEE, HORS_SERVICE ou 0 a 3)
+ * @return Etat correspondant, -1 si invalide
+ */
+static int lireEtatLot(const char *champ)
+{
+    static const char *noms[] = { "LIBRE", "OCCUPEE", "RESERVEE",
+                                  "HORS_SERVICE" };
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        if (strcmp(champ, noms[i]) == 0) {
+            return LIBRE + i;
+        }
+    }
+
+    if (champ[0] >= '0' && champ[0] <= '3' && champ[1] == '\0') {
+        return champ[0] - '0';
+    }
+
+    return -1;
+}
+
+/* ============================================================================
+ * ANALYSE DES COMMANDES
+ * ============================================================================ */
+
+int analyserCommandeLot(const char *ligne, long numeroLigne,
+                        CommandeLot *commande, FILE *sortie, BilanLot *bilan)
+{
+    char champ[TAILLE_LIGNE_LOT];
+
+    if (sscanf(ligne, "%15s", commande->nom) != 1 ||
+        commande->nom[0] == '#') {
+        return -1;
+    }
+
+    bilan->commandes++;
+
+    if (strcmp(commande->nom, "ENTRY") == 0) {
+        commande->nature = COMMANDE_ENTREE;
+        bilan->entrees++;
+        if (sscanf(ligne, "%*s %255s %255s %255s", commande->plaque,
+                   commande->proprietaire, champ) != 3 ||
+            strlen(commande->plaque) >= TAILLE_PLAQUE ||
+            (commande->type = lireTypeLot(champ)) == 0) {
+            fprintf(sortie, "ERR %ld syntaxe : ENTRY plaque proprietaire "
+                    "type\n", numeroLigne);
+            return 0;
+        }
+        return 1;
+    }
+
+    if (strcmp(commande->nom, "EXIT") == 0) {
+        commande->nature = COMMANDE_SORTIE;
+        bilan->sorties++;
+        if (sscanf(ligne, "%*s %255s", commande->plaque) != 1) {
+            fprintf(sortie, "ERR %ld syntaxe : EXIT plaque\n", numeroLigne);
+            return 0;
+        }
+        return 1;
+    }
+
+    if (strcmp(commande->nom, "PLACE") == 0) {
+        commande->nature = COMMANDE_PLACE;
+        bilan->changementsEtat++;
+        if (sscanf(ligne, "%*s %d %255s", &commande->numero, champ) != 2 ||
+            (commande->etat = lireEtatLot(champ)) == -1 ||
+            commande->etat == OCCUPEE) {
+            fprintf(sortie, "ERR %ld syntaxe : PLACE numero etat\n",
+                    numeroLigne);
+            return 0;
+        }
+        return 1;
+    }
+
+    if (strcmp(commande->nom, "REPORT") == 0) {
+        commande->nature = COMMANDE_RAPPORT;
+        bilan->rapports++;
+        return 1;
+    }
+
+    if (strcmp(commande->nom, "LOOKUP") == 0) {
+        commande->nature = COMMANDE_CONSULTATION;
+        bilan->consultations++;
+        if (sscanf(ligne, "%*s %255s", commande->plaque) != 1) {
+            fprintf(sortie, "ERR %ld syntaxe : LOOKUP plaque\n", numeroLigne);
+            return 0;
+        }
+        return 1;
+    }
+
+    if (strcmp(commande->nom, "AVAIL") == 0) {
+        commande->nature = COMMANDE_DISPONIBILITE;
+        bilan->consultations++;
+        commande->type = 0;
+        if (sscanf(ligne, "%*s %255s", champ) == 1 &&
+            (commande->type = lireTypeLot(champ)) == 0) {
+            fprintf(sortie, "ERR %ld syntaxe : AVAIL [type]\n", numeroLigne);
+            return 0;
+        }
+        return 1;
+    }
+
+    if (strcmp(commande->nom, "CLOCK") == 0) {
+        commande->nature = COMMANDE_HORLOGE;
+        if (sscanf(ligne, "%*s %d", &commande->numero) != 1 ||
+            commande->numero < 0) {
+            fprintf(sortie, "ERR %ld syntaxe : CLOCK minutes\n", numeroLigne);
+            return 0;
+        }
+        return 1;
+    }
+
+    fprintf(sortie, "ERR %ld commande inconnue %s\n", numeroLigne,
+            commande->nom);
+    return 0;
+}
+
+int lireLigneLot(FILE *entree, char *ligne, int taille)
+{
+    size_t longueur;
+    int caractere;
+
+    if (fgets(ligne, taille, entree) == NULL) {
+        return 0;
+    }
+
+    longueur = strlen(ligne);
+
+    if (longueur > 0 && ligne[longueur - 1] == '\n') {
+        ligne[--longueur] = '\0';
+        if (longueur > 0 && ligne[longueur - 1] == '\r') {
+            ligne[--longueur] = '\0';
+        }
+        return 1;
+    }
+
+    /* Derniere ligne sans fin de ligne */
+    if (feof(entree)) {
+        return 1;
+    }
+
+    do {
+        caractere = getc(entree);
+    } while (caractere != '\n' && caractere != EOF);
+
+    return -1;
+}
+
+/* ============================================================================
+ * REPONSES
+ * ============================================================================ */
+
+/**
+ * @brief Ecrit les compteurs du parking sur une ligne
+ * @param sortie Flux des reponses
+ * @param libres Places libres
+ * @param occupees Places occupees
+ * @param presents Vehicules presents
+ * @param entrees Entrees cumulees
+ * @param sorties Sorties cumulees
+ * @param recettes Recette totale
+ */
+static void ecrireRapportLot(FILE *sortie, int libres, int occupees,
+                             int presents, long entrees, long sorties,
+                             double recettes)
+{
+    fprintf(sortie, "OK libres=%d occupees=%d presents=%d entrees=%ld "
+            "sorties=%ld recettes=%.2f\n",
+            libres, occupees, presents, entrees, sorties, recettes);
+}
+
+/**
+ * @brief Repond a une entree
+ * @param sortie Flux des reponses
+ * @param numeroLigne Numero de la ligne
+ * @param commande Commande executee
+ * @param numero Place attribuee ou code d'erreur
+ * @return 1 si l'entree a reussi, 0 sinon
+ */
+static int repondreEntree(FILE *sortie, long numeroLigne,
+                          const CommandeLot *commande, int numero)
+{
+    if (numero < 0) {
+        fprintf(sortie, "ERR %ld %s %s\n", numeroLigne, commande->plaque,
+                messageErreur(numero));
+        return 0;
+    }
+
+    fprintf(sortie, "OK %d\n", numero);
+    return 1;
+}
+
+/**
+ * @brief Repond a une sortie
+ * @param sortie Flux des reponses
+ * @param numeroLigne Numero de la ligne
+ * @param commande Commande executee
+ * @param resultat Code de retour de la sortie
+ * @param montant Montant a payer
+ * @return 1 si la sortie a reussi, 0 sinon
+ */
+static int repondreSortie(FILE *sortie, long numeroLigne,
+                          const CommandeLot *commande, int resultat,
+                          float montant)
+{
+    if (resultat != SUCCES) {
+        fprintf(sortie, "ERR %ld %s %s\n", numeroLigne, commande->plaque,
+                messageErreur(resultat));
+        return 0;
+    }
+
+    fprintf(sortie, "OK %.2f\n", montant);
+    return 1;
+}
+
+/**
+ * @brief Repond a un changement d'etat de place
+ * @param sortie Flux des reponses
+ * @param numeroLigne Numero de la ligne
+ * @param commande Commande executee
+ * @param resultat Code de retour du changement
+ * @return 1 si le changement a reussi, 0 sinon
+ */
+static int repondrePlace(FILE *sortie, long numeroLigne,
+                         const CommandeLot *commande, int resultat)
+{
+    if (resultat != SUCCES) {
+        fprintf(sortie, "ERR %ld place %d %s\n", numeroLigne,
+                commande->numero, messageErreur(resultat));
+        return 0;
+    }
+
+    fprintf(sortie, "OK\n");
+    return 1;
+}
+
+/**
+ * @brief Repond a une consultation : place, type, duree et montant du
+ *        stationnement en cours
+ * @param parking Pointeur vers le parking
+ * @param sortie Flux des reponses
+ * @param numeroLigne Numero de la ligne
+ * @param commande Commande executee
+ * @return 1 si le vehicule est present, 0 sinon
+ */
+static int repondreConsultation(Parking *parking, FILE *sortie,
+                                long numeroLigne, const CommandeLot *commande)
+{
+    const Vehicule *vehicule;
+    int duree;
+
+    vehicule = rechercherVehicule(parking, commande->plaque);
+    if (vehicule == NULL) {
+        fprintf(sortie, "ERR %ld %s %s\n", numeroLigne, commande->plaque,
+                messageErreur(ERREUR_VEHICULE_ABSENT));
+        return 0;
+    }
+
+    duree = calculerDureeMinutes(vehicule->entree, obtenirHorodatageActuel());
+    fprintf(sortie, "OK %d %s %d %.2f\n", vehicule->numeroPlace,
+            nomsTypesLot[vehicule->type - VOITURE], duree,
+            calculerMontantSejour(vehicule->entree, duree, vehicule->type));
+
+    return 1;
+}
+
+/**
+ * @brief Repond a une demande de disponibilite
+ * @param parking Pointeur vers le parking
+ * @param sortie Flux des reponses
+ * @param commande Commande executee (type 0 : tous les types)
+ *
+ * Pour un type, les places ou ce vehicule peut stationner (une moto
+ * aussi sur les places voiture et camion, comme rechercherPlaceLibre).
+ */
+static void repondreDisponibilite(const Parking *parking, FILE *sortie,
+                                  const CommandeLot *commande)
+{
+    int libres;
+
+    if (commande->type == 0) {
+        fprintf(sortie, "OK voiture=%d moto=%d camion=%d bus=%d\n",
+                compterPlacesLibresParType(parking, VOITURE),
+                compterPlacesLibresParType(parking, MOTO),
+                compterPlacesLibresParType(parking, CAMION),
+                compterPlacesLibresParType(parking, BUS));
+        return;
+    }
+
+    libres = compterPlacesLibresParType(parking,
+                                        (TypeVehicule)commande->type);
+    if (commande->type == MOTO) {
+        libres += compterPlacesLibresParType(parking, VOITURE) +
+                  compterPlacesLibresParType(parking, CAMION);
+    }
+
+    fprintf(sortie, "OK %d\n", libres);
+}
+
+/* ============================================================================
+ * EXECUTION DES COMMANDES
+ * ============================================================================ */
+
+int executerCommandeLot(Parking *parking, const char *ligne,
+                        long numeroLigne, FILE *sortie, BilanLot *bilan,
+                        int exploitation)
+{
+    CommandeLot commande;
+    int presents;
+    int resultat;
+    int t;
+    float montant;
+
+    resultat = analyserCommandeLot(ligne, numeroLigne, &commande, sortie,
+                                   bilan);
+    if (resultat != 1) {
+        return resultat;
+    }
+
+    /* L'horloge et l'etat des places restent a l'exploitant */
+    if (exploitation == 0 && (commande.nature == COMMANDE_HORLOGE ||
+                              commande.nature == COMMANDE_PLACE)) {
+        fprintf(sortie, "ERR %ld %s reservee a l'exploitant\n", numeroLigne,
+                commande.nom);
+        return 0;
+    }
+
+    switch (commande.nature) {
+        case COMMANDE_ENTREE:
+            return repondreEntree(sortie, numeroLigne, &commande,
+                                  enregistrerEntree(parking, commande.plaque,
+                                      commande.proprietaire,
+                                      (TypeVehicule)commande.type));
+
+        case COMMANDE_SORTIE:
+            montant = 0.0f;
+            resultat = enregistrerSortie(parking, commande.plaque, &montant);
+            return repondreSortie(sortie, numeroLigne, &commande, resultat,
+                                  montant);
+
+        case COMMANDE_PLACE:
+            return repondrePlace(sortie, numeroLigne, &commande,
+                                 modifierEtatPlace(parking, commande.numero,
+                                     (EtatPlace)commande.etat));
+
+        case COMMANDE_RAPPORT:
+            presents = 0;
+            for (t = VOITURE; t <= BUS; t++) {
+                presents += parking->agregats.presentsParType[t];
+            }
+            ecrireRapportLot(sortie, parking->placesLibres,
+                             parking->placesOccupees, presents,
+                             parking->agregats.totalEntrees,
+                             parking->agregats.totalSorties,
+                             parking->recetteTotale);
+            return 1;
+
+        case COMMANDE_CONSULTATION:
+            return repondreConsultation(parking, sortie, numeroLigne,
+                                        &commande);
+
+        case COMMANDE_DISPONIBILITE:
+            repondreDisponibilite(parking, sortie, &commande);
+            return 1;
+
+        default:
+            /* Les durees de stationnement suivent alors le lot, pas la
+             * pendule */
+            if (sourceHorlogeCourante() != HORLOGE_SIMULEE) {
+                choisirSourceHorloge(HORLOGE_SIMULEE);
+            }
+            avancerHorlogeSimulee(commande.numero);
+
+            fprintf(sortie, "OK\n");
+            return 1;
+    }
+}
+
+int executerLot(Parking *parking, FILE *entree, FILE *sortie,
+                BilanLot *bilan)
+{
+    char ligne[TAILLE_LIGNE_LOT];
+    long numeroLigne;
+    double debut;
+    int lecture;
+    int resultat;
+
+    if (parking == NULL || entree == NULL || sortie == NULL ||
+        bilan == NULL) {
+        return 0;
+    }
+
+    memset(bilan, 0, sizeof(*bilan));
+    numeroLigne = 0;
+    debut = instantMonotone();
+
+    while ((lecture = lireLigneLot(entree, ligne, sizeof(ligne))) != 0) {
+        numeroLigne++;
+
+        if (lecture == 1) {
+            resultat = executerCommandeLot(parking, ligne, numeroLigne,
+                                           sortie, bilan, 1);
+        } else {
+            bilan->commandes++;
+            fprintf(sortie, "ERR %ld ligne trop longue\n", numeroLigne);
+            resultat = 0;
+        }
+
+        if (resultat == 0) {
+            bilan->erreurs++;
+        }
+
+        /* Entretien periodique, comme a chaque tour de la boucle
+         * interactive */
+        if (resultat != -1 &&
+            bilan->commandes % COMMANDES_PAR_ENTRETIEN == 0) {
+            archiverHistorique(parking);
+            sauvegarderSiEcheance(parking);
+            exporterMetriquesSiEcheance(parking);
+        }
+    }
+
+    fflush(sortie);
+    bilan->secondes = instantMonotone() - debut;
+
+    return bilan->erreurs == 0;
+}
+
+/* ============================================================================
+ * EXECUTION CONCURRENTE
+ * ============================================================================ */
+
+/**
+ * @struct FinVoies
+ * @brief Nombre de voies terminees, attendu par le thread coordinateur
+ */
+typedef struct {
+    pthread_mutex_t verrou;
+    pthread_cond_t condition;
+    int terminees;
+} FinVoies;
+
+/**
+ * @struct TacheVoie
+ * @brief Travail d'un thread : une voie, ses flux et son bilan
+ */
+typedef struct {
+    MoteurConcurrent *moteur;
+    int voie;
+    FILE *entree;
+    FILE *sortie;
+    BilanLot *bilan;
+    FinVoies *fin;
+    int resultat;
+} TacheVoie;
+
+/**
+ * @brief Execute une ligne de commande sur une voie du moteur
+ * @param tache Voie concernee
+ * @param ligne Ligne lue (sans caractere de fin de ligne)
+ * @param numeroLigne Numero de la ligne
+ * @return 1 si la commande a reussi, 0 sinon, -1 si la ligne est ignoree
+ */
+static int executerCommandeVoie(TacheVoie *tache, const char *ligne,
+                                long numeroLigne)
+{
+    CommandeLot commande;
+    TotauxConcurrents totaux;
+    int resultat;
+    float montant;
+
+    resultat = analyserCommandeLot(ligne, numeroLigne, &commande,
+                                   tache->sortie, tache->bilan);
+    if (resultat != 1) {
+        return resultat;
+    }
+
+    switch (commande.nature) {
+        case COMMANDE_ENTREE:
+            return repondreEntree(tache->sortie, numeroLigne, &commande,
+                                  entreeConcurrente(tache->moteur,
+                                      tache->voie, commande.plaque,
+                                      commande.proprietaire,
+                                      (TypeVehicule)commande.type));
+
+        case COMMANDE_SORTIE:
+            montant = 0.0f;
+            resultat = sortieConcurrente(tache->moteur, tache->voie,
+                                         commande.plaque, &montant);
+            return repondreSortie(tache->sortie, numeroLigne, &commande,
+                                  resultat, montant);
+
+        case COMMANDE_PLACE:
+            return repondrePlace(tache->sortie, numeroLigne, &commande,
+                                 etatPlaceConcurrent(tache->moteur,
+                                     tache->voie, commande.numero,
+                                     (EtatPlace)commande.etat));
+
+        case COMMANDE_RAPPORT:
+            totaliserMoteurConcurrent(tache->moteur, &totaux);
+            ecrireRapportLot(tache->sortie, totaux.placesLibres,
+                             totaux.placesOccupees, totaux.presents,
+                             totaux.entrees, totaux.sorties,
+                             totaux.recettes);
+            return 1;
+
+        default:
+            /* L'horloge est commune a toutes les voies ; les consultations
+             * lisent le parking, qui n'est a jour qu'apres la fusion */
+            fprintf(tache->sortie, "ERR %ld %s indisponible sur une voie\n",
+                    numeroLigne, commande.nom);
+            return 0;
+    }
+}
+
+/**
+ * @brief Corps d'un thread : execute les commandes d'une voie
+ * @param argument TacheVoie a executer
+ * @return NULL
+ */
+static void* executerVoie(void *argument)
+{
+    TacheVoie *tache;
+    char ligne[TAILLE_LIGNE_LOT];
+    char nomVoie[24];
+    long numeroLigne;
+    double debut;
+    int lecture;
+    int resultat;
+
+    tache = (TacheVoie*)argument;
+    numeroLigne = 0;
+
+    if (traceActive) {
+        sprintf(nomVoie, "voie %d", tache->voie + 1);
+        nommerThreadTrace(nomVoie);
+    }
+    debut = instantMonotone();
+
+    while ((lecture = lireLigneLot(tache->entree, ligne,
+                                   sizeof(ligne))) != 0) {
+        numeroLigne++;
+
+        if (lecture == 1) {
+            resultat = executerCommandeVoie(tache, ligne, numeroLigne);
+        } else {
+            tache->bilan->commandes++;
+            fprintf(tache->sortie, "ERR %ld ligne trop longue\n",
+                    numeroLigne);
+            resultat = 0;
+        }
+
+        if (resultat == 0) {
+            tache->bilan->erreurs++;
+        }
+    }
+
+    fflush(tache->sortie);
+    tache->bilan->secondes = instantMonotone() - debut;
+    tache->resultat = tache->bilan->erreurs == 0;
+
+    pthread_mutex_lock(&tache->fin->verrou);
+    tache->fin->terminees++;
+    pthread_cond_signal(&tache->fin->condition);
+    pthread_mutex_unlock(&tache->fin->verrou);
+
+    return NULL;
+}
+
+/**
+ * @brief Attend la fin des voies en leur publiant l'heure et en reportant
+ *        leurs operations
+ * @param moteur Moteur concurrent
+ * @param fin Compteur des voies terminees
+ * @param nombreVoies Nombre de voies
+ *
+ * Seul ce thread lit l'horloge : les voies recoivent l'heure. Il est aussi
+ * le seul a fusionner : les operations deja confirmees par les voies
+ * rejoignent le parking et le journal synchronise a chaque periode.
+ */
+static void attendreFinVoies(MoteurConcurrent *moteur, FinVoies *fin,
+                             int nombreVoies)
+{
+    struct timespec echeance;
+    int fusionEnEchec;
+
+    fusionEnEchec = 0;
+
+    pthread_mutex_lock(&fin->verrou);
+
+    while (fin->terminees < nombreVoies) {
+        clock_gettime(CLOCK_REALTIME, &echeance);
+        echeance.tv_nsec += PERIODE_HORLOGE_VOIES_MS * 1000000L;
+        if (echeance.tv_nsec >= 1000000000L) {
+            echeance.tv_sec++;
+            echeance.tv_nsec -= 1000000000L;
+        }
+
+        if (pthread_cond_timedwait(&fin->condition, &fin->verrou,
+                                   &echeance) != 0) {
+            reglerHeureMoteur(moteur, obtenirHorodatageActuel());
+
+            /* Apres un echec, la fusion finale le signalera */
+            if (fusionEnEchec == 0) {
+                pthread_mutex_unlock(&fin->verrou);
+                fusionEnEchec = fusionnerMoteurConcurrent(moteur) < 0;
+                pthread_mutex_lock(&fin->verrou);
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&fin->verrou);
+}
+
+int executerLotConcurrent(MoteurConcurrent *moteur, FILE *entrees[],
+                          FILE *sorties[], int nombreVoies,
+                          BilanLot bilans[])
+{
+    TacheVoie *taches;
+    pthread_t *threads;
+    FinVoies fin;
+    int *lances;
+    int resultat;
+    int v;
+
+    if (moteur == NULL || entrees == NULL || sorties == NULL ||
+        bilans == NULL || nombreVoies < 1) {
+        return 0;
+    }
+
+    taches = (TacheVoie*)calloc(nombreVoies, sizeof(TacheVoie));
+    threads = (pthread_t*)calloc(nombreVoies, sizeof(pthread_t));
+    lances = (int*)calloc(nombreVoies, sizeof(int));
+    if (taches == NULL || threads == NULL || lances == NULL ||
+        pthread_mutex_init(&fin.verrou, NULL) != 0) {
+        free(taches);
+        free(threads);
+        free(lances);
+        return 0;
+    }
+
+    if (pthread_cond_init(&fin.condition, NULL) != 0) {
+        pthread_mutex_destroy(&fin.verrou);
+        free(taches);
+        free(threads);
+        free(lances);
+        return 0;
+    }
+
+    fin.terminees = 0;
+    reglerHeureMoteur(moteur, obtenirHorodatageActuel());
+
+    for (v = 0; v < nombreVoies; v++) {
+        memset(&bilans[v], 0, sizeof(BilanLot));
+        taches[v].moteur = moteur;
+        taches[v].voie = v;
+        taches[v].entree = entrees[v];
+        taches[v].sortie = sorties[v];
+        taches[v].bilan = &bilans[v];
+        taches[v].fin = &fin;
+    }
+
+    for (v = 0; v < nombreVoies; v++) {
+        lances[v] = pthread_create(&threads[v], NULL, executerVoie,
+                                   &taches[v]) == 0;
+    }
+
+    /* Voie sans thread (limite du systeme) : executee ici */
+    for (v = 0; v < nombreVoies; v++) {
+        if (lances[v] == 0) {
+            executerVoie(&taches[v]);
+        }
+    }
+
+    attendreFinVoies(moteur, &fin, nombreVoies);
+
+    resultat = 1;
+    for (v = 0; v < nombreVoies; v++) {
+        if (lances[v]) {
+            pthread_join(threads[v], NULL);
+        }
+        resultat = resultat && taches[v].resultat;
+    }
+
+    pthread_cond_destroy(&fin.condition);
+    pthread_mutex_destroy(&fin.verrou);
+
+    free(taches);
+    free(threads);
+    free(lances);
+
+    return resultat;
+}
+
+void afficherBilanLot(const BilanLot *bilan, FILE *sortie)
+{
+    if (bilan == NULL || sortie == NULL) {
+        return;
+    }
+
+    fprintf(sortie, "\n=== BILAN DU LOT ===\n");
+    fprintf(sortie, "Commandes         : %ld (%ld en erreur)\n",
+            bilan->commandes, bilan->erreurs);
+    fprintf(sortie, "Entrees / sorties : %ld / %ld\n",
+            bilan->entrees, bilan->sorties);
+    fprintf(sortie, "Etats de places   : %ld\n", bilan->changementsEtat);
+    fprintf(sortie, "Rapports          : %ld\n", bilan->rapports);
+    fprintf(sortie, "Consultations     : %ld\n", bilan->consultations);
+    fprintf(sortie, "Duree             : %.3f s\n", bilan->secondes);
+
+    if (bilan->secondes > 0) {
+        fprintf(sortie, "Debit             : %.0f commandes/s\n",
+                bilan->commandes / bilan->secondes);
+    }
+}
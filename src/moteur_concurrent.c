@@ -0,0 +1,1192 @@
+/**
+ * @file moteur_concurrent.c
+ * @brief Implementation du moteur concurrent (plusieurs voies)
+ * @date Decembre 2025
+ *
+ * Etat d'une place : entier change par compare-et-echange. Les bitmaps
+ * de places libres par type (mots atomiques) guident la recherche ; une
+ * place n'est attribuee qu'a la voie dont le compare-et-echange
+ * LIBRE -> OCCUPEE reussit. Invariant : une place stablement LIBRE a son
+ * bit a 1 (le bit est pose avant l'etat LIBRE, retire apres l'avoir
+ * quitte).
+ *
+ * Chaque operation recoit un numero d'ordre (ticket) pris apres avoir
+ * obtenu la place et avant de la rendre, sous le verrou du fragment de
+ * la plaque : l'ordre des tickets respecte donc l'ordre des operations
+ * sur une meme plaque comme sur une meme place, et la fusion peut les
+ * rejouer une a une dans le parking.
+ *
+ * Le ticket est pris et l'operation rangee sous le verrou des operations
+ * de la voie. La fusion prend les listes de toutes les voies en tenant
+ * tous ces verrous a la fois : les listes prises contiennent alors tous
+ * les tickets deja distribues, et eux seuls. Elles forment un debut de la
+ * suite des tickets, que la fusion peut reporter pendant que les voies
+ * continuent.
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+#include <pthread.h>
+#include "../include/moteur_concurrent.h"
+#include "../include/parking.h"
+#include "../include/utilitaires.h"
+#include "../include/tarification.h"
+#include "../include/journal.h"
+#include "../include/trace.h"
+#include "../include/prototypes.h"
+
+/** Taille d'une ligne de cache */
+#define TAILLE_LIGNE_CACHE 64
+
+/** Fragments de l'index des plaques (puissance de 2) */
+#define NOMBRE_FRAGMENTS 64
+
+/** Cases initiales d'un fragment (puissance de 2) */
+#define CASES_INITIALES_FRAGMENT 16
+
+/** Operations gardees par voie avant le premier agrandissement */
+#define OPERATIONS_INITIALES 256
+
+/** Etat transitoire d'une place pendant un changement d'etat */
+#define ETAT_EN_COURS 4
+
+/* ============================================================================
+ * STRUCTURES INTERNES
+ * ============================================================================ */
+
+/**
+ * @enum NatureOperation
+ * @brief Nature d'une operation gardee par une voie
+ */
+typedef enum {
+    OPERATION_ENTREE = 1,
+    OPERATION_SORTIE = 2,
+    OPERATION_ETAT_PLACE = 3
+} NatureOperation;
+
+/**
+ * @struct OperationVoie
+ * @brief Operation en attente de fusion dans le parking
+ *
+ * valeur contient le type du vehicule (entree) ou le nouvel etat de la
+ * place (changement d'etat).
+ */
+typedef struct {
+    uint64_t ticket;
+    int32_t nature;
+    int32_t numeroPlace;
+    int32_t valeur;
+    int32_t minutes;
+    float montant;
+    char plaque[TAILLE_PLAQUE];
+    char proprietaire[MAX_CHAINE];
+} OperationVoie;
+
+/**
+ * @struct PresenceVehicule
+ * @brief Vehicule present, dans un fragment de l'index des plaques
+ */
+typedef struct {
+    char plaque[TAILLE_PLAQUE];
+    TypeVehicule type;
+    int32_t numeroPlace;    /* 0 : case vide */
+    Horodatage entree;
+} PresenceVehicule;
+
+/**
+ * @struct FragmentPlaques
+ * @brief Partie de l'index des plaques et son verrou
+ */
+typedef struct {
+    pthread_mutex_t verrou;
+    PresenceVehicule *cases;
+    int taille;
+    int nombre;
+} FragmentPlaques;
+
+/** Fragment seul sur ses lignes de cache (pas de faux partage de verrou) */
+typedef union {
+    FragmentPlaques fragment;
+    char alignement[2 * TAILLE_LIGNE_CACHE];
+} FragmentAligne;
+
+/**
+ * @struct EtatVoie
+ * @brief Compteurs et operations d'une voie, ecrits par elle seule
+ *
+ * La liste des operations n'est lue et echangee par la fusion que sous
+ * verrouOperations.
+ */
+typedef struct {
+    long long entrees;
+    long long sorties;
+    long long changementsEtat;
+    long long refus;
+    long long centimes;
+    pthread_mutex_t verrouOperations;
+    OperationVoie *operations;
+    int nombreOperations;
+    int capaciteOperations;
+} EtatVoie;
+
+/** Voie seule sur ses lignes de cache */
+typedef union {
+    EtatVoie etat;
+    char alignement[2 * TAILLE_LIGNE_CACHE];
+} VoieAlignee;
+
+/**
+ * @struct ReserveVoie
+ * @brief Operations prises a une voie par la fusion (thread de la fusion
+ *        seul)
+ */
+typedef struct {
+    OperationVoie *operations;
+    int nombreOperations;
+    int capaciteOperations;
+    int reportees;
+} ReserveVoie;
+
+struct MoteurConcurrent {
+    Parking *parking;
+    int nombrePlaces;
+    int nombreMots;
+    int *etats;
+    unsigned char *typesPlaces;
+    unsigned long long *libres[5];
+    FragmentAligne *fragments;
+    void *memoireFragments;
+    int fragmentsPrets;
+    VoieAlignee *voies;
+    void *memoireVoies;
+    int voiesPretes;
+    ReserveVoie *reserves;
+    int nombreVoies;
+    int placesLibresInitiales;
+    int placesOccupeesInitiales;
+    int presentsInitiaux;
+    int entreesInitiales;
+    int sortiesInitiales;
+    double recetteInitiale;
+    /* Ticket et heure, ecrits pendant la session, loin des champs lus */
+    char separation[TAILLE_LIGNE_CACHE];
+    uint64_t prochainTicket;
+    int32_t minutes;
+};
+
+/* ============================================================================
+ * OUTILS
+ * ============================================================================ */
+
+/**
+ * @brief Alloue une zone initialisee a zero alignee sur une ligne de cache
+ * @param taille Taille utile
+ * @param memoire Recoit le pointeur a liberer
+ * @return Debut aligne, NULL si memoire insuffisante
+ */
+static void* allouerAligne(size_t taille, void **memoire)
+{
+    uintptr_t adresse;
+
+    *memoire = calloc(1, taille + TAILLE_LIGNE_CACHE);
+    if (*memoire == NULL) {
+        return NULL;
+    }
+
+    adresse = ((uintptr_t)*memoire + TAILLE_LIGNE_CACHE - 1) &
+              ~(uintptr_t)(TAILLE_LIGNE_CACHE - 1);
+
+    return (void*)adresse;
+}
+
+/**
+ * @brief Ajoute a un compteur ecrit par une seule voie
+ * @param compteur Compteur de la voie
+ * @param valeur Valeur a ajouter
+ *
+ * Lecture et ecriture atomiques sans instruction verrouillee : seule la
+ * voie ecrit, les autres threads ne font que lire.
+ */
+static void ajouterCompteur(long long *compteur, long long valeur)
+{
+    __atomic_store_n(compteur,
+                     __atomic_load_n(compteur, __ATOMIC_RELAXED) + valeur,
+                     __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Ajoute une operation (vide) en fin de liste d'une voie, sous
+ *        son verrouOperations
+ * @param voie Voie
+ * @return Operation a remplir, NULL si memoire insuffisante
+ */
+static OperationVoie* ajouterOperation(EtatVoie *voie)
+{
+    OperationVoie *operations;
+    int capacite;
+
+    if (voie->nombreOperations == voie->capaciteOperations) {
+        capacite = voie->capaciteOperations > 0 ?
+                   voie->capaciteOperations * 2 : OPERATIONS_INITIALES;
+        operations = (OperationVoie*)realloc(voie->operations,
+                                             capacite * sizeof(OperationVoie));
+        if (operations == NULL) {
+            return NULL;
+        }
+        voie->operations = operations;
+        voie->capaciteOperations = capacite;
+    }
+
+    return &voie->operations[voie->nombreOperations++];
+}
+
+/**
+ * @brief Numerote et complete une operation, sous le verrouOperations de
+ *        la voie
+ * @param moteur Moteur concurrent
+ * @param operation Operation a completer
+ * @param nature Nature de l'operation
+ * @param numeroPlace Numero de la place
+ * @param plaque Plaque (NULL : aucune)
+ */
+static void numeroterOperation(MoteurConcurrent *moteur,
+                               OperationVoie *operation,
+                               NatureOperation nature, int numeroPlace,
+                               const char *plaque)
+{
+    size_t longueur;
+
+    memset(operation, 0, sizeof(*operation));
+    operation->ticket = __atomic_fetch_add(&moteur->prochainTicket, 1,
+                                           __ATOMIC_ACQ_REL);
+    operation->nature = nature;
+    operation->numeroPlace = numeroPlace;
+    operation->minutes = __atomic_load_n(&moteur->minutes, __ATOMIC_RELAXED);
+
+    /* Zone deja mise a zero : copie tronquee, terminee par ce zero */
+    if (plaque != NULL) {
+        longueur = strlen(plaque);
+        if (longueur > TAILLE_PLAQUE - 1) {
+            longueur = TAILLE_PLAQUE - 1;
+        }
+        memcpy(operation->plaque, plaque, longueur);
+    }
+}
+
+/* ============================================================================
+ * ETAT DES PLACES
+ * ============================================================================ */
+
+/**
+ * @brief Retire une place du bitmap des places libres de son type
+ * @param moteur Moteur concurrent
+ * @param indice Indice de la place
+ */
+static void retirerPlaceLibre(MoteurConcurrent *moteur, int indice)
+{
+    int type;
+
+    type = moteur->typesPlaces[indice];
+    if (type >= VOITURE && type <= BUS) {
+        __atomic_fetch_and(&moteur->libres[type][indice / 64],
+                           ~(1ULL << (indice % 64)), __ATOMIC_ACQ_REL);
+    }
+}
+
+/**
+ * @brief Rend une place libre : bit d'abord, etat LIBRE ensuite
+ * @param moteur Moteur concurrent
+ * @param indice Indice de la place
+ */
+static void publierPlaceLibre(MoteurConcurrent *moteur, int indice)
+{
+    int type;
+
+    type = moteur->typesPlaces[indice];
+    if (type >= VOITURE && type <= BUS) {
+        __atomic_fetch_or(&moteur->libres[type][indice / 64],
+                          1ULL << (indice % 64), __ATOMIC_ACQ_REL);
+    }
+
+    __atomic_store_n(&moteur->etats[indice], LIBRE, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Obtient une place libre pour un type de vehicule
+ * @param moteur Moteur concurrent
+ * @param type Type de vehicule
+ * @param depart Premier mot examine (les voies partent d'endroits
+ *        differents pour se gener le moins possible)
+ * @return Indice de la place obtenue (etat OCCUPEE), -1 si aucune
+ *
+ * Memes regles que rechercherPlaceLibre : type exact, puis pour une
+ * moto les places voiture et camion.
+ */
+static int prendrePlaceLibre(MoteurConcurrent *moteur, TypeVehicule type,
+                             int depart)
+{
+    unsigned long long mot;
+    int passe;
+    int n;
+    int i;
+    int indice;
+    int attendu;
+
+    for (passe = 0; passe < 2; passe++) {
+        if (passe == 1 && type != MOTO) {
+            break;
+        }
+
+        for (n = 0; n < moteur->nombreMots; n++) {
+            i = (depart + n) % moteur->nombreMots;
+
+            if (passe == 0) {
+                mot = __atomic_load_n(&moteur->libres[type][i],
+                                      __ATOMIC_ACQUIRE);
+            } else {
+                mot = __atomic_load_n(&moteur->libres[VOITURE][i],
+                                      __ATOMIC_ACQUIRE) |
+                      __atomic_load_n(&moteur->libres[CAMION][i],
+                                      __ATOMIC_ACQUIRE);
+            }
+
+            /* Un bit peut etre perime (place prise entre-temps) : le
+             * compare-et-echange decide, on passe alors au bit suivant */
+            while (mot != 0) {
+                indice = i * 64 + __builtin_ctzll(mot);
+                attendu = LIBRE;
+
+                if (__atomic_compare_exchange_n(&moteur->etats[indice],
+                                                &attendu, OCCUPEE, 0,
+                                                __ATOMIC_ACQ_REL,
+                                                __ATOMIC_ACQUIRE)) {
+                    retirerPlaceLibre(moteur, indice);
+                    return indice;
+                }
+
+                mot &= mot - 1;
+            }
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Obtient une place libre (prendrePlaceLibre, trace)
+ * @param moteur Moteur concurrent
+ * @param type Type de vehicule
+ * @param depart Premier mot examine
+ * @return Indice de la place obtenue (etat OCCUPEE), -1 si aucune
+ */
+static int obtenirPlaceLibre(MoteurConcurrent *moteur, TypeVehicule type,
+                             int depart)
+{
+    int indice;
+
+    TRACER_DEBUT(TRACE_PLACE_LIBRE);
+    indice = prendrePlaceLibre(moteur, type, depart);
+    TRACER_FIN(TRACE_PLACE_LIBRE);
+
+    return indice;
+}
+
+/* ============================================================================
+ * INDEX DES PLAQUES PAR FRAGMENTS
+ * ============================================================================ */
+
+/**
+ * @brief Fragment responsable d'une plaque
+ * @param moteur Moteur concurrent
+ * @param empreinte Empreinte de la plaque
+ * @return Fragment (bits de poids fort : independants de la case)
+ */
+static FragmentPlaques* fragmentPlaque(MoteurConcurrent *moteur,
+                                       unsigned int empreinte)
+{
+    return &moteur->fragments[(empreinte >> 24) &
+                              (NOMBRE_FRAGMENTS - 1)].fragment;
+}
+
+/**
+ * @brief Localise une plaque dans un fragment (verrou tenu)
+ * @param fragment Fragment
+ * @param plaque Plaque recherchee
+ * @param empreinte Empreinte de la plaque
+ * @return Position de la case, -1 si absente
+ */
+static int localiserPresence(const FragmentPlaques *fragment,
+                             const char *plaque, unsigned int empreinte)
+{
+    unsigned int masque;
+    unsigned int position;
+    int i;
+
+    masque = (unsigned int)fragment->taille - 1;
+    position = empreinte & masque;
+
+    for (i = 0; i < fragment->taille; i++) {
+        if (fragment->cases[position].numeroPlace == 0) {
+            return -1;
+        }
+
+        if (plaquesEquivalentes(fragment->cases[position].plaque, plaque)) {
+            return (int)position;
+        }
+
+        position = (position + 1) & masque;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Place un vehicule dans la premiere case vide de sa sequence
+ * @param cases Cases du fragment
+ * @param taille Nombre de cases (puissance de 2, au moins une vide)
+ * @param presence Vehicule a placer
+ * @param empreinte Empreinte de sa plaque
+ */
+static void placerPresence(PresenceVehicule *cases, int taille,
+                           const PresenceVehicule *presence,
+                           unsigned int empreinte)
+{
+    unsigned int masque;
+    unsigned int position;
+
+    masque = (unsigned int)taille - 1;
+    position = empreinte & masque;
+
+    while (cases[position].numeroPlace != 0) {
+        position = (position + 1) & masque;
+    }
+
+    cases[position] = *presence;
+}
+
+/**
+ * @brief Ajoute un vehicule a un fragment (verrou tenu)
+ * @param fragment Fragment
+ * @param presence Vehicule present
+ * @param empreinte Empreinte de sa plaque
+ * @return 1 si succes, 0 si memoire insuffisante
+ *
+ * Le fragment est garde au plus a moitie plein.
+ */
+static int ajouterPresence(FragmentPlaques *fragment,
+                           const PresenceVehicule *presence,
+                           unsigned int empreinte)
+{
+    PresenceVehicule *cases;
+    int taille;
+    int i;
+
+    if ((fragment->nombre + 1) * 2 > fragment->taille) {
+        taille = fragment->taille * 2;
+        cases = (PresenceVehicule*)calloc(taille, sizeof(PresenceVehicule));
+        if (cases == NULL) {
+            return 0;
+        }
+
+        for (i = 0; i < fragment->taille; i++) {
+            if (fragment->cases[i].numeroPlace != 0) {
+                placerPresence(cases, taille, &fragment->cases[i],
+                               hacherPlaque(fragment->cases[i].plaque));
+            }
+        }
+
+        free(fragment->cases);
+        fragment->cases = cases;
+        fragment->taille = taille;
+    }
+
+    placerPresence(fragment->cases, fragment->taille, presence, empreinte);
+    fragment->nombre++;
+
+    return 1;
+}
+
+/**
+ * @brief Retire la case d'un fragment (verrou tenu)
+ * @param fragment Fragment
+ * @param trouve Position de la case a vider
+ *
+ * Suppression par decalage arriere, comme l'index du parking.
+ */
+static void retirerPresence(FragmentPlaques *fragment, int trouve)
+{
+    unsigned int masque;
+    unsigned int trou;
+    unsigned int position;
+    unsigned int ideale;
+
+    masque = (unsigned int)fragment->taille - 1;
+    trou = (unsigned int)trouve;
+    position = (trou + 1) & masque;
+
+    while (fragment->cases[position].numeroPlace != 0) {
+        ideale = hacherPlaque(fragment->cases[position].plaque) & masque;
+
+        if (((position - ideale) & masque) >= ((position - trou) & masque)) {
+            fragment->cases[trou] = fragment->cases[position];
+            trou = position;
+        }
+
+        position = (position + 1) & masque;
+    }
+
+    fragment->cases[trou].numeroPlace = 0;
+    fragment->nombre--;
+}
+
+/* ============================================================================
+ * CYCLE DE VIE
+ * ============================================================================ */
+
+MoteurConcurrent* creerMoteurConcurrent(Parking *parking, int nombreVoies)
+{
+    MoteurConcurrent *moteur;
+    FragmentPlaques *fragment;
+    PresenceVehicule presence;
+    const Vehicule *vehicule;
+    const Place *place;
+    unsigned int empreinte;
+    int i;
+    int t;
+
+    if (parking == NULL || nombreVoies < 1) {
+        return NULL;
+    }
+
+    moteur = (MoteurConcurrent*)calloc(1, sizeof(MoteurConcurrent));
+    if (moteur == NULL) {
+        return NULL;
+    }
+
+    moteur->parking = parking;
+    moteur->nombrePlaces = parking->nombrePlaces;
+    moteur->nombreMots = (parking->nombrePlaces + 63) / 64;
+    moteur->nombreVoies = nombreVoies;
+
+    moteur->etats = (int*)malloc((parking->nombrePlaces + 1) * sizeof(int));
+    moteur->typesPlaces = (unsigned char*)malloc(parking->nombrePlaces + 1);
+    moteur->fragments = (FragmentAligne*)allouerAligne(
+                            NOMBRE_FRAGMENTS * sizeof(FragmentAligne),
+                            &moteur->memoireFragments);
+    moteur->voies = (VoieAlignee*)allouerAligne(
+                        nombreVoies * sizeof(VoieAlignee),
+                        &moteur->memoireVoies);
+    moteur->reserves = (ReserveVoie*)calloc(nombreVoies, sizeof(ReserveVoie));
+    if (moteur->etats == NULL || moteur->typesPlaces == NULL ||
+        moteur->fragments == NULL || moteur->voies == NULL ||
+        moteur->reserves == NULL) {
+        detruireMoteurConcurrent(moteur);
+        return NULL;
+    }
+
+    for (i = 0; i < nombreVoies; i++) {
+        if (pthread_mutex_init(&moteur->voies[i].etat.verrouOperations,
+                               NULL) != 0) {
+            detruireMoteurConcurrent(moteur);
+            return NULL;
+        }
+        moteur->voiesPretes++;
+    }
+
+    /* Etat et type des places, bitmaps repris du parking */
+    for (t = VOITURE; t <= BUS; t++) {
+        moteur->libres[t] = (unsigned long long*)calloc(
+                                moteur->nombreMots + 1,
+                                sizeof(unsigned long long));
+        if (moteur->libres[t] == NULL) {
+            detruireMoteurConcurrent(moteur);
+            return NULL;
+        }
+        if (moteur->nombreMots > 0) {
+            memcpy(moteur->libres[t], parking->bitmapLibres[t],
+                   moteur->nombreMots * sizeof(unsigned long long));
+        }
+    }
+
+    for (i = 0; i < parking->nombrePlaces; i++) {
+        place = obtenirPlace(parking, i);
+        moteur->etats[i] = place->etat;
+        moteur->typesPlaces[i] = (unsigned char)place->typeAutorise;
+    }
+
+    /* Fragments de l'index, garnis des vehicules presents */
+    for (i = 0; i < NOMBRE_FRAGMENTS; i++) {
+        fragment = &moteur->fragments[i].fragment;
+        fragment->cases = (PresenceVehicule*)calloc(CASES_INITIALES_FRAGMENT,
+                                                    sizeof(PresenceVehicule));
+        if (fragment->cases == NULL ||
+            pthread_mutex_init(&fragment->verrou, NULL) != 0) {
+            free(fragment->cases);
+            fragment->cases = NULL;
+            detruireMoteurConcurrent(moteur);
+            return NULL;
+        }
+        fragment->taille = CASES_INITIALES_FRAGMENT;
+        moteur->fragmentsPrets++;
+    }
+
+    for (i = 0; i < parking->tailleIndex; i++) {
+        if (parking->indexPlaques[i] < 0) {
+            continue;
+        }
+
+        vehicule = obtenirVehicule(parking, parking->indexPlaques[i]);
+        memset(&presence, 0, sizeof(presence));
+        strcpy(presence.plaque, vehicule->plaque);
+        presence.type = vehicule->type;
+        presence.numeroPlace = vehicule->numeroPlace;
+        presence.entree = vehicule->entree;
+
+        empreinte = hacherPlaque(presence.plaque);
+        if (ajouterPresence(fragmentPlaque(moteur, empreinte), &presence,
+                            empreinte) == 0) {
+            detruireMoteurConcurrent(moteur);
+            return NULL;
+        }
+    }
+
+    /* Compteurs du parking a l'ouverture de la session */
+    moteur->placesLibresInitiales = parking->placesLibres;
+    moteur->placesOccupeesInitiales = parking->placesOccupees;
+    moteur->entreesInitiales = parking->agregats.totalEntrees;
+    moteur->sortiesInitiales = parking->agregats.totalSorties;
+    moteur->recetteInitiale = parking->recetteTotale;
+    for (t = 0; t < 5; t++) {
+        moteur->presentsInitiaux += parking->agregats.presentsParType[t];
+    }
+
+    moteur->minutes = obtenirHorodatageActuel().minutes;
+
+    return moteur;
+}
+
+/**
+ * @brief Journalise puis applique une operation dans le parking
+ * @param parking Pointeur vers le parking
+ * @param operation Operation d'une voie
+ * @return SUCCES, ERREUR_MEMOIRE ou ERREUR_ENTREE_SORTIE (operation non
+ *         reportee, ni dans le parking ni dans le journal)
+ */
+static int appliquerOperation(Parking *parking, const OperationVoie *operation)
+{
+    Horodatage horodatage;
+    Vehicule *vehicule;
+    int resultat;
+
+    horodatage.minutes = operation->minutes;
+
+    switch (operation->nature) {
+        case OPERATION_ENTREE:
+#ifdef PARKING_DEBUG
+            /* Une place n'est jamais attribuee a deux voies a la fois */
+            assert(obtenirPlace(parking, operation->numeroPlace - 1)->etat ==
+                   LIBRE);
+#endif
+            resultat = journaliserEntree(parking, operation->plaque,
+                                         operation->proprietaire,
+                                         (TypeVehicule)operation->valeur,
+                                         operation->numeroPlace, horodatage);
+            if (resultat == SUCCES &&
+                appliquerEntree(parking, operation->plaque,
+                                operation->proprietaire,
+                                (TypeVehicule)operation->valeur,
+                                operation->numeroPlace, horodatage) == -1) {
+                annulerDernierEnregistrement(parking);
+                resultat = ERREUR_MEMOIRE;
+            }
+            return resultat;
+
+        case OPERATION_SORTIE:
+            vehicule = rechercherVehicule(parking, operation->plaque);
+            if (vehicule == NULL) {
+                return SUCCES;
+            }
+            resultat = journaliserSortie(parking, vehicule, horodatage,
+                                         operation->montant);
+            if (resultat == SUCCES) {
+                appliquerSortie(parking, vehicule, horodatage,
+                                operation->montant);
+            }
+            return resultat;
+
+        default:
+            resultat = journaliserEtatPlace(parking, operation->numeroPlace,
+                                            (EtatPlace)operation->valeur);
+            if (resultat == SUCCES) {
+                appliquerEtatPlace(parking, operation->numeroPlace,
+                                   (EtatPlace)operation->valeur);
+            }
+            return resultat;
+    }
+}
+
+/**
+ * @brief Prend les operations rangees par toutes les voies
+ * @param moteur Moteur concurrent (reserves toutes reportees)
+ *
+ * Les verrous de toutes les voies sont tenus pendant l'echange : les
+ * reserves recoivent exactement les tickets deja distribues. Chaque voie
+ * repart avec la liste, videe, de sa reserve.
+ */
+static void prendreOperationsVoies(MoteurConcurrent *moteur)
+{
+    EtatVoie *voie;
+    ReserveVoie *reserve;
+    OperationVoie *operations;
+    int capacite;
+    int v;
+
+    for (v = 0; v < moteur->nombreVoies; v++) {
+        pthread_mutex_lock(&moteur->voies[v].etat.verrouOperations);
+    }
+
+    for (v = 0; v < moteur->nombreVoies; v++) {
+        voie = &moteur->voies[v].etat;
+        reserve = &moteur->reserves[v];
+
+        operations = reserve->operations;
+        capacite = reserve->capaciteOperations;
+        reserve->operations = voie->operations;
+        reserve->capaciteOperations = voie->capaciteOperations;
+        reserve->nombreOperations = voie->nombreOperations;
+        reserve->reportees = 0;
+        voie->operations = operations;
+        voie->capaciteOperations = capacite;
+        voie->nombreOperations = 0;
+    }
+
+    for (v = moteur->nombreVoies - 1; v >= 0; v--) {
+        pthread_mutex_unlock(&moteur->voies[v].etat.verrouOperations);
+    }
+}
+
+/**
+ * @brief Indique si des operations prises aux voies restent a reporter
+ * @param moteur Moteur concurrent
+ * @return 1 si une reserve n'est pas entierement reportee, 0 sinon
+ */
+static int operationsEnReserve(const MoteurConcurrent *moteur)
+{
+    int v;
+
+    for (v = 0; v < moteur->nombreVoies; v++) {
+        if (moteur->reserves[v].reportees <
+            moteur->reserves[v].nombreOperations) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Reporte les reserves dans le parking, dans l'ordre des tickets
+ * @param moteur Moteur concurrent
+ * @param appliquees Nombre d'operations reportees, augmente
+ * @return SUCCES, ERREUR_MEMOIRE ou ERREUR_ENTREE_SORTIE (l'operation en
+ *         echec et les suivantes restent en reserve)
+ */
+static int reporterReserves(MoteurConcurrent *moteur, int *appliquees)
+{
+    ReserveVoie *reserve;
+    ReserveVoie *meilleure;
+    int resultat;
+    int v;
+
+    /* Fusion des reserves, chacune deja dans l'ordre des tickets */
+    for (;;) {
+        meilleure = NULL;
+        for (v = 0; v < moteur->nombreVoies; v++) {
+            reserve = &moteur->reserves[v];
+            if (reserve->reportees < reserve->nombreOperations &&
+                (meilleure == NULL ||
+                 reserve->operations[reserve->reportees].ticket <
+                 meilleure->operations[meilleure->reportees].ticket)) {
+                meilleure = reserve;
+            }
+        }
+
+        if (meilleure == NULL) {
+            return SUCCES;
+        }
+
+        resultat = appliquerOperation(moteur->parking, meilleure->operations +
+                                      meilleure->reportees);
+        if (resultat != SUCCES) {
+            return resultat;
+        }
+
+        meilleure->reportees++;
+        (*appliquees)++;
+    }
+}
+
+int fusionnerMoteurConcurrent(MoteurConcurrent *moteur)
+{
+    int appliquees;
+    int resultat;
+    int tour;
+
+    if (moteur == NULL) {
+        return ERREUR_PARAMETRE;
+    }
+
+    appliquees = 0;
+    resultat = SUCCES;
+
+    TRACER_DEBUT(TRACE_FUSION);
+
+    /* Reste d'une fusion interrompue d'abord, puis operations des voies */
+    for (tour = 0; tour < 2 && resultat == SUCCES; tour++) {
+        if (operationsEnReserve(moteur) == 0) {
+            prendreOperationsVoies(moteur);
+        }
+        resultat = reporterReserves(moteur, &appliquees);
+    }
+
+    /* Operations reportees sur disque avant de rendre la main */
+    if (resultat == SUCCES && synchroniserJournal(moteur->parking) == 0) {
+        resultat = ERREUR_ENTREE_SORTIE;
+    }
+
+    TRACER_FIN(TRACE_FUSION);
+
+    return resultat == SUCCES ? appliquees : resultat;
+}
+
+void detruireMoteurConcurrent(MoteurConcurrent *moteur)
+{
+    int i;
+
+    if (moteur == NULL) {
+        return;
+    }
+
+    if (moteur->fragments != NULL) {
+        for (i = 0; i < NOMBRE_FRAGMENTS; i++) {
+            if (i < moteur->fragmentsPrets) {
+                pthread_mutex_destroy(&moteur->fragments[i].fragment.verrou);
+            }
+            free(moteur->fragments[i].fragment.cases);
+        }
+    }
+
+    if (moteur->voies != NULL) {
+        for (i = 0; i < moteur->nombreVoies; i++) {
+            if (i < moteur->voiesPretes) {
+                pthread_mutex_destroy(&moteur->voies[i].etat.verrouOperations);
+            }
+            free(moteur->voies[i].etat.operations);
+        }
+    }
+
+    if (moteur->reserves != NULL) {
+        for (i = 0; i < moteur->nombreVoies; i++) {
+            free(moteur->reserves[i].operations);
+        }
+        free(moteur->reserves);
+    }
+
+    for (i = 0; i < 5; i++) {
+        free(moteur->libres[i]);
+    }
+
+    free(moteur->memoireFragments);
+    free(moteur->memoireVoies);
+    free(moteur->etats);
+    free(moteur->typesPlaces);
+    free(moteur);
+}
+
+/* ============================================================================
+ * OPERATIONS DES VOIES
+ * ============================================================================ */
+
+/**
+ * @brief Verifie un numero de voie
+ * @param moteur Moteur concurrent
+ * @param voie Numero de voie
+ * @return Etat de la voie, NULL si invalide
+ */
+static EtatVoie* obtenirVoie(MoteurConcurrent *moteur, int voie)
+{
+    if (moteur == NULL || voie < 0 || voie >= moteur->nombreVoies) {
+        return NULL;
+    }
+
+    return &moteur->voies[voie].etat;
+}
+
+int entreeConcurrente(MoteurConcurrent *moteur, int voie, const char *plaque,
+                      const char *proprietaire, TypeVehicule type)
+{
+    EtatVoie *etat;
+    FragmentPlaques *fragment;
+    PresenceVehicule presence;
+    OperationVoie *operation;
+    unsigned int empreinte;
+    int indice;
+    int resultat;
+
+    etat = obtenirVoie(moteur, voie);
+    if (etat == NULL || plaque == NULL || proprietaire == NULL ||
+        type < VOITURE || type > BUS) {
+        return ERREUR_PARAMETRE;
+    }
+
+    TRACER_DEBUT(TRACE_ENTREE);
+
+    empreinte = hacherPlaque(plaque);
+    fragment = fragmentPlaque(moteur, empreinte);
+
+    pthread_mutex_lock(&fragment->verrou);
+
+    if (localiserPresence(fragment, plaque, empreinte) != -1) {
+        resultat = ERREUR_DEJA_PRESENT;
+    } else if ((indice = obtenirPlaceLibre(moteur, type,
+                    voie * moteur->nombreMots / moteur->nombreVoies)) == -1) {
+        resultat = ERREUR_AUCUNE_PLACE;
+    } else {
+        memset(&presence, 0, sizeof(presence));
+        strncpy(presence.plaque, plaque, TAILLE_PLAQUE - 1);
+        presence.type = type;
+        presence.numeroPlace = indice + 1;
+        presence.entree.minutes = __atomic_load_n(&moteur->minutes,
+                                                  __ATOMIC_RELAXED);
+
+        pthread_mutex_lock(&etat->verrouOperations);
+
+        operation = ajouterOperation(etat);
+        if (operation == NULL ||
+            ajouterPresence(fragment, &presence, empreinte) == 0) {
+            if (operation != NULL) {
+                etat->nombreOperations--;
+            }
+            publierPlaceLibre(moteur, indice);
+            resultat = ERREUR_MEMOIRE;
+        } else {
+            numeroterOperation(moteur, operation, OPERATION_ENTREE,
+                               indice + 1, plaque);
+            operation->valeur = type;
+            operation->minutes = presence.entree.minutes;
+            strncpy(operation->proprietaire, proprietaire, MAX_CHAINE - 1);
+            resultat = indice + 1;
+        }
+
+        pthread_mutex_unlock(&etat->verrouOperations);
+    }
+
+    pthread_mutex_unlock(&fragment->verrou);
+
+    ajouterCompteur(resultat > 0 ? &etat->entrees : &etat->refus, 1);
+
+    TRACER_FIN(TRACE_ENTREE);
+
+    return resultat;
+}
+
+int sortieConcurrente(MoteurConcurrent *moteur, int voie, const char *plaque,
+                      float *montant)
+{
+    EtatVoie *etat;
+    FragmentPlaques *fragment;
+    PresenceVehicule presence;
+    OperationVoie *operation;
+    Horodatage sortie;
+    unsigned int empreinte;
+    int position;
+    int resultat;
+    float aPayer;
+
+    etat = obtenirVoie(moteur, voie);
+    if (etat == NULL || plaque == NULL) {
+        return ERREUR_PARAMETRE;
+    }
+
+    TRACER_DEBUT(TRACE_SORTIE);
+
+    empreinte = hacherPlaque(plaque);
+    fragment = fragmentPlaque(moteur, empreinte);
+    aPayer = 0.0f;
+
+    pthread_mutex_lock(&fragment->verrou);
+
+    position = localiserPresence(fragment, plaque, empreinte);
+    if (position == -1) {
+        resultat = ERREUR_VEHICULE_ABSENT;
+    } else {
+        pthread_mutex_lock(&etat->verrouOperations);
+
+        operation = ajouterOperation(etat);
+        if (operation == NULL) {
+            resultat = ERREUR_MEMOIRE;
+        } else {
+            presence = fragment->cases[position];
+            retirerPresence(fragment, position);
+
+            sortie.minutes = __atomic_load_n(&moteur->minutes,
+                                             __ATOMIC_RELAXED);
+            aPayer = calculerMontantSejour(presence.entree,
+                                           calculerDureeMinutes(
+                                               presence.entree, sortie),
+                                           presence.type);
+
+            numeroterOperation(moteur, operation, OPERATION_SORTIE,
+                               presence.numeroPlace, presence.plaque);
+            operation->minutes = sortie.minutes;
+            operation->montant = aPayer;
+
+            /* Place rendue apres le ticket : une entree qui la reprend
+             * est numerotee apres cette sortie */
+            publierPlaceLibre(moteur, presence.numeroPlace - 1);
+            resultat = SUCCES;
+        }
+
+        pthread_mutex_unlock(&etat->verrouOperations);
+    }
+
+    pthread_mutex_unlock(&fragment->verrou);
+
+    if (resultat == SUCCES) {
+        ajouterCompteur(&etat->sorties, 1);
+        ajouterCompteur(&etat->centimes, (long long)(aPayer * 100.0f + 0.5f));
+        if (montant != NULL) {
+            *montant = aPayer;
+        }
+    } else {
+        ajouterCompteur(&etat->refus, 1);
+    }
+
+    TRACER_FIN(TRACE_SORTIE);
+
+    return resultat;
+}
+
+int etatPlaceConcurrent(MoteurConcurrent *moteur, int voie, int numeroPlace,
+                        EtatPlace nouvelEtat)
+{
+    EtatVoie *etat;
+    OperationVoie *operation;
+    int indice;
+    int ancien;
+    int attendu;
+
+    etat = obtenirVoie(moteur, voie);
+    if (etat == NULL || nouvelEtat < LIBRE || nouvelEtat > HORS_SERVICE ||
+        nouvelEtat == OCCUPEE) {
+        return ERREUR_PARAMETRE;
+    }
+
+    if (numeroPlace < 1 || numeroPlace > moteur->nombrePlaces) {
+        ajouterCompteur(&etat->refus, 1);
+        return ERREUR_PLACE_INVALIDE;
+    }
+
+    indice = numeroPlace - 1;
+
+    /* Place mise a l'etat transitoire : ni entree ni autre changement
+     * ne peuvent la prendre pendant que l'operation est numerotee */
+    do {
+        ancien = __atomic_load_n(&moteur->etats[indice], __ATOMIC_ACQUIRE);
+        if (ancien == OCCUPEE) {
+            ajouterCompteur(&etat->refus, 1);
+            return ERREUR_PLACE_OCCUPEE;
+        }
+        attendu = ancien;
+    } while (ancien == ETAT_EN_COURS ||
+             !__atomic_compare_exchange_n(&moteur->etats[indice], &attendu,
+                                          ETAT_EN_COURS, 0, __ATOMIC_ACQ_REL,
+                                          __ATOMIC_ACQUIRE));
+
+    if (ancien == LIBRE) {
+        retirerPlaceLibre(moteur, indice);
+    }
+
+    pthread_mutex_lock(&etat->verrouOperations);
+
+    operation = ajouterOperation(etat);
+    if (operation == NULL) {
+        pthread_mutex_unlock(&etat->verrouOperations);
+        if (ancien == LIBRE) {
+            publierPlaceLibre(moteur, indice);
+        } else {
+            __atomic_store_n(&moteur->etats[indice], ancien, __ATOMIC_RELEASE);
+        }
+        ajouterCompteur(&etat->refus, 1);
+        return ERREUR_MEMOIRE;
+    }
+
+    numeroterOperation(moteur, operation, OPERATION_ETAT_PLACE, numeroPlace,
+                       NULL);
+    operation->valeur = nouvelEtat;
+
+    pthread_mutex_unlock(&etat->verrouOperations);
+
+    if (nouvelEtat == LIBRE) {
+        publierPlaceLibre(moteur, indice);
+    } else {
+        __atomic_store_n(&moteur->etats[indice], (int)nouvelEtat,
+                         __ATOMIC_RELEASE);
+    }
+
+    ajouterCompteur(&etat->changementsEtat, 1);
+
+    return SUCCES;
+}
+
+void totaliserMoteurConcurrent(const MoteurConcurrent *moteur,
+                               TotauxConcurrents *totaux)
+{
+    const EtatVoie *voie;
+    long long centimes;
+    long presents;
+    int v;
+
+    if (moteur == NULL || totaux == NULL) {
+        return;
+    }
+
+    memset(totaux, 0, sizeof(*totaux));
+    centimes = 0;
+
+    for (v = 0; v < moteur->nombreVoies; v++) {
+        voie = &moteur->voies[v].etat;
+        totaux->entrees += (long)__atomic_load_n(&voie->entrees,
+                                                 __ATOMIC_RELAXED);
+        totaux->sorties += (long)__atomic_load_n(&voie->sorties,
+                                                 __ATOMIC_RELAXED);
+        totaux->changementsEtat += (long)__atomic_load_n(
+                                       &voie->changementsEtat,
+                                       __ATOMIC_RELAXED);
+        totaux->refus += (long)__atomic_load_n(&voie->refus,
+                                               __ATOMIC_RELAXED);
+        centimes += __atomic_load_n(&voie->centimes, __ATOMIC_RELAXED);
+    }
+
+    presents = totaux->entrees - totaux->sorties;
+    totaux->placesLibres = moteur->placesLibresInitiales - (int)presents;
+    totaux->placesOccupees = moteur->placesOccupeesInitiales + (int)presents;
+    totaux->presents = moteur->presentsInitiaux + (int)presents;
+    totaux->entrees += moteur->entreesInitiales;
+    totaux->sorties += moteur->sortiesInitiales;
+    totaux->recettes = moteur->recetteInitiale + centimes / 100.0;
+}
+
+void reglerHeureMoteur(MoteurConcurrent *moteur, Horodatage heure)
+{
+    if (moteur != NULL) {
+        __atomic_store_n(&moteur->minutes, heure.minutes, __ATOMIC_RELAXED);
+    }
+}
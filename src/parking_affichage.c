@@ -1,6 +1,6 @@
 /**
  * @file parking_affichage.c
- * @brief Implementation des fonctions d'affichage des vehicules
+ * @brief Implementation des fonctions d'affichage des vehicules et places
 
  * @date Decembre 2025
  */
@@ -10,6 +10,7 @@
 #include <string.h>
 #include "../include/parking.h"
 #include "../include/utilitaires.h"
+#include "../include/rendu.h"
 #include "../include/prototypes.h"
 
 /* ============================================================================
@@ -27,35 +28,39 @@ void afficherVehiculesPresents(const Parking *parking)
         return;
     }
     
-    afficherLigne('=', 80);
-    printf("   LISTE DES VEHICULES PRESENTS - %s\n", parking->nom);
-    afficherLigne('=', 80);
+    commencerRendu();
     
-    printf("%-15s %-20s %-12s %-20s %-8s\n",
-           "Plaque", "Proprietaire", "Type", "Heure entree", "Place");
-    afficherLigne('-', 80);
+    rendreLigne('=', 80);
+    rendreTexte("   LISTE DES VEHICULES PRESENTS - %s\n", parking->nom);
+    rendreLigne('=', 80);
+    
+    rendreTexte("%-15s %-20s %-12s %-20s %-8s\n",
+                "Plaque", "Proprietaire", "Type", "Heure entree", "Place");
+    rendreLigne('-', 80);
     
     compteur = 0;
     
-    for (i = 0; i < parking->nombreVehicules; i++) {
-        vehicule = &parking->historique[i];
+    for (i = premierVehiculeEnMemoire(parking); i < parking->nombreVehicules; i++) {
+        vehicule = lireVehicule(parking, i);
         
-        if (vehicule->estPresent == 1) {
+        if (vehicule != NULL && vehicule->estPresent == 1) {
             formaterHorodatage(vehicule->entree, buffer);
             
-            printf("%-15s %-20s %-12s %-20s %-8d\n",
-                   vehicule->plaque,
-                   vehicule->proprietaire,
-                   typeVehiculeEnChaine(vehicule->type),
-                   buffer,
-                   rechercherPlaceParVehicule((Parking*)parking, vehicule->plaque));
+            rendreTexte("%-15s %-20s %-12s %-20s %-8d\n",
+                        vehicule->plaque,
+                        vehicule->proprietaire,
+                        typeVehiculeEnChaine(vehicule->type),
+                        buffer,
+                        vehicule->numeroPlace);
             
             compteur++;
         }
     }
     
-    afficherLigne('=', 80);
-    printf("Total vehicules presents : %d\n", compteur);
+    rendreLigne('=', 80);
+    rendreTexte("Total vehicules presents : %d\n", compteur);
+    
+    terminerRendu();
 }
 
 /**
@@ -72,101 +77,177 @@ void afficherDetailsVehicule(const Vehicule *vehicule)
         return;
     }
     
-    afficherLigne('=', 50);
-    printf("   DETAILS DU VEHICULE\n");
-    afficherLigne('=', 50);
+    commencerRendu();
     
-    printf("Plaque         : %s\n", vehicule->plaque);
-    printf("Proprietaire   : %s\n", vehicule->proprietaire);
-    printf("Type           : %s\n", typeVehiculeEnChaine(vehicule->type));
+    rendreLigne('=', 50);
+    rendreTexte("   DETAILS DU VEHICULE\n");
+    rendreLigne('=', 50);
+    
+    rendreTexte("Plaque         : %s\n", vehicule->plaque);
+    rendreTexte("Proprietaire   : %s\n", vehicule->proprietaire);
+    rendreTexte("Type           : %s\n", typeVehiculeEnChaine(vehicule->type));
     
     formaterHorodatage(vehicule->entree, bufferEntree);
-    printf("Heure entree   : %s\n", bufferEntree);
+    rendreTexte("Heure entree   : %s\n", bufferEntree);
     
     if (vehicule->estPresent == 0) {
         formaterHorodatage(vehicule->sortie, bufferSortie);
-        printf("Heure sortie   : %s\n", bufferSortie);
-        printf("Montant paye   : %.2f FCFA\n", vehicule->montantPaye);
+        rendreTexte("Heure sortie   : %s\n", bufferSortie);
+        rendreTexte("Montant paye   : %.2f FCFA\n", vehicule->montantPaye);
     } else {
-        printf("Statut         : Actuellement present\n");
+        rendreTexte("Statut         : Actuellement present\n");
     }
     
-    afficherLigne('=', 50);
+    rendreLigne('=', 50);
+    
+    terminerRendu();
 }
 
 /**
- * @brief Calcule le montant a payer selon la duree et le type
- * @param dureeMinutes Duree de stationnement en minutes
- * @param type Type de vehicule
- * @return Montant a payer
+ * @brief Affiche le ticket d'entree
+ * @param parking Pointeur vers le parking
+ * @param plaque Plaque du vehicule
+ * @param numeroPlace Numero de la place attribuee
  */
-float calculerMontant(int dureeMinutes, TypeVehicule type)
+void afficherTicketEntree(const Parking *parking, const char *plaque, 
+                          int numeroPlace)
+{
+    char buffer[30];
+    Horodatage entree;
+    int indice;
+    
+    /* L'heure du ticket est celle enregistree a l'entree */
+    indice = rechercherIndexPlaque(parking, plaque);
+    entree = indice != -1 ? obtenirVehicule(parking, indice)->entree :
+                            obtenirHorodatageActuel();
+    formaterHorodatage(entree, buffer);
+    
+    commencerRendu();
+    
+    rendreTexte("\n");
+    rendreLigne('*', 40);
+    rendreTexte("*      TICKET D'ENTREE              *\n");
+    rendreLigne('*', 40);
+    rendreTexte("  Parking    : %s\n", parking->nom);
+    rendreTexte("  Plaque     : %s\n", plaque);
+    rendreTexte("  Place      : %d\n", numeroPlace);
+    rendreTexte("  Date/Heure : %s\n", buffer);
+    rendreLigne('*', 40);
+    rendreTexte("  Conservez ce ticket pour la sortie\n");
+    rendreLigne('*', 40);
+    rendreTexte("\n");
+    
+    terminerRendu();
+}
+
+/* ============================================================================
+ * AFFICHAGE DES PLACES
+ * ============================================================================ */
+
+void afficherEtatPlaces(const Parking *parking)
 {
-    float tarifBase;
-    float montant;
-    int heures;
-    
-    /* Tarif de base selon le type de vehicule */
-    switch (type) {
-        case MOTO:
-            tarifBase = TARIF_HORAIRE * 0.5f;
-            break;
-        case VOITURE:
-            tarifBase = TARIF_HORAIRE;
-            break;
-        case CAMION:
-            tarifBase = TARIF_HORAIRE * 1.5f;
-            break;
-        case BUS:
-            tarifBase = TARIF_HORAIRE * 2.0f;
-            break;
-        default:
-            tarifBase = TARIF_HORAIRE;
+    int i;
+    const Place *place;
+    
+    if (parking == NULL) {
+        return;
     }
     
-    /* Calcul du nombre d'heures (arrondies a l'heure superieure) */
-    heures = (dureeMinutes + 59) / 60;
+    commencerRendu();
     
-    /* Minimum une heure */
-    if (heures < 1) {
-        heures = 1;
-    }
+    rendreLigne('=', 70);
+    rendreTexte("   ETAT DES PLACES - %s\n", parking->nom);
+    rendreLigne('=', 70);
     
-    montant = tarifBase * heures;
+    rendreTexte("%-8s %-12s %-15s %-20s\n", 
+                "Place", "Etat", "Type autorise", "Vehicule");
+    rendreLigne('-', 70);
     
-    /* Plafonner au tarif journalier maximum */
-    if (montant > TARIF_JOURNALIER_MAX) {
-        montant = TARIF_JOURNALIER_MAX;
+    for (i = 0; i < parking->nombrePlaces; i++) {
+        place = obtenirPlace(parking, i);
+        
+        rendreTexte("%-8d %-12s %-15s ",
+                    place->numero,
+                    etatPlaceEnChaine(place->etat),
+                    typeVehiculeEnChaine(place->typeAutorise));
+        
+        if (place->vehiculeActuel != NULL) {
+            rendreTexte("%-20s", place->vehiculeActuel->plaque);
+        } else {
+            rendreTexte("%-20s", "-");
+        }
+        rendreTexte("\n");
     }
     
-    return montant;
+    rendreLigne('=', 70);
+    rendreTexte("Total : %d places | Libres : %d | Occupees : %d\n",
+                parking->nombrePlaces, parking->placesLibres, parking->placesOccupees);
+    
+    terminerRendu();
 }
 
-/**
- * @brief Affiche le ticket d'entree
- * @param parking Pointeur vers le parking
- * @param plaque Plaque du vehicule
- * @param numeroPlace Numero de la place attribuee
- */
-void afficherTicketEntree(const Parking *parking, const char *plaque, 
-                          int numeroPlace)
+void afficherCartePaking(const Parking *parking)
 {
-    char buffer[30];
-    Horodatage maintenant;
-    
-    maintenant = obtenirHorodatageActuel();
-    formaterHorodatage(maintenant, buffer);
-    
-    printf("\n");
-    afficherLigne('*', 40);
-    printf("*      TICKET D'ENTREE              *\n");
-    afficherLigne('*', 40);
-    printf("  Parking    : %s\n", parking->nom);
-    printf("  Plaque     : %s\n", plaque);
-    printf("  Place      : %d\n", numeroPlace);
-    printf("  Date/Heure : %s\n", buffer);
-    afficherLigne('*', 40);
-    printf("  Conservez ce ticket pour la sortie\n");
-    afficherLigne('*', 40);
-    printf("\n");
+    int i;
+    int j;
+    int placesParLigne;
+    int numeroPlace;
+    char symbole;
+    
+    if (parking == NULL) {
+        return;
+    }
+    
+    placesParLigne = 10;
+    
+    commencerRendu();
+    
+    rendreTexte("\n");
+    rendreLigne('=', 50);
+    rendreTexte("      CARTE DU PARKING : %s\n", parking->nom);
+    rendreLigne('=', 50);
+    
+    rendreTexte("\nLegende : [L] Libre  [O] Occupee  [R] Reservee  [X] Hors service\n\n");
+    
+    /* Affichage en grille */
+    for (i = 0; i < parking->nombrePlaces; i += placesParLigne) {
+        /* Numeros des places */
+        rendreTexte("    ");
+        for (j = 0; j < placesParLigne && (i + j) < parking->nombrePlaces; j++) {
+            numeroPlace = i + j + 1;
+            rendreTexte("%3d ", numeroPlace);
+        }
+        rendreTexte("\n");
+        
+        /* Etat des places */
+        rendreTexte("    ");
+        for (j = 0; j < placesParLigne && (i + j) < parking->nombrePlaces; j++) {
+            switch (obtenirPlace(parking, i + j)->etat) {
+                case LIBRE:
+                    symbole = 'L';
+                    break;
+                case OCCUPEE:
+                    symbole = 'O';
+                    break;
+                case RESERVEE:
+                    symbole = 'R';
+                    break;
+                case HORS_SERVICE:
+                    symbole = 'X';
+                    break;
+                default:
+                    symbole = '?';
+            }
+            rendreTexte("[%c] ", symbole);
+        }
+        rendreTexte("\n\n");
+    }
+    
+    rendreLigne('-', 50);
+    rendreTexte("Places libres : %d/%d (%.1f%%)\n",
+                parking->placesLibres,
+                parking->nombrePlaces,
+                (float)parking->placesLibres / parking->nombrePlaces * 100);
+    
+    terminerRendu();
 }
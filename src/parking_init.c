@@ -9,6 +9,8 @@
 #include <string.h>
 #include "../include/parking.h"
 #include "../include/utilitaires.h"
+#include "../include/statistiques.h"
+#include "../include/journal.h"
 #include "../include/prototypes.h"
 
 /* ============================================================================
@@ -18,6 +20,8 @@
 int initialiserParking(Parking *parking, const char *nom, int nombrePlaces)
 {
     int i;
+    int t;
+    int compteurs[5];
     TypeVehicule typePlace;
     
     /* Validation des parametres d'entree */
@@ -25,8 +29,8 @@ int initialiserParking(Parking *parking, const char *nom, int nombrePlaces)
         return 0;
     }
     
-    if (nombrePlaces <= 0 || nombrePlaces > MAX_PLACES) {
-        printf("Erreur : Nombre de places invalide (1-%d).\n", MAX_PLACES);
+    /* Au moins une place */
+    if (nombrePlaces <= 0) {
         return 0;
     }
     
@@ -35,16 +39,39 @@ int initialiserParking(Parking *parking, const char *nom, int nombrePlaces)
     parking->nom[MAX_CHAINE - 1] = '\0';
     
     /* Initialisation des compteurs */
-    parking->nombrePlaces = nombrePlaces;
-    parking->placesLibres = nombrePlaces;
+    parking->nombrePlaces = 0;
+    parking->placesLibres = 0;
     parking->placesOccupees = 0;
     parking->nombreVehicules = 0;
     parking->recetteJournaliere = 0.0f;
     parking->recetteTotale = 0.0f;
     
-    /* Initialisation des places avec repartition par type */
+    /* Stockage vide : il grandit avec le parking et son historique */
+    initialiserArene(&parking->places, sizeof(Place), DECALAGE_BLOC_PLACES);
+    initialiserArene(&parking->historique, sizeof(Vehicule),
+                     DECALAGE_BLOC_HISTORIQUE);
+    
+    for (t = 0; t < 5; t++) {
+        parking->bitmapLibres[t] = NULL;
+        parking->placesLibresParType[t] = 0;
+    }
+    parking->motsBitmap = 0;
+    parking->indexPlaques = NULL;
+    parking->tailleIndex = 0;
+    parking->archive = NULL;
+    parking->journal = NULL;
+    parking->sequenceJournal = 0;
+    parking->projection = NULL;
+    parking->tailleProjection = 0;
+    parking->controle = NULL;
+    initialiserAgregats(parking);
+    
+    /* Repartition : 60% voitures, 20% motos, 10% camions, 10% bus */
+    for (t = 0; t < 5; t++) {
+        compteurs[t] = 0;
+    }
+    
     for (i = 0; i < nombrePlaces; i++) {
-        /* Repartition : 60% voitures, 20% motos, 10% camions, 10% bus */
         if (i < nombrePlaces * 0.6) {
             typePlace = VOITURE;
         } else if (i < nombrePlaces * 0.8) {
@@ -55,13 +82,49 @@ int initialiserParking(Parking *parking, const char *nom, int nombrePlaces)
             typePlace = BUS;
         }
         
-        initialiserPlace(&parking->places[i], i + 1, typePlace);
+        compteurs[typePlace]++;
     }
     
-    /* Initialisation de l'historique */
-    for (i = 0; i < MAX_VEHICULES; i++) {
-        parking->historique[i].estPresent = 0;
-        parking->historique[i].plaque[0] = '\0';
+    /* Les places sont creees par type, dans l'ordre des numeros */
+    for (t = VOITURE; t <= BUS; t++) {
+        if (ajouterPlaces(parking, compteurs[t], (TypeVehicule)t) == 0) {
+            libererParking(parking);
+            return 0;
+        }
+    }
+    
+    return 1;
+}
+
+int ajouterPlaces(Parking *parking, int nombre, TypeVehicule typeAutorise)
+{
+    int i;
+    Place *place;
+    
+    if (parking == NULL || nombre < 0) {
+        return 0;
+    }
+    
+    /* Bitmaps et index d'abord : un echec laisse le parking intact */
+    if (redimensionnerBitmapsPlaces(parking, parking->nombrePlaces + nombre) == 0 ||
+        redimensionnerIndexPlaques(parking, parking->nombrePlaces + nombre) == 0) {
+        return 0;
+    }
+    
+    for (i = 0; i < nombre; i++) {
+        place = (Place*)ajouterElementArene(&parking->places);
+        if (place == NULL) {
+            return 0;
+        }
+        
+        initialiserPlace(place, parking->nombrePlaces + 1, typeAutorise);
+        parking->nombrePlaces++;
+        parking->placesLibres++;
+        
+        /* La place nait libre : l'inscrire dans le bitmap de son type */
+        parking->bitmapLibres[typeAutorise][(parking->nombrePlaces - 1) / 64] |=
+            1ULL << ((parking->nombrePlaces - 1) % 64);
+        parking->placesLibresParType[typeAutorise]++;
     }
     
     return 1;
@@ -81,63 +144,60 @@ void initialiserPlace(Place *place, int numero, TypeVehicule typeAutorise)
 
 void libererParking(Parking *parking)
 {
-    int i;
+    int t;
     
     if (parking == NULL) {
         return;
     }
     
-    /* Liberation des pointeurs de vehicules dans les places */
-    for (i = 0; i < parking->nombrePlaces; i++) {
-        if (parking->places[i].vehiculeActuel != NULL) {
-            parking->places[i].vehiculeActuel = NULL;
-        }
+    /* Liberation du stockage des places et de l'historique */
+    libererArene(&parking->places);
+    libererArene(&parking->historique);
+    libererProjection(parking);
+    libererArchive(parking);
+    fermerJournal(parking);
+    
+    for (t = 0; t < 5; t++) {
+        free(parking->bitmapLibres[t]);
+        parking->bitmapLibres[t] = NULL;
+        parking->placesLibresParType[t] = 0;
     }
+    parking->motsBitmap = 0;
+    
+    free(parking->indexPlaques);
+    parking->indexPlaques = NULL;
+    parking->tailleIndex = 0;
     
     /* Reinitialisation des compteurs */
+    parking->nombrePlaces = 0;
     parking->placesLibres = 0;
     parking->placesOccupees = 0;
     parking->nombreVehicules = 0;
 }
 
 /* ============================================================================
- * AFFICHAGE DES PLACES
+ * ACCES AU STOCKAGE
  * ============================================================================ */
 
-void afficherEtatPlaces(const Parking *parking)
+Place* obtenirPlace(const Parking *parking, int indice)
+{
+    return (Place*)elementArene(&parking->places, indice);
+}
+
+Vehicule* obtenirVehicule(const Parking *parking, int indice)
+{
+    return (Vehicule*)elementArene(&parking->historique, indice);
+}
+
+int ajouterVehiculeHistorique(Parking *parking)
 {
-    int i;
-    const Place *place;
-    
     if (parking == NULL) {
-        return;
+        return -1;
     }
     
-    afficherLigne('=', 70);
-    printf("   ETAT DES PLACES - %s\n", parking->nom);
-    afficherLigne('=', 70);
-    
-    printf("%-8s %-12s %-15s %-20s\n", 
-           "Place", "Etat", "Type autorise", "Vehicule");
-    afficherLigne('-', 70);
-    
-    for (i = 0; i < parking->nombrePlaces; i++) {
-        place = &parking->places[i];
-        
-        printf("%-8d %-12s %-15s ",
-               place->numero,
-               etatPlaceEnChaine(place->etat),
-               typeVehiculeEnChaine(place->typeAutorise));
-        
-        if (place->vehiculeActuel != NULL) {
-            printf("%-20s", place->vehiculeActuel->plaque);
-        } else {
-            printf("%-20s", "-");
-        }
-        printf("\n");
+    if (ajouterElementArene(&parking->historique) == NULL) {
+        return -1;
     }
     
-    afficherLigne('=', 70);
-    printf("Total : %d places | Libres : %d | Occupees : %d\n",
-           parking->nombrePlaces, parking->placesLibres, parking->placesOccupees);
+    return parking->nombreVehicules++;
 }
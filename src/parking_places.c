@@ -9,53 +9,128 @@
 #include <string.h>
 #include "../include/parking.h"
 #include "../include/utilitaires.h"
+#include "../include/instrumentation.h"
+#include "../include/trace.h"
 #include "../include/prototypes.h"
 
 /* ============================================================================
  * GESTION DES PLACES
  * ============================================================================ */
 
-int rechercherPlaceLibre(Parking *parking, TypeVehicule type)
+/**
+ * @brief Indice du bit de poids faible actif d'un mot non nul
+ * @param mot Mot de 64 bits (non nul)
+ * @return Position du premier bit a 1
+ */
+static int premierBitActif(unsigned long long mot)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(mot);
+#else
+    int position;
+    
+    position = 0;
+    while ((mot & 1ULL) == 0) {
+        mot >>= 1;
+        position++;
+    }
+    return position;
+#endif
+}
+
+/**
+ * @brief Parcourt les bitmaps (corps de rechercherPlaceLibre, non mesure)
+ * @return Numero de la premiere place libre adaptee, -1 si aucune
+ */
+static int parcourirPlacesLibres(Parking *parking, TypeVehicule type)
 {
     int i;
-    int placeCompatible;
+    int nombreMots;
+    unsigned long long mot;
     
-    if (parking == NULL) {
+    if (parking == NULL || type < VOITURE || type > BUS) {
         return -1;
     }
     
-    /* Premiere passe : rechercher une place du type exact */
-    for (i = 0; i < parking->nombrePlaces; i++) {
-        if (parking->places[i].etat == LIBRE && 
-            parking->places[i].typeAutorise == type) {
-            return parking->places[i].numero;
+    nombreMots = (parking->nombrePlaces + 63) / 64;
+    
+    /* Premiere recherche : une place du type exact */
+    for (i = 0; i < nombreMots; i++) {
+        mot = parking->bitmapLibres[type][i];
+        if (mot != 0) {
+            return i * 64 + premierBitActif(mot) + 1;
         }
     }
     
-    /* Deuxieme passe : rechercher une place compatible */
-    /* Une moto peut aller sur une place voiture, etc. */
-    placeCompatible = -1;
-    
-    for (i = 0; i < parking->nombrePlaces; i++) {
-        if (parking->places[i].etat == LIBRE) {
-            /* Verifier la compatibilite */
-            if (type == MOTO) {
-                /* Une moto peut aller partout sauf place bus */
-                if (parking->places[i].typeAutorise != BUS) {
-                    placeCompatible = parking->places[i].numero;
-                    break;
-                }
+    /* Une moto peut aller partout sauf place bus : union des masques */
+    if (type == MOTO) {
+        for (i = 0; i < nombreMots; i++) {
+            mot = parking->bitmapLibres[VOITURE][i] |
+                  parking->bitmapLibres[CAMION][i];
+            if (mot != 0) {
+                return i * 64 + premierBitActif(mot) + 1;
             }
         }
     }
     
-    return placeCompatible;
+    return -1;
+}
+
+int rechercherPlaceLibre(Parking *parking, TypeVehicule type)
+{
+    double debut;
+    int numeroPlace;
+    
+    TRACER_DEBUT(TRACE_PLACE_LIBRE);
+    debut = debuterMesure();
+    numeroPlace = parcourirPlacesLibres(parking, type);
+    terminerMesure(MESURE_PLACE_LIBRE, debut,
+                   numeroPlace == -1 ? ERREUR_AUCUNE_PLACE : SUCCES);
+    TRACER_FIN(TRACE_PLACE_LIBRE);
+    
+    return numeroPlace;
 }
 
 int modifierEtatPlace(Parking *parking, int numeroPlace, EtatPlace nouvelEtat)
+{
+    double debut;
+    int resultat;
+    
+    /* Une place n'est occupee que par l'entree d'un vehicule, comme dans
+     * etatPlaceConcurrent */
+    if (parking == NULL || nouvelEtat < LIBRE || nouvelEtat > HORS_SERVICE ||
+        nouvelEtat == OCCUPEE) {
+        return ERREUR_PARAMETRE;
+    }
+    
+    debut = debuterMesure();
+    resultat = SUCCES;
+    
+    /* Une place occupee ne se libere que par la sortie de son vehicule */
+    if (numeroPlace < 1 || numeroPlace > parking->nombrePlaces) {
+        resultat = ERREUR_PLACE_INVALIDE;
+    } else if (obtenirPlace(parking, numeroPlace - 1)->etat == OCCUPEE) {
+        resultat = ERREUR_PLACE_OCCUPEE;
+    } else {
+        /* Ecriture anticipee, comme les entrees et sorties */
+        resultat = journaliserEtatPlace(parking, numeroPlace, nouvelEtat);
+        if (resultat == SUCCES) {
+            appliquerEtatPlace(parking, numeroPlace, nouvelEtat);
+        }
+    }
+    
+    terminerMesure(MESURE_ETAT_PLACE, debut, resultat);
+    
+    return resultat;
+}
+
+int appliquerEtatPlace(Parking *parking, int numeroPlace, EtatPlace nouvelEtat)
 {
     int indice;
+    Place *place;
     EtatPlace ancienEtat;
+    TypeVehicule type;
+    unsigned long long bit;
     
     if (parking == NULL) {
         return 0;
@@ -63,12 +138,12 @@ int modifierEtatPlace(Parking *parking, int numeroPlace, EtatPlace nouvelEtat)
     
     /* Validation du numero de place */
     if (numeroPlace < 1 || numeroPlace > parking->nombrePlaces) {
-        printf("Erreur : Numero de place invalide.\n");
         return 0;
     }
     
     indice = numeroPlace - 1;
-    ancienEtat = parking->places[indice].etat;
+    place = obtenirPlace(parking, indice);
+    ancienEtat = place->etat;
     
     /* Mise a jour des compteurs */
     if (ancienEtat == LIBRE && nouvelEtat == OCCUPEE) {
@@ -79,71 +154,99 @@ int modifierEtatPlace(Parking *parking, int numeroPlace, EtatPlace nouvelEtat)
         parking->placesOccupees--;
     }
     
-    parking->places[indice].etat = nouvelEtat;
+    /* Mise a jour du bitmap des places libres du type */
+    type = place->typeAutorise;
+    bit = 1ULL << (indice % 64);
+    
+    if (ancienEtat == LIBRE && nouvelEtat != LIBRE) {
+        parking->bitmapLibres[type][indice / 64] &= ~bit;
+        parking->placesLibresParType[type]--;
+    } else if (ancienEtat != LIBRE && nouvelEtat == LIBRE) {
+        parking->bitmapLibres[type][indice / 64] |= bit;
+        parking->placesLibresParType[type]++;
+    }
+    
+    place->etat = nouvelEtat;
     
     return 1;
 }
 
-void afficherCartePaking(const Parking *parking)
+/**
+ * @brief Agrandit les bitmaps de places libres pour une nouvelle capacite
+ * @param parking Pointeur vers le parking
+ * @param nombrePlaces Nombre de places a couvrir
+ * @return 1 si succes, 0 si memoire insuffisante
+ */
+int redimensionnerBitmapsPlaces(Parking *parking, int nombrePlaces)
 {
+    int t;
     int i;
-    int j;
-    int placesParLigne;
-    int numeroPlace;
-    char symbole;
+    int mots;
+    unsigned long long *bitmap;
     
     if (parking == NULL) {
-        return;
+        return 0;
     }
     
-    placesParLigne = 10;
-    
-    printf("\n");
-    afficherLigne('=', 50);
-    printf("      CARTE DU PARKING : %s\n", parking->nom);
-    afficherLigne('=', 50);
+    mots = (nombrePlaces + 63) / 64;
+    if (mots <= parking->motsBitmap) {
+        return 1;
+    }
     
-    printf("\nLegende : [L] Libre  [O] Occupee  [R] Reservee  [X] Hors service\n\n");
+    /* Marge pour eviter une reallocation a chaque place ajoutee */
+    if (mots < parking->motsBitmap * 2) {
+        mots = parking->motsBitmap * 2;
+    }
     
-    /* Affichage en grille */
-    for (i = 0; i < parking->nombrePlaces; i += placesParLigne) {
-        /* Numeros des places */
-        printf("    ");
-        for (j = 0; j < placesParLigne && (i + j) < parking->nombrePlaces; j++) {
-            numeroPlace = i + j + 1;
-            printf("%3d ", numeroPlace);
+    for (t = 0; t < 5; t++) {
+        bitmap = (unsigned long long*)realloc(parking->bitmapLibres[t],
+                                              mots * sizeof(unsigned long long));
+        if (bitmap == NULL) {
+            return 0;
         }
-        printf("\n");
         
-        /* Etat des places */
-        printf("    ");
-        for (j = 0; j < placesParLigne && (i + j) < parking->nombrePlaces; j++) {
-            switch (parking->places[i + j].etat) {
-                case LIBRE:
-                    symbole = 'L';
-                    break;
-                case OCCUPEE:
-                    symbole = 'O';
-                    break;
-                case RESERVEE:
-                    symbole = 'R';
-                    break;
-                case HORS_SERVICE:
-                    symbole = 'X';
-                    break;
-                default:
-                    symbole = '?';
-            }
-            printf("[%c] ", symbole);
+        for (i = parking->motsBitmap; i < mots; i++) {
+            bitmap[i] = 0;
+        }
+        parking->bitmapLibres[t] = bitmap;
+    }
+    
+    parking->motsBitmap = mots;
+    
+    return 1;
+}
+
+/**
+ * @brief Reconstruit les bitmaps et compteurs de places libres par type
+ * @param parking Pointeur vers le parking
+ */
+void reconstruireBitmapsPlaces(Parking *parking)
+{
+    int i;
+    int t;
+    const Place *place;
+    
+    if (parking == NULL) {
+        return;
+    }
+    
+    for (t = 0; t < 5; t++) {
+        parking->placesLibresParType[t] = 0;
+        for (i = 0; i < parking->motsBitmap; i++) {
+            parking->bitmapLibres[t][i] = 0;
         }
-        printf("\n\n");
     }
     
-    afficherLigne('-', 50);
-    printf("Places libres : %d/%d (%.1f%%)\n",
-           parking->placesLibres,
-           parking->nombrePlaces,
-           (float)parking->placesLibres / parking->nombrePlaces * 100);
+    for (i = 0; i < parking->nombrePlaces; i++) {
+        place = obtenirPlace(parking, i);
+        
+        if (place->etat == LIBRE &&
+            place->typeAutorise >= VOITURE && place->typeAutorise <= BUS) {
+            parking->bitmapLibres[place->typeAutorise][i / 64] |=
+                1ULL << (i % 64);
+            parking->placesLibresParType[place->typeAutorise]++;
+        }
+    }
 }
 
 /**
@@ -162,7 +265,7 @@ Place* obtenirPlaceParNumero(Parking *parking, int numero)
         return NULL;
     }
     
-    return &parking->places[numero - 1];
+    return obtenirPlace(parking, numero - 1);
 }
 
 /**
@@ -173,21 +276,10 @@ Place* obtenirPlaceParNumero(Parking *parking, int numero)
  */
 int compterPlacesLibresParType(const Parking *parking, TypeVehicule type)
 {
-    int i;
-    int compteur;
-    
-    if (parking == NULL) {
+    if (parking == NULL || type < VOITURE || type > BUS) {
         return 0;
     }
     
-    compteur = 0;
-    
-    for (i = 0; i < parking->nombrePlaces; i++) {
-        if (parking->places[i].etat == LIBRE &&
-            parking->places[i].typeAutorise == type) {
-            compteur++;
-        }
-    }
-    
-    return compteur;
+    /* Compteur maintenu par modifierEtatPlace */
+    return parking->placesLibresParType[type];
 }
@@ -7,50 +7,97 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <assert.h>
 #include "../include/parking.h"
 #include "../include/utilitaires.h"
+#include "../include/tarification.h"
+#include "../include/statistiques.h"
+#include "../include/instrumentation.h"
+#include "../include/trace.h"
 #include "../include/prototypes.h"
 
 /* ============================================================================
  * GESTION DES ENTREES ET SORTIES
  * ============================================================================ */
 
-int enregistrerEntree(Parking *parking, const char *plaque, 
-                      const char *proprietaire, TypeVehicule type)
+/**
+ * @brief Enregistre une entree (corps de enregistrerEntree, non mesure)
+ * @return Numero de la place attribuee, ou code d'erreur negatif
+ */
+static int entrerVehicule(Parking *parking, const char *plaque,
+                          const char *proprietaire, TypeVehicule type)
 {
     int numeroPlace;
-    int indicePlace;
     int indiceVehicule;
-    Vehicule *vehicule;
+    int resultat;
+    Horodatage entree;
     
     /* Validation des parametres */
     if (parking == NULL || plaque == NULL || proprietaire == NULL) {
-        return -1;
+        return ERREUR_PARAMETRE;
     }
     
     /* Verifier si le vehicule n'est pas deja present */
     if (rechercherVehicule(parking, plaque) != NULL) {
-        printf("Erreur : Ce vehicule est deja dans le parking.\n");
-        return -1;
+        return ERREUR_DEJA_PRESENT;
     }
     
     /* Rechercher une place libre */
     numeroPlace = rechercherPlaceLibre(parking, type);
     
     if (numeroPlace == -1) {
-        printf("Erreur : Aucune place disponible pour ce type de vehicule.\n");
-        return -1;
+        return ERREUR_AUCUNE_PLACE;
     }
     
-    /* Verifier la capacite de l'historique */
-    if (parking->nombreVehicules >= MAX_VEHICULES) {
-        printf("Erreur : Historique des vehicules plein.\n");
+    /* Ecriture anticipee : une entree absente du journal est refusee */
+    entree = obtenirHorodatageActuel();
+    resultat = journaliserEntree(parking, plaque, proprietaire, type,
+                                 numeroPlace, entree);
+    if (resultat != SUCCES) {
+        return resultat;
+    }
+    
+    indiceVehicule = appliquerEntree(parking, plaque, proprietaire, type,
+                                     numeroPlace, entree);
+    
+    if (indiceVehicule == -1) {
+        annulerDernierEnregistrement(parking);
+        return ERREUR_MEMOIRE;
+    }
+    
+    return numeroPlace;
+}
+
+int enregistrerEntree(Parking *parking, const char *plaque, 
+                      const char *proprietaire, TypeVehicule type)
+{
+    double debut;
+    int resultat;
+    
+    TRACER_DEBUT(TRACE_ENTREE);
+    debut = debuterMesure();
+    resultat = entrerVehicule(parking, plaque, proprietaire, type);
+    terminerMesure(MESURE_ENTREE, debut, resultat > 0 ? SUCCES : resultat);
+    TRACER_FIN(TRACE_ENTREE);
+    
+    return resultat;
+}
+
+int appliquerEntree(Parking *parking, const char *plaque,
+                    const char *proprietaire, TypeVehicule type,
+                    int numeroPlace, Horodatage entree)
+{
+    int indiceVehicule;
+    Vehicule *vehicule;
+    
+    /* Creer l'enregistrement du vehicule (l'historique s'agrandit) */
+    indiceVehicule = ajouterVehiculeHistorique(parking);
+    
+    if (indiceVehicule == -1) {
         return -1;
     }
     
-    /* Creer l'enregistrement du vehicule */
-    indiceVehicule = parking->nombreVehicules;
-    vehicule = &parking->historique[indiceVehicule];
+    vehicule = obtenirVehicule(parking, indiceVehicule);
     
     strncpy(vehicule->plaque, plaque, TAILLE_PLAQUE - 1);
     vehicule->plaque[TAILLE_PLAQUE - 1] = '\0';
@@ -59,70 +106,111 @@ int enregistrerEntree(Parking *parking, const char *plaque,
     vehicule->proprietaire[MAX_CHAINE - 1] = '\0';
     
     vehicule->type = type;
-    vehicule->entree = obtenirHorodatageActuel();
+    vehicule->entree = entree;
+    vehicule->numeroPlace = numeroPlace;
     vehicule->estPresent = 1;
     vehicule->montantPaye = 0.0f;
     
     /* Associer le vehicule a la place */
-    indicePlace = numeroPlace - 1;
-    parking->places[indicePlace].vehiculeActuel = vehicule;
-    modifierEtatPlace(parking, numeroPlace, OCCUPEE);
+    obtenirPlace(parking, numeroPlace - 1)->vehiculeActuel = vehicule;
+    appliquerEtatPlace(parking, numeroPlace, OCCUPEE);
     
-    /* Incrementer le compteur */
-    parking->nombreVehicules++;
+    /* Indexer la plaque et comptabiliser l'entree */
+    indexerVehicule(parking, indiceVehicule);
+    comptabiliserEntree(parking, vehicule);
     
-    return numeroPlace;
+    return indiceVehicule;
 }
 
-float enregistrerSortie(Parking *parking, const char *plaque)
+/**
+ * @brief Enregistre une sortie (corps de enregistrerSortie, non mesure)
+ * @return SUCCES ou code d'erreur negatif
+ */
+static int sortirVehicule(Parking *parking, const char *plaque,
+                          float *montant)
 {
-    int numeroPlace;
-    int indicePlace;
     int dureeMinutes;
-    float montant;
+    int resultat;
+    float aPayer;
+    Horodatage sortie;
     Vehicule *vehicule;
     
     /* Validation des parametres */
     if (parking == NULL || plaque == NULL) {
-        return -1.0f;
+        return ERREUR_PARAMETRE;
     }
     
     /* Rechercher le vehicule */
     vehicule = rechercherVehicule(parking, plaque);
     
     if (vehicule == NULL) {
-        printf("Erreur : Vehicule non trouve dans le parking.\n");
-        return -1.0f;
+        return ERREUR_VEHICULE_ABSENT;
     }
     
     if (vehicule->estPresent == 0) {
-        printf("Erreur : Ce vehicule a deja quitte le parking.\n");
-        return -1.0f;
+        return ERREUR_DEJA_SORTI;
     }
     
-    /* Enregistrer l'heure de sortie */
-    vehicule->sortie = obtenirHorodatageActuel();
-    
     /* Calculer le montant a payer */
-    dureeMinutes = calculerDureeMinutes(vehicule->entree, vehicule->sortie);
-    montant = calculerMontant(dureeMinutes, vehicule->type);
+    sortie = obtenirHorodatageActuel();
+    dureeMinutes = calculerDureeMinutes(vehicule->entree, sortie);
+    aPayer = calculerMontantSejour(vehicule->entree, dureeMinutes,
+                                   vehicule->type);
     
+    resultat = journaliserSortie(parking, vehicule, sortie, aPayer);
+    if (resultat != SUCCES) {
+        return resultat;
+    }
+    appliquerSortie(parking, vehicule, sortie, aPayer);
+    
+    if (montant != NULL) {
+        *montant = aPayer;
+    }
+    
+    return SUCCES;
+}
+
+int enregistrerSortie(Parking *parking, const char *plaque, float *montant)
+{
+    double debut;
+    int resultat;
+    
+    TRACER_DEBUT(TRACE_SORTIE);
+    debut = debuterMesure();
+    resultat = sortirVehicule(parking, plaque, montant);
+    terminerMesure(MESURE_SORTIE, debut, resultat);
+    TRACER_FIN(TRACE_SORTIE);
+    
+    return resultat;
+}
+
+void appliquerSortie(Parking *parking, Vehicule *vehicule,
+                     Horodatage sortie, float montant)
+{
+    int numeroPlace;
+    
+    vehicule->sortie = sortie;
     vehicule->montantPaye = montant;
     vehicule->estPresent = 0;
+    retirerIndexPlaque(parking, vehicule->plaque);
     
-    /* Liberer la place */
-    numeroPlace = rechercherPlaceParVehicule(parking, plaque);
-    if (numeroPlace != -1) {
-        indicePlace = numeroPlace - 1;
-        parking->places[indicePlace].vehiculeActuel = NULL;
-        modifierEtatPlace(parking, numeroPlace, LIBRE);
+    /* Liberer la place memorisee a l'entree, si elle porte bien ce
+     * vehicule (meme controle que ecrireSauvegarde) */
+    numeroPlace = vehicule->numeroPlace;
+    if (numeroPlace >= 1 && numeroPlace <= parking->nombrePlaces &&
+        obtenirPlace(parking, numeroPlace - 1)->vehiculeActuel == vehicule) {
+#ifdef PARKING_DEBUG
+        assert(rechercherPlaceParVehiculeLineaire(parking, vehicule->plaque) ==
+               numeroPlace);
+#endif
+        obtenirPlace(parking, numeroPlace - 1)->vehiculeActuel = NULL;
+        appliquerEtatPlace(parking, numeroPlace, LIBRE);
     }
     
     /* Mettre a jour les recettes */
     parking->recetteJournaliere += montant;
     parking->recetteTotale += montant;
-    
-    return montant;
+    comptabiliserSortie(parking, vehicule);
 }
 
 /* ============================================================================
@@ -131,36 +219,69 @@ float enregistrerSortie(Parking *parking, const char *plaque)
 
 Vehicule* rechercherVehicule(Parking *parking, const char *plaque)
 {
-    int i;
+    double debut;
+    int indice;
     
     if (parking == NULL || plaque == NULL) {
         return NULL;
     }
     
-    for (i = 0; i < parking->nombreVehicules; i++) {
-        if (parking->historique[i].estPresent == 1 &&
-            strcmp(parking->historique[i].plaque, plaque) == 0) {
-            return &parking->historique[i];
-        }
+    /* Seuls les vehicules presents sont indexes */
+    debut = debuterMesure();
+    indice = rechercherIndexPlaque(parking, plaque);
+    terminerMesure(MESURE_RECHERCHE_VEHICULE, debut,
+                   indice == -1 ? ERREUR_VEHICULE_ABSENT : SUCCES);
+    
+    if (indice == -1) {
+        return NULL;
     }
     
-    return NULL;
+    return obtenirVehicule(parking, indice);
 }
 
 int rechercherPlaceParVehicule(Parking *parking, const char *plaque)
+{
+    Vehicule *vehicule;
+    
+    vehicule = rechercherVehicule(parking, plaque);
+    
+    if (vehicule == NULL) {
+        return -1;
+    }
+    
+#ifdef PARKING_DEBUG
+    assert(rechercherPlaceParVehiculeLineaire(parking, plaque) ==
+           vehicule->numeroPlace);
+#endif
+    
+    return vehicule->numeroPlace;
+}
+
+#ifdef PARKING_DEBUG
+/**
+ * @brief Parcours lineaire des places, reserve aux verifications de coherence
+ * @param parking Pointeur vers le parking
+ * @param plaque Plaque du vehicule
+ * @return Numero de la place, -1 si non trouve
+ */
+int rechercherPlaceParVehiculeLineaire(const Parking *parking,
+                                       const char *plaque)
 {
     int i;
+    const Place *place;
     
     if (parking == NULL || plaque == NULL) {
         return -1;
     }
     
     for (i = 0; i < parking->nombrePlaces; i++) {
-        if (parking->places[i].vehiculeActuel != NULL &&
-            strcmp(parking->places[i].vehiculeActuel->plaque, plaque) == 0) {
-            return parking->places[i].numero;
+        place = obtenirPlace(parking, i);
+        if (place->vehiculeActuel != NULL &&
+            plaquesEquivalentes(place->vehiculeActuel->plaque, plaque)) {
+            return place->numero;
         }
     }
     
     return -1;
 }
+#endif
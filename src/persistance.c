@@ -0,0 +1,1132 @@
+/**
+ * @file persistance.c
+ * @brief Implementation de la sauvegarde et du chargement du parking
+ * @date Decembre 2025
+ *
+ * Le fichier ne contient aucun pointeur : les liens place -> vehicule
+ * sont des indices dans l'historique. L'historique commence a une
+ * frontiere de page et garde la disposition des blocs de l'arene.
+ *
+ * Sous POSIX, le fichier est projete en memoire (copie privee) : les
+ * blocs complets de l'historique sont utilises sur place et leurs pages
+ * ne sont lues qu'a la premiere consultation. Chaque bloc a sa propre
+ * somme de controle, verifiee a ce premier acces : au chargement, seuls
+ * les blocs des vehicules presents sont lus et controles. Ailleurs, ou
+ * si la projection echoue, le fichier est lu d'un seul bloc et controle
+ * en entier.
+ *
+ * Les sauvegardes periodiques sont ecrites par un processus enfant
+ * (fork) qui travaille sur une copie figee de la memoire : la boucle
+ * principale continue de traiter entrees et sorties pendant l'ecriture.
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#else
+#include <io.h>
+#endif
+#include <time.h>
+#include "../include/persistance.h"
+#include "../include/parking.h"
+#include "../include/journal.h"
+#include "../include/trace.h"
+#include "../include/prototypes.h"
+
+/** Signature des fichiers de sauvegarde ("PARK") */
+#define SIGNATURE_SAUVEGARDE 0x4B524150u
+
+/** Version courante du format de sauvegarde */
+#define VERSION_SAUVEGARDE 5u
+
+/** Alignement du debut de l'historique dans le fichier (une page) */
+#define ALIGNEMENT_HISTORIQUE 4096
+
+/** Nombre de vehicules par bloc de l'historique */
+#define VEHICULES_PAR_BLOC (1 << DECALAGE_BLOC_HISTORIQUE)
+
+/* ============================================================================
+ * SOMME DE CONTROLE CRC32C
+ * ============================================================================ */
+
+/** Polynome de Castagnoli, forme reflechie */
+#define POLYNOME_CRC32C 0x82F63B78u
+
+/** Table de calcul octet par octet, construite au premier appel */
+static uint32_t tableCrc32c[256];
+static int tableCrc32cPrete = 0;
+
+/**
+ * @brief Construit la table du CRC32C
+ */
+static void construireTableCrc32c(void)
+{
+    uint32_t valeur;
+    int i;
+    int bit;
+
+    for (i = 0; i < 256; i++) {
+        valeur = (uint32_t)i;
+        for (bit = 0; bit < 8; bit++) {
+            valeur = (valeur & 1u) ? (valeur >> 1) ^ POLYNOME_CRC32C :
+                                     valeur >> 1;
+        }
+        tableCrc32c[i] = valeur;
+    }
+
+    tableCrc32cPrete = 1;
+}
+
+uint32_t calculerCrc32c(uint32_t crc, const void *donnees, size_t taille)
+{
+    const unsigned char *octets;
+    size_t i;
+
+    if (tableCrc32cPrete == 0) {
+        construireTableCrc32c();
+    }
+
+    octets = (const unsigned char*)donnees;
+    crc = ~crc;
+
+    for (i = 0; i < taille; i++) {
+        crc = tableCrc32c[(crc ^ octets[i]) & 0xFFu] ^ (crc >> 8);
+    }
+
+    return ~crc;
+}
+
+/* ============================================================================
+ * ECRITURE SUR DISQUE
+ * ============================================================================ */
+
+int synchroniserFlux(FILE *flux)
+{
+    if (flux == NULL || fflush(flux) != 0) {
+        return 0;
+    }
+
+#ifdef _WIN32
+    return _commit(_fileno(flux)) == 0;
+#else
+    return fsync(fileno(flux)) == 0;
+#endif
+}
+
+/* ============================================================================
+ * FORMAT DU FICHIER
+ * ============================================================================ */
+
+/**
+ * @struct EnteteSauvegarde
+ * @brief En-tete du fichier de sauvegarde
+ *
+ * Les tailles d'enregistrement permettent de refuser un fichier ecrit
+ * par une version du programme dont les structures different. L'en-tete
+ * est suivi des places, des indices des vehicules presents et de la
+ * somme de controle de chaque bloc de l'historique en memoire, tous
+ * couverts par crcPlaces.
+ */
+typedef struct {
+    uint32_t signature;
+    uint32_t version;
+    uint32_t tailleEntete;
+    uint32_t taillePlace;
+    uint32_t tailleVehicule;
+    uint32_t vehiculesParBloc;
+    char nom[MAX_CHAINE];
+    int32_t nombrePlaces;
+    int32_t placesLibres;
+    int32_t placesOccupees;
+    int32_t nombreVehicules;
+    int32_t premierVehicule;
+    int32_t nombrePresents;
+    char fichierArchive[MAX_CHEMIN];
+    float recetteJournaliere;
+    float recetteTotale;
+    AgregatsParking agregats;
+    uint32_t sequenceJournal;
+    uint32_t positionHistorique;
+    uint32_t crcPlaces;
+    uint32_t crcEntete;
+} EnteteSauvegarde;
+
+/**
+ * @struct PlaceSauvegarde
+ * @brief Place telle qu'ecrite sur disque : le vehicule est un indice
+ */
+typedef struct {
+    int32_t numero;
+    int32_t etat;
+    int32_t typeAutorise;
+    int32_t indiceVehicule;
+} PlaceSauvegarde;
+
+/**
+ * @brief Somme de controle de l'en-tete (champ crcEntete exclu)
+ * @param entete En-tete a controler
+ * @return CRC32C des octets precedant crcEntete
+ */
+static uint32_t crcEntete(const EnteteSauvegarde *entete)
+{
+    return calculerCrc32c(0, entete, offsetof(EnteteSauvegarde, crcEntete));
+}
+
+/**
+ * @brief Nombre de blocs de l'historique en memoire
+ * @param premierVehicule Premier vehicule en memoire (debut de bloc)
+ * @param nombreVehicules Nombre total de vehicules
+ * @return Blocs complets, plus le bloc de queue s'il est entame
+ */
+static int blocsEnMemoire(int premierVehicule, int nombreVehicules)
+{
+    return (nombreVehicules - premierVehicule + VEHICULES_PAR_BLOC - 1) /
+           VEHICULES_PAR_BLOC;
+}
+
+/**
+ * @brief Position de l'historique dans le fichier
+ * @param nombrePlaces Nombre de places ecrites avant l'historique
+ * @param nombrePresents Nombre d'indices de vehicules presents
+ * @param nombreBlocs Nombre de sommes de controle de blocs
+ * @return Premiere frontiere de page apres l'en-tete, les places, les
+ *         indices des vehicules presents et les sommes des blocs
+ */
+static size_t positionHistorique(int nombrePlaces, int nombrePresents,
+                                 int nombreBlocs)
+{
+    size_t fin;
+
+    fin = sizeof(EnteteSauvegarde) +
+          (size_t)nombrePlaces * sizeof(PlaceSauvegarde) +
+          (size_t)nombrePresents * sizeof(int32_t) +
+          (size_t)nombreBlocs * sizeof(uint32_t);
+
+    return (fin + ALIGNEMENT_HISTORIQUE - 1) /
+           ALIGNEMENT_HISTORIQUE * ALIGNEMENT_HISTORIQUE;
+}
+
+/**
+ * @brief Nombre de vehicules contigus en memoire a partir d'un indice
+ * @param parking Pointeur vers le parking
+ * @param indice Indice du premier vehicule
+ * @return Vehicules jusqu'a la fin du bloc ou de l'historique
+ */
+static int vehiculesContigus(const Parking *parking, int indice)
+{
+    int fin;
+
+    fin = (indice | (VEHICULES_PAR_BLOC - 1)) + 1;
+    if (fin > parking->nombreVehicules) {
+        fin = parking->nombreVehicules;
+    }
+
+    return fin - indice;
+}
+
+/**
+ * @brief Somme attendue d'un bloc emprunte a la projection et pas encore
+ *        reconnu intact
+ * @param parking Pointeur vers le parking
+ * @param bloc Numero du bloc dans l'arene d'historique
+ * @return Somme lue au chargement, NULL si le bloc a ete controle intact
+ *         ou ne vient pas de la projection
+ */
+static const uint32_t* crcEnAttente(const Parking *parking, int bloc)
+{
+    const ControleHistorique *controle;
+
+    controle = parking->controle;
+    if (controle == NULL || bloc < controle->premierBloc ||
+        bloc >= controle->premierBloc + controle->nombreBlocs ||
+        controle->etats[bloc - controle->premierBloc] == 1) {
+        return NULL;
+    }
+
+    return &controle->crcBlocs[bloc - controle->premierBloc];
+}
+
+/* ============================================================================
+ * SAUVEGARDE
+ * ============================================================================ */
+
+/**
+ * @brief Ecrit la sauvegarde dans un fichier temporaire puis la renomme
+ * @param parking Pointeur vers le parking
+ * @param nomFichier Nom du fichier de sauvegarde
+ * @return SUCCES, ERREUR_PARAMETRE, ERREUR_MEMOIRE ou ERREUR_ENTREE_SORTIE
+ */
+static int ecrireSauvegarde(const Parking *parking, const char *nomFichier)
+{
+    FILE *fichier;
+    char nomTemporaire[MAX_CHEMIN + 8];
+    static const char zeros[ALIGNEMENT_HISTORIQUE] = { 0 };
+    int i;
+    int n;
+    int bloc;
+    int debut;
+    int erreur;
+    int premier;
+    int nombrePresents;
+    int nombreBlocs;
+    size_t remplissage;
+    EnteteSauvegarde entete;
+    PlaceSauvegarde *places;
+    int32_t *presents;
+    uint32_t *crcBlocs;
+    const uint32_t *attendu;
+    const Place *place;
+    const Vehicule *vehicule;
+
+    if (parking == NULL || nomFichier == NULL ||
+        strlen(nomFichier) >= MAX_CHEMIN) {
+        return ERREUR_PARAMETRE;
+    }
+
+    premier = premierVehiculeEnMemoire(parking);
+    nombreBlocs = blocsEnMemoire(premier, parking->nombreVehicules);
+
+    places = (PlaceSauvegarde*)malloc((parking->nombrePlaces + 1) *
+                                      sizeof(PlaceSauvegarde));
+    presents = (int32_t*)malloc((parking->nombreVehicules - premier + 1) *
+                                sizeof(int32_t));
+    crcBlocs = (uint32_t*)malloc((nombreBlocs + 1) * sizeof(uint32_t));
+    if (places == NULL || presents == NULL || crcBlocs == NULL) {
+        free(places);
+        free(presents);
+        free(crcBlocs);
+        return ERREUR_MEMOIRE;
+    }
+
+    /* Les pointeurs vers l'historique sont remplaces par des indices */
+    memset(places, 0, parking->nombrePlaces * sizeof(PlaceSauvegarde));
+    for (i = 0; i < parking->nombrePlaces; i++) {
+        place = obtenirPlace(parking, i);
+        places[i].numero = place->numero;
+        places[i].etat = place->etat;
+        places[i].typeAutorise = place->typeAutorise;
+        places[i].indiceVehicule = -1;
+    }
+
+    /* Vehicules presents : indexes au chargement sans lire l'historique ;
+     * une somme de controle par bloc */
+    nombrePresents = 0;
+
+    for (bloc = 0; bloc < nombreBlocs; bloc++) {
+        debut = premier + bloc * VEHICULES_PAR_BLOC;
+
+        /* Bloc non controle depuis le chargement : inchange et sans
+         * vehicule present, sa somme est reprise (corrompu, il le reste
+         * aux yeux du prochain chargement) */
+        attendu = crcEnAttente(parking, debut >> DECALAGE_BLOC_HISTORIQUE);
+        if (attendu != NULL) {
+            crcBlocs[bloc] = *attendu;
+            continue;
+        }
+
+        n = vehiculesContigus(parking, debut);
+        crcBlocs[bloc] = calculerCrc32c(0, obtenirVehicule(parking, debut),
+                                        (size_t)n * sizeof(Vehicule));
+
+        for (i = debut; i < debut + n; i++) {
+            vehicule = obtenirVehicule(parking, i);
+            if (vehicule->estPresent == 0) {
+                continue;
+            }
+            presents[nombrePresents++] = i;
+            /* Une place liberee par modifierEtatPlace ne designe plus son
+             * ancien occupant */
+            place = (vehicule->numeroPlace >= 1 &&
+                     vehicule->numeroPlace <= parking->nombrePlaces) ?
+                    obtenirPlace(parking, vehicule->numeroPlace - 1) : NULL;
+            if (place != NULL && place->vehiculeActuel == vehicule) {
+                places[vehicule->numeroPlace - 1].indiceVehicule = i;
+            }
+        }
+    }
+
+    /* En-tete complet, octets de remplissage compris (mis a zero) */
+    memset(&entete, 0, sizeof(entete));
+    entete.signature = SIGNATURE_SAUVEGARDE;
+    entete.version = VERSION_SAUVEGARDE;
+    entete.tailleEntete = sizeof(EnteteSauvegarde);
+    entete.taillePlace = sizeof(PlaceSauvegarde);
+    entete.tailleVehicule = sizeof(Vehicule);
+    entete.vehiculesParBloc = VEHICULES_PAR_BLOC;
+    strcpy(entete.nom, parking->nom);
+    entete.nombrePlaces = parking->nombrePlaces;
+    entete.placesLibres = parking->placesLibres;
+    entete.placesOccupees = parking->placesOccupees;
+    entete.nombreVehicules = parking->nombreVehicules;
+    entete.premierVehicule = premier;
+    entete.nombrePresents = nombrePresents;
+    if (parking->archive != NULL) {
+        strcpy(entete.fichierArchive, parking->archive->fichier);
+    }
+    entete.recetteJournaliere = parking->recetteJournaliere;
+    entete.recetteTotale = parking->recetteTotale;
+    entete.agregats = parking->agregats;
+    entete.sequenceJournal = parking->sequenceJournal;
+    entete.positionHistorique = (uint32_t)positionHistorique(
+                                    parking->nombrePlaces, nombrePresents,
+                                    nombreBlocs);
+    entete.crcPlaces = calculerCrc32c(0, places, parking->nombrePlaces *
+                                      sizeof(PlaceSauvegarde));
+    entete.crcPlaces = calculerCrc32c(entete.crcPlaces, presents,
+                                      nombrePresents * sizeof(int32_t));
+    entete.crcPlaces = calculerCrc32c(entete.crcPlaces, crcBlocs,
+                                      nombreBlocs * sizeof(uint32_t));
+    entete.crcEntete = crcEntete(&entete);
+
+    /* Ecriture dans un fichier temporaire, renomme une fois complet :
+     * une sauvegarde interrompue ou projetee en memoire reste intacte */
+    sprintf(nomTemporaire, "%s.tmp", nomFichier);
+
+    fichier = fopen(nomTemporaire, "wb");
+    if (fichier == NULL) {
+        free(places);
+        free(presents);
+        free(crcBlocs);
+        return ERREUR_ENTREE_SORTIE;
+    }
+
+    erreur = fwrite(&entete, sizeof(entete), 1, fichier) != 1;
+
+    if (erreur == 0) {
+        erreur = fwrite(places, sizeof(PlaceSauvegarde),
+                        (size_t)parking->nombrePlaces, fichier) !=
+                 (size_t)parking->nombrePlaces;
+    }
+
+    if (erreur == 0 && nombrePresents > 0) {
+        erreur = fwrite(presents, sizeof(int32_t), (size_t)nombrePresents,
+                        fichier) != (size_t)nombrePresents;
+    }
+
+    if (erreur == 0 && nombreBlocs > 0) {
+        erreur = fwrite(crcBlocs, sizeof(uint32_t), (size_t)nombreBlocs,
+                        fichier) != (size_t)nombreBlocs;
+    }
+
+    remplissage = entete.positionHistorique - sizeof(EnteteSauvegarde) -
+                  (size_t)parking->nombrePlaces * sizeof(PlaceSauvegarde) -
+                  (size_t)nombrePresents * sizeof(int32_t) -
+                  (size_t)nombreBlocs * sizeof(uint32_t);
+    if (erreur == 0 && remplissage > 0) {
+        erreur = fwrite(zeros, 1, remplissage, fichier) != remplissage;
+    }
+
+    /* Historique ecrit par blocs contigus */
+    for (i = premier; i < parking->nombreVehicules && erreur == 0; i += n) {
+        n = vehiculesContigus(parking, i);
+        erreur = fwrite(obtenirVehicule(parking, i), sizeof(Vehicule),
+                        (size_t)n, fichier) != (size_t)n;
+    }
+
+    free(places);
+    free(presents);
+    free(crcBlocs);
+
+    /* Donnees sur disque avant le renommage : le journal peut ensuite
+     * etre compacte sans risque */
+    erreur = erreur || synchroniserFlux(fichier) == 0;
+
+    if (fclose(fichier) != 0 || erreur) {
+        remove(nomTemporaire);
+        return ERREUR_ENTREE_SORTIE;
+    }
+
+#ifdef _WIN32
+    remove(nomFichier);
+#endif
+    if (rename(nomTemporaire, nomFichier) != 0) {
+        remove(nomTemporaire);
+        return ERREUR_ENTREE_SORTIE;
+    }
+
+    return SUCCES;
+}
+
+int sauvegarderDonnees(const Parking *parking, const char *nomFichier)
+{
+    int resultat;
+
+    if (parking == NULL || nomFichier == NULL) {
+        return ERREUR_PARAMETRE;
+    }
+
+    /* Une sauvegarde en arriere-plan utilise le meme fichier temporaire */
+    attendreSauvegardeAsynchrone(NULL);
+
+    TRACER_DEBUT(TRACE_SAUVEGARDE);
+    resultat = ecrireSauvegarde(parking, nomFichier);
+    TRACER_FIN(TRACE_SAUVEGARDE);
+
+    return resultat;
+}
+
+/* ============================================================================
+ * SAUVEGARDE EN ARRIERE-PLAN
+ * ============================================================================ */
+
+#ifndef _WIN32
+/** Processus enfant en cours d'ecriture (0 : aucun) */
+static pid_t sauvegardeEnCours = 0;
+#endif
+
+/** Derniere operation du journal contenue dans la sauvegarde en cours */
+static uint32_t sequenceEnCours = 0;
+
+/** Sauvegarde periodique : fichier, intervalle et date du dernier lancement */
+static char fichierPeriodique[MAX_CHEMIN] = "";
+static int intervallePeriodique = 0;
+static long dernierLancement = 0;
+
+/**
+ * @brief Fin d'une sauvegarde : le journal peut etre compacte
+ * @param parking Parking dont le journal est compacte (NULL : aucun)
+ * @param reussie 1 si la sauvegarde est sur disque
+ * @return 1 si la sauvegarde a reussi, -1 sinon
+ */
+static int conclureSauvegarde(Parking *parking, int reussie)
+{
+    if (reussie == 0) {
+        return -1;
+    }
+
+    if (parking != NULL) {
+        compacterJournal(parking, sequenceEnCours);
+    }
+
+    return 1;
+}
+
+int lancerSauvegardeAsynchrone(Parking *parking, const char *nomFichier)
+{
+#ifndef _WIN32
+    pid_t processus;
+#endif
+
+    if (parking == NULL || nomFichier == NULL) {
+        return 0;
+    }
+
+#ifndef _WIN32
+    if (sauvegardeEnCours != 0) {
+        return 0;
+    }
+#endif
+
+    dernierLancement = (long)time(NULL);
+    sequenceEnCours = parking->sequenceJournal;
+
+#ifdef _WIN32
+    /* Pas de fork : sauvegarde synchrone */
+    return conclureSauvegarde(parking, ecrireSauvegarde(parking, nomFichier) ==
+                                       SUCCES) == 1;
+#else
+    /* Les operations journalisees avant la copie sont sur disque */
+    synchroniserJournal(parking);
+
+    /* Cote parent, la sauvegarde en fond ne coute que la copie du fork */
+    TRACER_DEBUT(TRACE_SAUVEGARDE);
+    processus = fork();
+    TRACER_FIN(TRACE_SAUVEGARDE);
+
+    if (processus == 0) {
+        /* Enfant : copie figee du parking, sortie sans toucher aux flux
+         * herites (journal, sortie standard) */
+        _exit(ecrireSauvegarde(parking, nomFichier) == SUCCES ? 0 : 1);
+    }
+
+    if (processus < 0) {
+        /* Pas de processus disponible : sauvegarde synchrone */
+        return conclureSauvegarde(parking,
+                                  ecrireSauvegarde(parking, nomFichier) ==
+                                  SUCCES) == 1;
+    }
+
+    sauvegardeEnCours = processus;
+
+    return 1;
+#endif
+}
+
+/**
+ * @brief Recupere la fin du processus de sauvegarde
+ * @param parking Parking dont le journal est compacte (NULL : aucun)
+ * @param bloquant 1 pour attendre la fin, 0 pour un simple constat
+ * @return 1 si une sauvegarde vient de reussir, -1 si elle a echoue,
+ *         0 si aucune ne s'est terminee
+ */
+static int recupererSauvegarde(Parking *parking, int bloquant)
+{
+#ifdef _WIN32
+    (void)parking;
+    (void)bloquant;
+    return 0;
+#else
+    int statut;
+    pid_t resultat;
+
+    if (sauvegardeEnCours == 0) {
+        return 0;
+    }
+
+    resultat = waitpid(sauvegardeEnCours, &statut, bloquant ? 0 : WNOHANG);
+    if (resultat == 0) {
+        return 0;
+    }
+
+    sauvegardeEnCours = 0;
+
+    return conclureSauvegarde(parking, resultat > 0 && WIFEXITED(statut) &&
+                                       WEXITSTATUS(statut) == 0);
+#endif
+}
+
+int suivreSauvegardeAsynchrone(Parking *parking)
+{
+    return recupererSauvegarde(parking, 0);
+}
+
+int attendreSauvegardeAsynchrone(Parking *parking)
+{
+    return recupererSauvegarde(parking, 1);
+}
+
+void configurerSauvegardePeriodique(const char *nomFichier,
+                                    int intervalleSecondes)
+{
+    if (nomFichier == NULL) {
+        return;
+    }
+
+    strncpy(fichierPeriodique, nomFichier, MAX_CHEMIN - 1);
+    fichierPeriodique[MAX_CHEMIN - 1] = '\0';
+    intervallePeriodique = intervalleSecondes;
+    dernierLancement = (long)time(NULL);
+}
+
+int sauvegarderSiEcheance(Parking *parking)
+{
+    int resultat;
+
+    resultat = suivreSauvegardeAsynchrone(parking);
+
+    if (intervallePeriodique > 0 && fichierPeriodique[0] != '\0' &&
+        (long)time(NULL) - dernierLancement >= intervallePeriodique) {
+        lancerSauvegardeAsynchrone(parking, fichierPeriodique);
+    }
+
+    return resultat;
+}
+
+/* ============================================================================
+ * CHARGEMENT
+ * ============================================================================ */
+
+/**
+ * @brief Somme de controle des places, des presents et des sommes de blocs
+ * @param entete En-tete valide
+ * @param places Places, suivies des indices des vehicules presents et des
+ *        sommes des blocs
+ * @return CRC32C de ces trois tableaux contigus
+ */
+static uint32_t crcRelations(const EnteteSauvegarde *entete,
+                             const PlaceSauvegarde *places)
+{
+    return calculerCrc32c(0, places,
+                          (size_t)entete->nombrePlaces *
+                          sizeof(PlaceSauvegarde) +
+                          (size_t)entete->nombrePresents * sizeof(int32_t) +
+                          (size_t)blocsEnMemoire(entete->premierVehicule,
+                                                 entete->nombreVehicules) *
+                          sizeof(uint32_t));
+}
+
+/**
+ * @brief Sommes de controle des blocs d'une sauvegarde validee
+ * @param entete En-tete valide
+ * @param places Places de la sauvegarde, suivies des indices des presents
+ * @return Premiere somme, celle du bloc du premier vehicule en memoire
+ */
+static const uint32_t* sommesBlocs(const EnteteSauvegarde *entete,
+                                   const PlaceSauvegarde *places)
+{
+    const int32_t *presents;
+
+    presents = (const int32_t*)(const void*)(places + entete->nombrePlaces);
+
+    return (const uint32_t*)(const void*)(presents + entete->nombrePresents);
+}
+
+/**
+ * @brief Controle un bloc de l'historique lu dans la sauvegarde
+ * @param entete En-tete valide
+ * @param places Places de la sauvegarde, suivies des indices des presents
+ * @param vehicules Premier vehicule de l'historique en memoire
+ * @param bloc Rang du bloc a partir du premier vehicule en memoire
+ * @return 1 si la somme du bloc est juste, 0 sinon
+ */
+static int blocIntact(const EnteteSauvegarde *entete,
+                      const PlaceSauvegarde *places,
+                      const Vehicule *vehicules, int bloc)
+{
+    int n;
+
+    n = entete->nombreVehicules - entete->premierVehicule -
+        bloc * VEHICULES_PAR_BLOC;
+    if (n > VEHICULES_PAR_BLOC) {
+        n = VEHICULES_PAR_BLOC;
+    }
+
+    return calculerCrc32c(0, vehicules + bloc * VEHICULES_PAR_BLOC,
+                          (size_t)n * sizeof(Vehicule)) ==
+           sommesBlocs(entete, places)[bloc];
+}
+
+/**
+ * @brief Verifie la coherence d'un en-tete lu sur disque
+ * @param entete En-tete lu
+ * @param tailleFichier Taille totale du fichier
+ * @return 1 si l'en-tete est exploitable, 0 sinon
+ *
+ * Seules les tailles et positions sont controlees : les compteurs de
+ * places sont repris tels quels, meme s'ils ne se recoupent pas.
+ */
+static int enteteValide(const EnteteSauvegarde *entete, size_t tailleFichier)
+{
+    if (entete->signature != SIGNATURE_SAUVEGARDE ||
+        entete->version != VERSION_SAUVEGARDE ||
+        entete->tailleEntete != sizeof(EnteteSauvegarde) ||
+        entete->taillePlace != sizeof(PlaceSauvegarde) ||
+        entete->tailleVehicule != sizeof(Vehicule) ||
+        entete->vehiculesParBloc != VEHICULES_PAR_BLOC ||
+        entete->crcEntete != crcEntete(entete) ||
+        entete->nombrePlaces <= 0 ||
+        entete->nombreVehicules < 0 ||
+        entete->premierVehicule < 0 ||
+        entete->premierVehicule > entete->nombreVehicules ||
+        entete->premierVehicule % VEHICULES_PAR_BLOC != 0 ||
+        entete->nombrePresents < 0 ||
+        entete->nombrePresents > entete->nombreVehicules -
+                                 entete->premierVehicule ||
+        entete->positionHistorique != positionHistorique(
+                                          entete->nombrePlaces,
+                                          entete->nombrePresents,
+                                          blocsEnMemoire(
+                                              entete->premierVehicule,
+                                              entete->nombreVehicules))) {
+        return 0;
+    }
+
+    /* Le fichier se termine exactement apres l'historique en memoire */
+    return tailleFichier == entete->positionHistorique +
+           (size_t)(entete->nombreVehicules - entete->premierVehicule) *
+           sizeof(Vehicule);
+}
+
+/**
+ * @brief Remplace le parking par le contenu d'une sauvegarde validee
+ * @param parking Pointeur vers le parking
+ * @param entete En-tete de la sauvegarde
+ * @param places Places de la sauvegarde, suivies des indices des presents
+ * @param vehicules Premier vehicule de l'historique en memoire
+ * @param blocsEmpruntes Blocs complets utilises sur place (le reste est
+ *        recopie dans des blocs alloues)
+ * @return 1 si succes, 0 si memoire insuffisante
+ *
+ * Les blocs recopies et ceux des vehicules presents doivent avoir ete
+ * controles : ce sont les seuls lus ici.
+ */
+static int restaurerParking(Parking *parking, const EnteteSauvegarde *entete,
+                            const PlaceSauvegarde *places, Vehicule *vehicules,
+                            int blocsEmpruntes)
+{
+    int i;
+    int indice;
+    int enMemoire;
+    const int32_t *presents;
+    Place *place;
+
+    /* Remplacement du parking courant */
+    libererParking(parking);
+    if (initialiserParking(parking, entete->nom, entete->nombrePlaces) == 0) {
+        return 0;
+    }
+
+    /* Segments archives : reserves sans memoire, relus depuis l'archive */
+    if (entete->premierVehicule > 0 &&
+        (configurerArchivage(parking, entete->fichierArchive, 0, 0) == 0 ||
+         ajouterBlocsVidesArene(&parking->historique, entete->premierVehicule >>
+                                DECALAGE_BLOC_HISTORIQUE) == 0)) {
+        return 0;
+    }
+    parking->nombreVehicules = entete->premierVehicule;
+    if (parking->archive != NULL) {
+        parking->archive->premierBloc = entete->premierVehicule >>
+                                        DECALAGE_BLOC_HISTORIQUE;
+    }
+
+    /* Blocs complets : pris tels quels dans le fichier projete */
+    if (blocsEmpruntes > 0) {
+        if (emprunterBlocsArene(&parking->historique, vehicules,
+                                blocsEmpruntes) == 0) {
+            return 0;
+        }
+        parking->nombreVehicules += blocsEmpruntes * VEHICULES_PAR_BLOC;
+    }
+
+    /* Reste de l'historique recopie dans des blocs alloues */
+    enMemoire = entete->nombreVehicules - entete->premierVehicule;
+    for (i = blocsEmpruntes * VEHICULES_PAR_BLOC; i < enMemoire; i++) {
+        indice = ajouterVehiculeHistorique(parking);
+        if (indice == -1) {
+            return 0;
+        }
+        *obtenirVehicule(parking, indice) = vehicules[i];
+    }
+
+    /* Restauration des places et de leurs liens vers l'historique */
+    for (i = 0; i < entete->nombrePlaces; i++) {
+        place = obtenirPlace(parking, i);
+        place->numero = places[i].numero;
+        place->etat = (EtatPlace)places[i].etat;
+        place->typeAutorise = (TypeVehicule)places[i].typeAutorise;
+        indice = places[i].indiceVehicule;
+        place->vehiculeActuel = (indice >= entete->premierVehicule &&
+                                 indice < parking->nombreVehicules) ?
+                                obtenirVehicule(parking, indice) : NULL;
+    }
+
+    /* Index des plaques : seuls les vehicules presents sont lus, les
+     * autres blocs empruntes ne le seront qu'a leur premier acces */
+    presents = (const int32_t*)(const void*)(places + entete->nombrePlaces);
+    for (i = 0; i < entete->nombrePresents; i++) {
+        if (presents[i] >= entete->premierVehicule &&
+            presents[i] < parking->nombreVehicules) {
+            indexerVehicule(parking, presents[i]);
+        }
+    }
+
+    parking->placesLibres = entete->placesLibres;
+    parking->placesOccupees = entete->placesOccupees;
+    parking->recetteJournaliere = entete->recetteJournaliere;
+    parking->recetteTotale = entete->recetteTotale;
+    parking->agregats = entete->agregats;
+    parking->sequenceJournal = entete->sequenceJournal;
+
+    /* Reconstruction des bitmaps de places libres */
+    reconstruireBitmapsPlaces(parking);
+
+    return 1;
+}
+
+#ifndef _WIN32
+/** Resultat de chargerParProjection : fichier a lire normalement */
+#define PROJECTION_IMPOSSIBLE 1
+
+/**
+ * @brief Chargement par projection du fichier en memoire
+ * @param parking Pointeur vers le parking
+ * @param nomFichier Fichier de sauvegarde
+ * @return SUCCES, ERREUR_FICHIER_INVALIDE ou ERREUR_MEMOIRE, ou
+ *         PROJECTION_IMPOSSIBLE (le chargement par lecture prend le relais)
+ *
+ * Seuls les blocs lus par restaurerParking sont controles ici : le bloc
+ * de queue recopie et ceux des vehicules presents. Les autres blocs
+ * empruntes le sont a leur premier acces (controlerBlocHistorique), si
+ * bien que la duree du chargement ne depend pas de l'historique.
+ */
+static int chargerParProjection(Parking *parking, const char *nomFichier)
+{
+    int descripteur;
+    struct stat infos;
+    void *projection;
+    size_t taille;
+    EnteteSauvegarde entete;
+    const unsigned char *octets;
+    const PlaceSauvegarde *places;
+    const int32_t *presents;
+    Vehicule *vehicules;
+    ControleHistorique *controle;
+    int enMemoire;
+    int blocsEmpruntes;
+    int nombreBlocs;
+    int intact;
+    int indice;
+    int bloc;
+    int i;
+    int resultat;
+
+    descripteur = open(nomFichier, O_RDONLY);
+    if (descripteur < 0) {
+        return PROJECTION_IMPOSSIBLE;
+    }
+
+    if (fstat(descripteur, &infos) != 0 ||
+        (size_t)infos.st_size < sizeof(EnteteSauvegarde)) {
+        close(descripteur);
+        return PROJECTION_IMPOSSIBLE;
+    }
+    taille = (size_t)infos.st_size;
+
+    /* Copie privee : les modifications ne touchent pas le fichier */
+    projection = mmap(NULL, taille, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                      descripteur, 0);
+    close(descripteur);
+    if (projection == MAP_FAILED) {
+        return PROJECTION_IMPOSSIBLE;
+    }
+
+    octets = (const unsigned char*)projection;
+    memcpy(&entete, octets, sizeof(entete));
+    places = (const PlaceSauvegarde*)(octets + sizeof(EnteteSauvegarde));
+
+    if (enteteValide(&entete, taille) == 0 ||
+        crcRelations(&entete, places) != entete.crcPlaces) {
+        munmap(projection, taille);
+        return ERREUR_FICHIER_INVALIDE;
+    }
+    entete.nom[MAX_CHAINE - 1] = '\0';
+    entete.fichierArchive[MAX_CHEMIN - 1] = '\0';
+
+    enMemoire = entete.nombreVehicules - entete.premierVehicule;
+    vehicules = (Vehicule*)(void*)(octets + entete.positionHistorique);
+    presents = (const int32_t*)(const void*)(places + entete.nombrePlaces);
+
+    /* Le dernier bloc, incomplet, est recopie pour pouvoir grandir */
+    blocsEmpruntes = enMemoire / VEHICULES_PAR_BLOC;
+    nombreBlocs = blocsEnMemoire(entete.premierVehicule,
+                                 entete.nombreVehicules);
+
+    controle = (ControleHistorique*)malloc(sizeof(ControleHistorique));
+    if (controle != NULL) {
+        controle->etats = (signed char*)calloc((size_t)nombreBlocs + 1, 1);
+    }
+    if (controle == NULL || controle->etats == NULL) {
+        free(controle);
+        munmap(projection, taille);
+        return ERREUR_MEMOIRE;
+    }
+    controle->premierBloc = entete.premierVehicule >> DECALAGE_BLOC_HISTORIQUE;
+    controle->nombreBlocs = blocsEmpruntes;
+    controle->crcBlocs = sommesBlocs(&entete, places);
+
+    /* Blocs lus au chargement : queue recopie, vehicules presents et
+     * occupants des places (ignores par restaurerParking hors limites) */
+    intact = blocsEmpruntes == nombreBlocs ||
+             blocIntact(&entete, places, vehicules, blocsEmpruntes);
+    for (i = 0; i < entete.nombrePresents + entete.nombrePlaces && intact;
+         i++) {
+        indice = i < entete.nombrePresents ? presents[i] :
+                 places[i - entete.nombrePresents].indiceVehicule;
+        if (indice < entete.premierVehicule ||
+            indice >= entete.premierVehicule + blocsEmpruntes *
+                      VEHICULES_PAR_BLOC) {
+            continue;
+        }
+        bloc = (indice - entete.premierVehicule) >> DECALAGE_BLOC_HISTORIQUE;
+        if (controle->etats[bloc] == 0) {
+            controle->etats[bloc] = blocIntact(&entete, places, vehicules,
+                                               bloc) ? 1 : -1;
+        }
+        intact = controle->etats[bloc] == 1;
+    }
+
+    if (intact == 0) {
+        free(controle->etats);
+        free(controle);
+        munmap(projection, taille);
+        return ERREUR_FICHIER_INVALIDE;
+    }
+
+    resultat = restaurerParking(parking, &entete, places, vehicules,
+                                blocsEmpruntes);
+
+    /* La projection vit avec le parking, meme apres un echec partiel */
+    parking->projection = projection;
+    parking->tailleProjection = taille;
+    parking->controle = controle;
+
+    return resultat ? SUCCES : ERREUR_MEMOIRE;
+}
+#endif
+
+/**
+ * @brief Chargement par lecture du fichier d'un seul bloc
+ * @param parking Pointeur vers le parking
+ * @param nomFichier Fichier de sauvegarde
+ * @return SUCCES ou code d'erreur (CodeErreur)
+ */
+static int chargerParLecture(Parking *parking, const char *nomFichier)
+{
+    FILE *fichier;
+    long tailleFichier;
+    size_t tailleDonnees;
+    unsigned char *donnees;
+    EnteteSauvegarde entete;
+    const PlaceSauvegarde *places;
+    Vehicule *vehicules;
+    int nombreBlocs;
+    int intact;
+    int bloc;
+    int resultat;
+
+    fichier = fopen(nomFichier, "rb");
+    if (fichier == NULL) {
+        return ERREUR_FICHIER_ABSENT;
+    }
+
+    /* Lecture et validation de l'en-tete */
+    if (fseek(fichier, 0, SEEK_END) != 0 ||
+        (tailleFichier = ftell(fichier)) < 0 ||
+        fseek(fichier, 0, SEEK_SET) != 0 ||
+        fread(&entete, sizeof(entete), 1, fichier) != 1 ||
+        enteteValide(&entete, (size_t)tailleFichier) == 0) {
+        fclose(fichier);
+        return ERREUR_FICHIER_INVALIDE;
+    }
+    entete.nom[MAX_CHAINE - 1] = '\0';
+    entete.fichierArchive[MAX_CHEMIN - 1] = '\0';
+
+    /* Places et historique : une seule lecture, verifiee avant usage */
+    tailleDonnees = (size_t)tailleFichier - sizeof(EnteteSauvegarde);
+
+    donnees = (unsigned char*)malloc(tailleDonnees + 1);
+    if (donnees == NULL) {
+        fclose(fichier);
+        return ERREUR_MEMOIRE;
+    }
+    if (fread(donnees, 1, tailleDonnees, fichier) != tailleDonnees) {
+        free(donnees);
+        fclose(fichier);
+        return ERREUR_ENTREE_SORTIE;
+    }
+
+    fclose(fichier);
+
+    places = (const PlaceSauvegarde*)donnees;
+    vehicules = (Vehicule*)(void*)(donnees + entete.positionHistorique -
+                                   sizeof(EnteteSauvegarde));
+
+    /* Tout le fichier est en memoire : chaque bloc est controle */
+    intact = crcRelations(&entete, places) == entete.crcPlaces;
+    nombreBlocs = blocsEnMemoire(entete.premierVehicule,
+                                 entete.nombreVehicules);
+    for (bloc = 0; bloc < nombreBlocs && intact; bloc++) {
+        intact = blocIntact(&entete, places, vehicules, bloc);
+    }
+
+    if (intact == 0) {
+        free(donnees);
+        return ERREUR_FICHIER_INVALIDE;
+    }
+
+    resultat = restaurerParking(parking, &entete, places, vehicules, 0);
+    free(donnees);
+
+    return resultat ? SUCCES : ERREUR_MEMOIRE;
+}
+
+int chargerDonnees(Parking *parking, const char *nomFichier)
+{
+    int resultat;
+
+    if (parking == NULL || nomFichier == NULL) {
+        return ERREUR_PARAMETRE;
+    }
+
+#ifndef _WIN32
+    resultat = chargerParProjection(parking, nomFichier);
+    if (resultat != PROJECTION_IMPOSSIBLE) {
+        return resultat;
+    }
+#endif
+
+    resultat = chargerParLecture(parking, nomFichier);
+
+    return resultat;
+}
+
+int lireSequenceSauvegarde(const char *nomFichier, uint32_t *sequence)
+{
+    FILE *fichier;
+    EnteteSauvegarde entete;
+    int lu;
+
+    if (nomFichier == NULL || sequence == NULL) {
+        return ERREUR_PARAMETRE;
+    }
+
+    fichier = fopen(nomFichier, "rb");
+    if (fichier == NULL) {
+        return ERREUR_FICHIER_ABSENT;
+    }
+
+    lu = fread(&entete, sizeof(entete), 1, fichier) == 1;
+    fclose(fichier);
+
+    if (lu == 0 || entete.signature != SIGNATURE_SAUVEGARDE ||
+        entete.version != VERSION_SAUVEGARDE ||
+        entete.crcEntete != crcEntete(&entete)) {
+        return ERREUR_FICHIER_INVALIDE;
+    }
+
+    *sequence = entete.sequenceJournal;
+
+    return SUCCES;
+}
+
+void libererProjection(Parking *parking)
+{
+    if (parking == NULL || parking->projection == NULL) {
+        return;
+    }
+
+#ifndef _WIN32
+    munmap(parking->projection, parking->tailleProjection);
+#endif
+    parking->projection = NULL;
+    parking->tailleProjection = 0;
+
+    if (parking->controle != NULL) {
+        free(parking->controle->etats);
+        free(parking->controle);
+        parking->controle = NULL;
+    }
+}
+
+int controlerBlocHistorique(const Parking *parking, int bloc)
+{
+    const uint32_t *attendu;
+    signed char *etat;
+
+    attendu = crcEnAttente(parking, bloc);
+    if (attendu == NULL) {
+        return 1;
+    }
+
+    /* Premier acces : les pages du bloc sont lues ici */
+    etat = &parking->controle->etats[bloc - parking->controle->premierBloc];
+    if (*etat == 0) {
+        *etat = calculerCrc32c(0, obtenirVehicule(parking, bloc <<
+                                                  DECALAGE_BLOC_HISTORIQUE),
+                               VEHICULES_PAR_BLOC * sizeof(Vehicule)) ==
+                *attendu ? 1 : -1;
+    }
+
+    return *etat == 1;
+}
@@ -156,29 +156,18 @@ int rechercherPlusLongStationnement(Vehicule vehicules[], int taille)
 {
     int i;
     int indiceMax;
-    Horodatage maintenant;
-    int dureeMax;
-    int dureeCourante;
     
     if (vehicules == NULL || taille <= 0) {
         return -1;
     }
     
-    /* Obtenir l'heure actuelle pour les vehicules presents */
-    maintenant.jour = 0;  /* Sera initialise si necessaire */
-    
     indiceMax = -1;
-    dureeMax = 0;
     
+    /* Le plus long stationnement en cours est l'entree la plus ancienne */
     for (i = 0; i < taille; i++) {
         if (vehicules[i].estPresent == 1) {
-            /* Pour un vehicule present, calculer depuis l'entree */
-            /* Note : cette fonction necessite l'horodatage actuel */
-            dureeCourante = vehicules[i].entree.heure * 60 + 
-                           vehicules[i].entree.minute;
-            
-            if (indiceMax == -1 || dureeCourante < dureeMax) {
-                dureeMax = dureeCourante;
+            if (indiceMax == -1 ||
+                vehicules[i].entree.minutes < vehicules[indiceMax].entree.minutes) {
                 indiceMax = i;
             }
         }
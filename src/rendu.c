@@ -0,0 +1,221 @@
+/**
+ * @file rendu.c
+ * @brief Implementation de la couche de rendu des ecrans
+ * @date Decembre 2025
+ *
+ * Le tampon grandit par doublement et n'est jamais reduit : apres le
+ * premier ecran, composer un rapport ne coute plus aucune allocation.
+ * Sous POSIX, l'ecran est ecrit par write(2) sur la sortie standard ;
+ * ailleurs par un seul fwrite suivi d'un fflush.
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#ifndef _WIN32
+#include <errno.h>
+#include <unistd.h>
+#else
+#include <windows.h>
+#endif
+#include "../include/rendu.h"
+#include "../include/trace.h"
+
+/** Taille initiale du tampon d'ecran */
+#define TAILLE_INITIALE_RENDU 8192
+
+/** Effacement du terminal : curseur en haut a gauche, ecran vide */
+#define SEQUENCE_EFFACEMENT "\033[H\033[2J"
+
+/* ============================================================================
+ * ETAT DU RENDU
+ * ============================================================================ */
+
+/** Tampon de l'ecran en cours */
+static char *tampon = NULL;
+static size_t capacite = 0;
+static size_t taille = 0;
+
+/** Profondeur d'imbrication des rendus en cours */
+static int profondeur = 0;
+
+/**
+ * @brief Garantit la place pour des octets supplementaires
+ * @param supplement Octets a ajouter (terminateur compris)
+ * @return 1 si succes, 0 si memoire insuffisante
+ */
+static int reserverRendu(size_t supplement)
+{
+    size_t nouvelleCapacite;
+    char *nouveau;
+
+    if (taille + supplement <= capacite) {
+        return 1;
+    }
+
+    nouvelleCapacite = capacite > 0 ? capacite : TAILLE_INITIALE_RENDU;
+    while (nouvelleCapacite < taille + supplement) {
+        nouvelleCapacite *= 2;
+    }
+
+    nouveau = (char*)realloc(tampon, nouvelleCapacite);
+    if (nouveau == NULL) {
+        return 0;
+    }
+
+    tampon = nouveau;
+    capacite = nouvelleCapacite;
+
+    return 1;
+}
+
+/* ============================================================================
+ * ECRITURE DE L'ECRAN
+ * ============================================================================ */
+
+/**
+ * @brief Ecrit des octets sur la sortie standard en un seul appel
+ * @param donnees Octets a ecrire
+ * @param nombre Nombre d'octets
+ */
+static void ecrireSortie(const char *donnees, size_t nombre)
+{
+#ifndef _WIN32
+    ssize_t ecrits;
+
+    /* Le texte deja confie a stdio passe avant l'ecran */
+    fflush(stdout);
+
+    while (nombre > 0) {
+        ecrits = write(STDOUT_FILENO, donnees, nombre);
+        if (ecrits < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        donnees += ecrits;
+        nombre -= (size_t)ecrits;
+    }
+#else
+    static int consoleConfiguree = 0;
+    HANDLE console;
+    DWORD mode;
+
+    /* Interpretation des sequences ANSI par la console Windows */
+    if (consoleConfiguree == 0) {
+        console = GetStdHandle(STD_OUTPUT_HANDLE);
+        if (GetConsoleMode(console, &mode)) {
+            SetConsoleMode(console, mode | 0x0004);
+        }
+        consoleConfiguree = 1;
+    }
+
+    fwrite(donnees, 1, nombre, stdout);
+    fflush(stdout);
+#endif
+}
+
+/* ============================================================================
+ * COMPOSITION D'UN ECRAN
+ * ============================================================================ */
+
+void commencerRendu(void)
+{
+    if (profondeur == 0) {
+        taille = 0;
+    }
+    profondeur++;
+}
+
+void rendreTexte(const char *format, ...)
+{
+    va_list arguments;
+    int longueur;
+
+    /* Hors d'un ecran, le texte part directement */
+    if (profondeur == 0) {
+        va_start(arguments, format);
+        vprintf(format, arguments);
+        va_end(arguments);
+        return;
+    }
+
+    /* Premier essai dans la place restante, second apres agrandissement */
+    reserverRendu(1);
+    va_start(arguments, format);
+    longueur = vsnprintf(tampon + taille, capacite - taille, format, arguments);
+    va_end(arguments);
+
+    if (longueur < 0) {
+        return;
+    }
+
+    if ((size_t)longueur >= capacite - taille) {
+        if (reserverRendu((size_t)longueur + 1) == 0) {
+            return;
+        }
+        va_start(arguments, format);
+        vsnprintf(tampon + taille, capacite - taille, format, arguments);
+        va_end(arguments);
+    }
+
+    taille += (size_t)longueur;
+}
+
+void rendreLigne(char caractere, int longueur)
+{
+    if (longueur < 0) {
+        longueur = 0;
+    }
+
+    if (profondeur == 0) {
+        commencerRendu();
+        rendreLigne(caractere, longueur);
+        terminerRendu();
+        return;
+    }
+
+    if (reserverRendu((size_t)longueur + 2) == 0) {
+        return;
+    }
+
+    memset(tampon + taille, caractere, (size_t)longueur);
+    taille += (size_t)longueur;
+    tampon[taille++] = '\n';
+}
+
+void rendreEffacement(void)
+{
+    rendreTexte("%s", SEQUENCE_EFFACEMENT);
+}
+
+void terminerRendu(void)
+{
+    if (profondeur == 0) {
+        return;
+    }
+
+    profondeur--;
+
+    if (profondeur == 0 && taille > 0) {
+        TRACER_DEBUT(TRACE_RENDU);
+        ecrireSortie(tampon, taille);
+        TRACER_FIN(TRACE_RENDU);
+        taille = 0;
+    }
+}
+
+void libererRendu(void)
+{
+    free(tampon);
+    tampon = NULL;
+    capacite = 0;
+    taille = 0;
+    profondeur = 0;
+}
@@ -0,0 +1,734 @@
+/**
+ * @file serveur.c
+ * @brief Implementation du serveur local des bornes
+ * @date Decembre 2025
+ *
+ * Chaque connexion garde ses octets recus (lignes incompletes) et ses
+ * reponses en attente d'envoi. A chaque tour de boucle :
+ * 1. les connexions pretes sont lues et toutes leurs lignes completes
+ *    executees (reponses composees dans un flux en memoire) ;
+ * 2. le journal est synchronise une fois pour tout le tour ;
+ * 3. les reponses sont envoyees ; ce qui ne part pas attend EPOLLOUT.
+ * Si la synchronisation echoue, aucune reponse du tour ne part : les
+ * connexions en attente sont fermees et le serveur s'arrete.
+ * Une connexion dont les reponses s'accumulent (client qui ne lit pas)
+ * n'est plus lue jusqu'a ce qu'elles soient parties.
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include "../include/serveur.h"
+#include "../include/parking.h"
+#include "../include/persistance.h"
+#include "../include/metriques.h"
+#include "../include/trace.h"
+#include "../include/journal.h"
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <time.h>
+
+/** Taille du tampon de reception d'une connexion (ligne la plus longue) */
+#define TAILLE_RECEPTION 4096
+
+/** Reponses en attente au-dela desquelles une connexion n'est plus lue */
+#define LIMITE_REPONSES (1 << 20)
+
+/** Evenements traites par tour de boucle */
+#define EVENEMENTS_PAR_TOUR 64
+
+/** Attente maximale d'un tour (synchronisation et sauvegarde periodiques) */
+#define PERIODE_ENTRETIEN_MS 1000
+
+/* ============================================================================
+ * STRUCTURES
+ * ============================================================================ */
+
+/**
+ * @struct Connexion
+ * @brief Etat d'une borne connectee
+ */
+typedef struct Connexion {
+    int descripteur;
+    char reception[TAILLE_RECEPTION];
+    size_t recus;
+    int ligneTropLongue;
+    long numeroLigne;
+    char *reponses;
+    size_t tailleReponses;
+    size_t capaciteReponses;
+    size_t envoyes;
+    unsigned int evenements;
+    int fermer;
+    int enAttente;
+    struct Connexion *suivanteEnvoi;
+    struct Connexion *precedente;
+    struct Connexion *suivante;
+} Connexion;
+
+/**
+ * @struct Serveur
+ * @brief Socket d'ecoute, connexions et flux de composition des reponses
+ */
+typedef struct {
+    Parking *parking;
+    BilanLot *bilan;
+    int ecoute;
+    int epoll;
+    FILE *flux;
+    char *tamponFlux;
+    size_t tailleFlux;
+    Connexion *connexions;
+    Connexion *aEnvoyer;
+} Serveur;
+
+/** Positionne par Ctrl+C ou SIGTERM */
+static volatile sig_atomic_t arretDemande = 0;
+
+static void demanderArret(int signal)
+{
+    (void)signal;
+    arretDemande = 1;
+}
+
+/** Positionne par SIGUSR1 : trace ecrite au prochain entretien */
+static volatile sig_atomic_t traceDemandee = 0;
+
+static void demanderTrace(int signal)
+{
+    (void)signal;
+    traceDemandee = 1;
+}
+
+/**
+ * @brief Instant monotone en secondes
+ * @return Secondes depuis une origine arbitraire
+ *
+ * Comme instantMonotone : utilitaires.h (pause) ne peut etre inclus avec
+ * unistd.h.
+ */
+static double instantServeur(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* ============================================================================
+ * SOCKET D'ECOUTE
+ * ============================================================================ */
+
+/**
+ * @brief Passe un descripteur en mode non bloquant
+ * @param descripteur Descripteur
+ * @return 1 si succes, 0 sinon
+ */
+static int rendreNonBloquant(int descripteur)
+{
+    int options;
+
+    options = fcntl(descripteur, F_GETFL, 0);
+
+    return options != -1 &&
+           fcntl(descripteur, F_SETFL, options | O_NONBLOCK) != -1;
+}
+
+/**
+ * @brief Indique si l'adresse est un numero de port
+ * @param adresse Adresse donnee
+ * @return 1 si elle n'est faite que de chiffres
+ */
+static int estNumeroPort(const char *adresse)
+{
+    if (*adresse == '\0') {
+        return 0;
+    }
+
+    while (*adresse >= '0' && *adresse <= '9') {
+        adresse++;
+    }
+
+    return *adresse == '\0';
+}
+
+/**
+ * @brief Ouvre la socket d'ecoute (TCP locale ou Unix)
+ * @param adresse Numero de port ou chemin de socket Unix
+ * @return Descripteur, sinon ERREUR_PARAMETRE ou ERREUR_ENTREE_SORTIE
+ */
+static int ouvrirEcoute(const char *adresse)
+{
+    struct sockaddr_in inet;
+    struct sockaddr_un local;
+    struct stat etat;
+    int descripteur;
+    int actif;
+    long port;
+    int resultat;
+
+    if (estNumeroPort(adresse)) {
+        port = atol(adresse);
+        if (port < 1 || port > 65535) {
+            return ERREUR_PARAMETRE;
+        }
+
+        descripteur = socket(AF_INET, SOCK_STREAM, 0);
+        if (descripteur == -1) {
+            return ERREUR_ENTREE_SORTIE;
+        }
+
+        actif = 1;
+        setsockopt(descripteur, SOL_SOCKET, SO_REUSEADDR, &actif,
+                   sizeof(actif));
+
+        /* Bornes du meme site seulement : boucle locale */
+        memset(&inet, 0, sizeof(inet));
+        inet.sin_family = AF_INET;
+        inet.sin_port = htons((unsigned short)port);
+        inet.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        resultat = bind(descripteur, (struct sockaddr*)&inet, sizeof(inet));
+    } else {
+        if (strlen(adresse) >= sizeof(local.sun_path)) {
+            return ERREUR_PARAMETRE;
+        }
+
+        descripteur = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (descripteur == -1) {
+            return ERREUR_ENTREE_SORTIE;
+        }
+
+        /* Socket laissee par une instance precedente */
+        if (stat(adresse, &etat) == 0 && S_ISSOCK(etat.st_mode)) {
+            unlink(adresse);
+        }
+
+        memset(&local, 0, sizeof(local));
+        local.sun_family = AF_UNIX;
+        strcpy(local.sun_path, adresse);
+        resultat = bind(descripteur, (struct sockaddr*)&local, sizeof(local));
+    }
+
+    if (resultat == -1 || listen(descripteur, SOMAXCONN) == -1 ||
+        rendreNonBloquant(descripteur) == 0) {
+        close(descripteur);
+        return ERREUR_ENTREE_SORTIE;
+    }
+
+    return descripteur;
+}
+
+/* ============================================================================
+ * CONNEXIONS
+ * ============================================================================ */
+
+/**
+ * @brief Ajuste les evenements surveilles d'une connexion
+ * @param serveur Serveur
+ * @param connexion Connexion
+ *
+ * Lecture tant que la connexion est ouverte et que ses reponses en
+ * attente restent sous la limite ; ecriture tant qu'il en reste.
+ */
+static void surveillerConnexion(Serveur *serveur, Connexion *connexion)
+{
+    struct epoll_event evenement;
+    unsigned int souhaites;
+    size_t enAttente;
+
+    enAttente = connexion->tailleReponses - connexion->envoyes;
+    souhaites = 0;
+
+    if (connexion->fermer == 0 && enAttente < LIMITE_REPONSES) {
+        souhaites |= EPOLLIN;
+    }
+    if (enAttente > 0) {
+        souhaites |= EPOLLOUT;
+    }
+
+    if (souhaites == connexion->evenements) {
+        return;
+    }
+
+    memset(&evenement, 0, sizeof(evenement));
+    evenement.events = souhaites;
+    evenement.data.ptr = connexion;
+    epoll_ctl(serveur->epoll, EPOLL_CTL_MOD, connexion->descripteur,
+              &evenement);
+    connexion->evenements = souhaites;
+}
+
+/**
+ * @brief Ferme une connexion et la retire de la liste
+ * @param serveur Serveur
+ * @param connexion Connexion a fermer
+ */
+static void fermerConnexion(Serveur *serveur, Connexion *connexion)
+{
+    close(connexion->descripteur);
+
+    if (connexion->precedente != NULL) {
+        connexion->precedente->suivante = connexion->suivante;
+    } else {
+        serveur->connexions = connexion->suivante;
+    }
+    if (connexion->suivante != NULL) {
+        connexion->suivante->precedente = connexion->precedente;
+    }
+
+    free(connexion->reponses);
+    free(connexion);
+}
+
+/**
+ * @brief Accepte toutes les connexions en attente
+ * @param serveur Serveur
+ */
+static void accepterConnexions(Serveur *serveur)
+{
+    struct epoll_event evenement;
+    Connexion *connexion;
+    int descripteur;
+    int actif;
+
+    for (;;) {
+        descripteur = accept(serveur->ecoute, NULL, NULL);
+        if (descripteur == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+
+        connexion = (Connexion*)calloc(1, sizeof(Connexion));
+        if (connexion == NULL || rendreNonBloquant(descripteur) == 0) {
+            free(connexion);
+            close(descripteur);
+            continue;
+        }
+
+        /* Reponses deja regroupees par tour : pas d'attente de Nagle
+         * (sans effet sur une socket Unix) */
+        actif = 1;
+        setsockopt(descripteur, IPPROTO_TCP, TCP_NODELAY, &actif,
+                   sizeof(actif));
+
+        connexion->descripteur = descripteur;
+        connexion->evenements = EPOLLIN;
+
+        memset(&evenement, 0, sizeof(evenement));
+        evenement.events = EPOLLIN;
+        evenement.data.ptr = connexion;
+        if (epoll_ctl(serveur->epoll, EPOLL_CTL_ADD, descripteur,
+                      &evenement) == -1) {
+            free(connexion);
+            close(descripteur);
+            continue;
+        }
+
+        connexion->suivante = serveur->connexions;
+        if (serveur->connexions != NULL) {
+            serveur->connexions->precedente = connexion;
+        }
+        serveur->connexions = connexion;
+    }
+}
+
+/**
+ * @brief Inscrit une connexion parmi celles a servir en fin de tour
+ * @param serveur Serveur
+ * @param connexion Connexion
+ */
+static void programmerEnvoi(Serveur *serveur, Connexion *connexion)
+{
+    if (connexion->enAttente == 0) {
+        connexion->enAttente = 1;
+        connexion->suivanteEnvoi = serveur->aEnvoyer;
+        serveur->aEnvoyer = connexion;
+    }
+}
+
+/* ============================================================================
+ * COMMANDES
+ * ============================================================================ */
+
+/**
+ * @brief Ajoute les reponses composees aux reponses de la connexion
+ * @param serveur Serveur
+ * @param connexion Connexion
+ * @return 1 si succes, 0 si memoire insuffisante
+ */
+static int recupererReponses(Serveur *serveur, Connexion *connexion)
+{
+    char *reponses;
+    size_t capacite;
+
+    fflush(serveur->flux);
+    if (serveur->tailleFlux == 0) {
+        return 1;
+    }
+
+    /* Reponses deja toutes parties : le tampon repart du debut */
+    if (connexion->envoyes == connexion->tailleReponses) {
+        connexion->envoyes = 0;
+        connexion->tailleReponses = 0;
+    }
+
+    if (connexion->tailleReponses + serveur->tailleFlux >
+        connexion->capaciteReponses) {
+        capacite = connexion->capaciteReponses > 0 ?
+                   connexion->capaciteReponses : TAILLE_RECEPTION;
+        while (capacite < connexion->tailleReponses + serveur->tailleFlux) {
+            capacite *= 2;
+        }
+
+        reponses = (char*)realloc(connexion->reponses, capacite);
+        if (reponses == NULL) {
+            rewind(serveur->flux);
+            return 0;
+        }
+        connexion->reponses = reponses;
+        connexion->capaciteReponses = capacite;
+    }
+
+    memcpy(connexion->reponses + connexion->tailleReponses,
+           serveur->tamponFlux, serveur->tailleFlux);
+    connexion->tailleReponses += serveur->tailleFlux;
+
+    rewind(serveur->flux);
+
+    return 1;
+}
+
+/**
+ * @brief Execute les lignes completes recues sur une connexion
+ * @param serveur Serveur
+ * @param connexion Connexion
+ */
+static void executerLignes(Serveur *serveur, Connexion *connexion)
+{
+    char *debut;
+    char *fin;
+    char *limite;
+    size_t longueur;
+    int resultat;
+
+    debut = connexion->reception;
+    limite = connexion->reception + connexion->recus;
+
+    while ((fin = (char*)memchr(debut, '\n', limite - debut)) != NULL) {
+        *fin = '\0';
+
+        if (connexion->ligneTropLongue) {
+            /* Fin de la ligne deja refusee */
+            connexion->ligneTropLongue = 0;
+        } else {
+            longueur = (size_t)(fin - debut);
+            if (longueur > 0 && debut[longueur - 1] == '\r') {
+                debut[longueur - 1] = '\0';
+            }
+
+            connexion->numeroLigne++;
+            resultat = executerCommandeLot(serveur->parking, debut,
+                                           connexion->numeroLigne,
+                                           serveur->flux, serveur->bilan,
+                                           0);
+            if (resultat == 0) {
+                serveur->bilan->erreurs++;
+            }
+        }
+
+        debut = fin + 1;
+    }
+
+    connexion->recus = (size_t)(limite - debut);
+    memmove(connexion->reception, debut, connexion->recus);
+
+    /* Tampon plein sans fin de ligne : ligne refusee, suite ignoree */
+    if (connexion->recus == sizeof(connexion->reception)) {
+        if (connexion->ligneTropLongue == 0) {
+            connexion->numeroLigne++;
+            serveur->bilan->commandes++;
+            serveur->bilan->erreurs++;
+            fprintf(serveur->flux, "ERR %ld ligne trop longue\n",
+                    connexion->numeroLigne);
+            connexion->ligneTropLongue = 1;
+        }
+        connexion->recus = 0;
+    }
+}
+
+/**
+ * @brief Lit ce qui est disponible sur une connexion et l'execute
+ * @param serveur Serveur
+ * @param connexion Connexion prete en lecture
+ */
+static void lireConnexion(Serveur *serveur, Connexion *connexion)
+{
+    ssize_t lus;
+
+    while (connexion->fermer == 0 &&
+           connexion->tailleReponses - connexion->envoyes < LIMITE_REPONSES) {
+        lus = read(connexion->descripteur,
+                   connexion->reception + connexion->recus,
+                   sizeof(connexion->reception) - connexion->recus);
+
+        if (lus > 0) {
+            connexion->recus += (size_t)lus;
+            executerLignes(serveur, connexion);
+            if (recupererReponses(serveur, connexion) == 0) {
+                connexion->fermer = 1;
+            }
+        } else if (lus == 0) {
+            /* Fin d'envoi du client : derniere ligne sans fin de ligne
+             * executee, ses reponses partent avant la fermeture */
+            if (connexion->recus > 0) {
+                connexion->reception[connexion->recus++] = '\n';
+                executerLignes(serveur, connexion);
+                recupererReponses(serveur, connexion);
+            }
+            connexion->fermer = 1;
+        } else if (errno == EINTR) {
+            continue;
+        } else {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                connexion->fermer = 1;
+            }
+            break;
+        }
+    }
+
+    programmerEnvoi(serveur, connexion);
+}
+
+/**
+ * @brief Envoie les reponses en attente d'une connexion
+ * @param connexion Connexion
+ * @return 1 si la connexion reste utilisable, 0 sur erreur d'envoi
+ */
+static int envoyerReponses(Connexion *connexion)
+{
+    ssize_t envoyes;
+
+    while (connexion->envoyes < connexion->tailleReponses) {
+        envoyes = send(connexion->descripteur,
+                       connexion->reponses + connexion->envoyes,
+                       connexion->tailleReponses - connexion->envoyes,
+                       MSG_NOSIGNAL);
+
+        if (envoyes > 0) {
+            connexion->envoyes += (size_t)envoyes;
+        } else if (envoyes == -1 && errno == EINTR) {
+            continue;
+        } else if (envoyes == -1 &&
+                   (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return 1;
+        } else {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Fin de tour : operations durables, puis envoi des reponses
+ * @param serveur Serveur
+ * @return SUCCES, ou ERREUR_ENTREE_SORTIE si le journal n'a pu etre
+ *         synchronise (connexions en attente fermees sans reponse)
+ */
+static int terminerTour(Serveur *serveur)
+{
+    Connexion *connexion;
+    Connexion *suivante;
+
+    if (serveur->aEnvoyer == NULL) {
+        return SUCCES;
+    }
+
+    /* Une seule synchronisation pour toutes les commandes du tour ; sans
+     * elle, aucune operation du tour n'est confirmee */
+    if (synchroniserJournal(serveur->parking) == 0) {
+        for (connexion = serveur->aEnvoyer; connexion != NULL;
+             connexion = suivante) {
+            suivante = connexion->suivanteEnvoi;
+            fermerConnexion(serveur, connexion);
+        }
+        serveur->aEnvoyer = NULL;
+        return ERREUR_ENTREE_SORTIE;
+    }
+
+    for (connexion = serveur->aEnvoyer; connexion != NULL;
+         connexion = suivante) {
+        suivante = connexion->suivanteEnvoi;
+        connexion->enAttente = 0;
+        connexion->suivanteEnvoi = NULL;
+
+        if (envoyerReponses(connexion) == 0 ||
+            (connexion->fermer &&
+             connexion->envoyes == connexion->tailleReponses)) {
+            fermerConnexion(serveur, connexion);
+        } else {
+            surveillerConnexion(serveur, connexion);
+        }
+    }
+
+    serveur->aEnvoyer = NULL;
+
+    return SUCCES;
+}
+
+/* ============================================================================
+ * BOUCLE D'EVENEMENTS
+ * ============================================================================ */
+
+int executerServeur(Parking *parking, const char *adresse, BilanLot *bilan)
+{
+    struct epoll_event evenements[EVENEMENTS_PAR_TOUR];
+    struct epoll_event evenement;
+    Serveur serveur;
+    Connexion *connexion;
+    double debut;
+    double dernierEntretien;
+    int nombre;
+    int resultat;
+    int i;
+
+    if (parking == NULL || adresse == NULL || bilan == NULL) {
+        return ERREUR_PARAMETRE;
+    }
+
+    memset(&serveur, 0, sizeof(serveur));
+    memset(bilan, 0, sizeof(*bilan));
+    serveur.parking = parking;
+    serveur.bilan = bilan;
+    serveur.epoll = -1;
+
+    serveur.ecoute = ouvrirEcoute(adresse);
+    if (serveur.ecoute < 0) {
+        return serveur.ecoute;
+    }
+
+    serveur.flux = open_memstream(&serveur.tamponFlux, &serveur.tailleFlux);
+    serveur.epoll = epoll_create1(0);
+    memset(&evenement, 0, sizeof(evenement));
+    evenement.events = EPOLLIN;
+    evenement.data.ptr = NULL;
+
+    if (serveur.flux == NULL) {
+        resultat = ERREUR_MEMOIRE;
+    } else if (serveur.epoll == -1 ||
+               epoll_ctl(serveur.epoll, EPOLL_CTL_ADD, serveur.ecoute,
+                         &evenement) == -1) {
+        resultat = ERREUR_ENTREE_SORTIE;
+    } else {
+        resultat = SUCCES;
+    }
+
+    arretDemande = 0;
+    signal(SIGINT, demanderArret);
+    signal(SIGTERM, demanderArret);
+    signal(SIGUSR1, demanderTrace);
+    debut = instantServeur();
+    dernierEntretien = debut;
+
+    while (resultat == SUCCES && arretDemande == 0) {
+        nombre = epoll_wait(serveur.epoll, evenements, EVENEMENTS_PAR_TOUR,
+                            PERIODE_ENTRETIEN_MS);
+        if (nombre == -1) {
+            if (errno != EINTR) {
+                resultat = ERREUR_ENTREE_SORTIE;
+            }
+            continue;
+        }
+
+        for (i = 0; i < nombre; i++) {
+            connexion = (Connexion*)evenements[i].data.ptr;
+
+            if (connexion == NULL) {
+                accepterConnexions(&serveur);
+            } else if (evenements[i].events & (EPOLLIN | EPOLLHUP |
+                                               EPOLLERR)) {
+                lireConnexion(&serveur, connexion);
+            } else {
+                programmerEnvoi(&serveur, connexion);
+            }
+        }
+
+        resultat = terminerTour(&serveur);
+        if (resultat != SUCCES) {
+            break;
+        }
+
+        /* Entretien de la boucle interactive, au plus une fois par periode */
+        if (instantServeur() - dernierEntretien >=
+            PERIODE_ENTRETIEN_MS / 1000.0) {
+            archiverHistorique(parking);
+            sauvegarderSiEcheance(parking);
+            exporterMetriquesSiEcheance(parking);
+            synchroniserJournal(parking);
+            if (traceDemandee) {
+                traceDemandee = 0;
+                exporterTrace();
+            }
+            dernierEntretien = instantServeur();
+        }
+    }
+
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    signal(SIGUSR1, SIG_DFL);
+
+    /* Reponses deja composees envoyees si possible, puis fermeture */
+    if (terminerTour(&serveur) != SUCCES && resultat == SUCCES) {
+        resultat = ERREUR_ENTREE_SORTIE;
+    }
+    while (serveur.connexions != NULL) {
+        fermerConnexion(&serveur, serveur.connexions);
+    }
+
+    close(serveur.ecoute);
+    if (estNumeroPort(adresse) == 0) {
+        unlink(adresse);
+    }
+    if (serveur.epoll != -1) {
+        close(serveur.epoll);
+    }
+    if (serveur.flux != NULL) {
+        fclose(serveur.flux);
+    }
+    free(serveur.tamponFlux);
+
+    bilan->secondes = instantServeur() - debut;
+
+    return resultat;
+}
+
+#else /* __linux__ */
+
+int executerServeur(Parking *parking, const char *adresse, BilanLot *bilan)
+{
+    /* La boucle d'evenements repose sur epoll */
+    (void)parking;
+    (void)adresse;
+    (void)bilan;
+
+    return ERREUR_PARAMETRE;
+}
+
+#endif /* __linux__ */
@@ -1,6 +1,6 @@
 /**
  * @file statistiques_suite.c
- * @brief Implementation des fonctions d'historique et sauvegarde
+ * @brief Implementation des affichages : historique, recettes et rapport
  * @date Decembre 2025
  */
 
@@ -8,7 +8,10 @@
 #include <stdlib.h>
 #include <string.h>
 #include "../include/statistiques.h"
+#include "../include/parking.h"
 #include "../include/utilitaires.h"
+#include "../include/rendu.h"
+#include "../include/instrumentation.h"
 #include "../include/prototypes.h"
 
 /* ============================================================================
@@ -27,174 +30,289 @@ void afficherResumeJournalier(const Parking *parking)
     maintenant = obtenirHorodatageActuel();
     formaterHorodatage(maintenant, buffer);
     
-    printf("\n");
-    afficherLigne('=', 50);
-    printf("      RESUME JOURNALIER\n");
-    afficherLigne('=', 50);
-    
-    printf("Date/Heure actuelle  : %s\n", buffer);
-    printf("Parking              : %s\n", parking->nom);
-    afficherLigne('-', 50);
-    printf("Places libres        : %d / %d\n", 
-           parking->placesLibres, parking->nombrePlaces);
-    printf("Taux d'occupation    : %.1f%%\n", 
-           calculerTauxOccupation(parking));
-    printf("Recette du jour      : %.2f FCFA\n", 
-           parking->recetteJournaliere);
-    afficherLigne('=', 50);
+    commencerRendu();
+    
+    rendreTexte("\n");
+    rendreLigne('=', 50);
+    rendreTexte("      RESUME JOURNALIER\n");
+    rendreLigne('=', 50);
+    
+    rendreTexte("Date/Heure actuelle  : %s\n", buffer);
+    rendreTexte("Parking              : %s\n", parking->nom);
+    rendreLigne('-', 50);
+    rendreTexte("Places libres        : %d / %d\n", 
+                parking->placesLibres, parking->nombrePlaces);
+    rendreTexte("Taux d'occupation    : %.1f%%\n", 
+                calculerTauxOccupation(parking));
+    rendreTexte("Recette du jour      : %.2f FCFA\n", 
+                parking->recetteJournaliere);
+    rendreLigne('=', 50);
+    
+    terminerRendu();
+}
+
+/**
+ * @brief Rend une ligne du tableau de l'historique
+ * @param vehicule Vehicule de l'historique
+ */
+static void rendreLigneHistorique(const Vehicule *vehicule)
+{
+    char bufferEntree[30];
+    char bufferSortie[30];
+    
+    formaterHorodatage(vehicule->entree, bufferEntree);
+    
+    if (vehicule->estPresent == 0) {
+        formaterHorodatage(vehicule->sortie, bufferSortie);
+    } else {
+        strcpy(bufferSortie, "En cours");
+    }
+    
+    rendreTexte("%-15s %-10s %-18s %-18s ",
+                vehicule->plaque,
+                typeVehiculeEnChaine(vehicule->type),
+                bufferEntree,
+                bufferSortie);
+    
+    if (vehicule->estPresent == 0) {
+        rendreTexte("%.2f FCFA\n", vehicule->montantPaye);
+    } else {
+        rendreTexte("-\n");
+    }
 }
 
 void afficherHistorique(const Parking *parking, int nombreMax)
 {
     int i;
     int compteur;
-    char bufferEntree[30];
-    char bufferSortie[30];
     const Vehicule *vehicule;
     
     if (parking == NULL) {
         return;
     }
     
-    printf("\n");
-    afficherLigne('=', 90);
-    printf("   HISTORIQUE DES VEHICULES (derniers %d)\n", nombreMax);
-    afficherLigne('=', 90);
+    commencerRendu();
+    
+    rendreTexte("\n");
+    rendreLigne('=', 90);
+    rendreTexte("   HISTORIQUE DES VEHICULES (derniers %d)\n", nombreMax);
+    rendreLigne('=', 90);
     
-    printf("%-15s %-10s %-18s %-18s %-10s\n",
-           "Plaque", "Type", "Entree", "Sortie", "Montant");
-    afficherLigne('-', 90);
+    rendreTexte("%-15s %-10s %-18s %-18s %-10s\n",
+                "Plaque", "Type", "Entree", "Sortie", "Montant");
+    rendreLigne('-', 90);
     
     compteur = 0;
     
     /* Afficher depuis le plus recent */
     for (i = parking->nombreVehicules - 1; i >= 0 && compteur < nombreMax; i--) {
-        vehicule = &parking->historique[i];
-        
-        formaterHorodatage(vehicule->entree, bufferEntree);
-        
-        if (vehicule->estPresent == 0) {
-            formaterHorodatage(vehicule->sortie, bufferSortie);
-        } else {
-            strcpy(bufferSortie, "En cours");
-        }
-        
-        printf("%-15s %-10s %-18s %-18s ",
-               vehicule->plaque,
-               typeVehiculeEnChaine(vehicule->type),
-               bufferEntree,
-               bufferSortie);
-        
-        if (vehicule->estPresent == 0) {
-            printf("%.2f FCFA\n", vehicule->montantPaye);
-        } else {
-            printf("-\n");
+        vehicule = lireVehicule(parking, i);
+        if (vehicule == NULL) {
+            continue;
         }
         
+        rendreLigneHistorique(vehicule);
         compteur++;
     }
     
-    afficherLigne('=', 90);
-    printf("Total affiche : %d enregistrements\n", compteur);
+    rendreLigne('=', 90);
+    rendreTexte("Total affiche : %d enregistrements\n", compteur);
+    
+    terminerRendu();
 }
 
-void afficherRecettesParType(const Parking *parking)
+void afficherHistoriqueTrie(const Parking *parking, CritereTri critere,
+                            int nombreMax)
 {
+    static const char *titres[] = {
+        "", "PAR PLAQUE", "PAR DATE D'ENTREE", "PAR MONTANT DECROISSANT"
+    };
+    const Vehicule *vehicule;
+    int *permutation;
+    int resultat;
+    int compteur;
     int i;
-    float recettesParType[5];
-    int compteurParType[5];
     
-    if (parking == NULL) {
+    if (parking == NULL || critere < TRI_PAR_PLAQUE ||
+        critere > TRI_PAR_MONTANT) {
         return;
     }
     
-    /* Initialisation */
-    for (i = 0; i < 5; i++) {
-        recettesParType[i] = 0.0f;
-        compteurParType[i] = 0;
+    /* Permutation de tout l'historique : aucun enregistrement deplace */
+    permutation = (int*)malloc((parking->nombreVehicules > 0 ?
+                                parking->nombreVehicules : 1) * sizeof(int));
+    resultat = permutation == NULL ? ERREUR_MEMOIRE :
+               trierIndicesHistorique(parking, critere, permutation);
+    if (resultat != SUCCES) {
+        printf("Erreur : Tri de l'historique : %s\n",
+               messageErreur(resultat));
+        free(permutation);
+        return;
     }
     
-    /* Calcul des recettes par type */
-    for (i = 0; i < parking->nombreVehicules; i++) {
-        if (parking->historique[i].estPresent == 0) {
-            TypeVehicule type = parking->historique[i].type;
-            if (type >= VOITURE && type <= BUS) {
-                recettesParType[type] += parking->historique[i].montantPaye;
-                compteurParType[type]++;
-            }
+    commencerRendu();
+    
+    rendreTexte("\n");
+    rendreLigne('=', 90);
+    rendreTexte("   HISTORIQUE DES VEHICULES %s (%d premiers)\n",
+                titres[critere], nombreMax);
+    rendreLigne('=', 90);
+    
+    rendreTexte("%-15s %-10s %-18s %-18s %-10s\n",
+                "Plaque", "Type", "Entree", "Sortie", "Montant");
+    rendreLigne('-', 90);
+    
+    compteur = 0;
+    
+    for (i = 0; i < parking->nombreVehicules && compteur < nombreMax; i++) {
+        vehicule = lireVehicule(parking, permutation[i]);
+        if (vehicule == NULL) {
+            continue;
         }
+        
+        rendreLigneHistorique(vehicule);
+        compteur++;
     }
     
-    printf("\n");
-    afficherLigne('=', 50);
-    printf("   RECETTES PAR TYPE DE VEHICULE\n");
-    afficherLigne('=', 50);
-    
-    printf("%-15s %-10s %-15s\n", "Type", "Nombre", "Recettes");
-    afficherLigne('-', 50);
+    rendreLigne('=', 90);
+    rendreTexte("Total affiche : %d enregistrements sur %d\n", compteur,
+                parking->nombreVehicules);
     
-    printf("%-15s %-10d %.2f FCFA\n", "Voiture", 
-           compteurParType[VOITURE], recettesParType[VOITURE]);
-    printf("%-15s %-10d %.2f FCFA\n", "Moto", 
-           compteurParType[MOTO], recettesParType[MOTO]);
-    printf("%-15s %-10d %.2f FCFA\n", "Camion", 
-           compteurParType[CAMION], recettesParType[CAMION]);
-    printf("%-15s %-10d %.2f FCFA\n", "Bus", 
-           compteurParType[BUS], recettesParType[BUS]);
+    terminerRendu();
     
-    afficherLigne('=', 50);
+    free(permutation);
 }
 
-/* ============================================================================
- * SAUVEGARDE ET CHARGEMENT
- * ============================================================================ */
-
-int sauvegarderDonnees(const Parking *parking, const char *nomFichier)
+void afficherRecettesParType(const Parking *parking)
 {
-    FILE *fichier;
-    int i;
+    const int *compteurParType;
+    const float *recettesParType;
     
-    if (parking == NULL || nomFichier == NULL) {
-        return 0;
+    if (parking == NULL) {
+        return;
     }
     
-    fichier = fopen(nomFichier, "wb");
-    if (fichier == NULL) {
-        printf("Erreur : Impossible d'ouvrir le fichier %s\n", nomFichier);
-        return 0;
-    }
+    /* Sorties et recettes cumulees par type */
+    compteurParType = parking->agregats.sortiesParType;
+    recettesParType = parking->agregats.recettesParType;
     
-    /* Ecriture des donnees du parking */
-    fwrite(parking, sizeof(Parking), 1, fichier);
+    commencerRendu();
     
-    fclose(fichier);
-    printf("Donnees sauvegardees avec succes dans %s\n", nomFichier);
+    rendreTexte("\n");
+    rendreLigne('=', 50);
+    rendreTexte("   RECETTES PAR TYPE DE VEHICULE\n");
+    rendreLigne('=', 50);
     
-    return 1;
+    rendreTexte("%-15s %-10s %-15s\n", "Type", "Nombre", "Recettes");
+    rendreLigne('-', 50);
+    
+    rendreTexte("%-15s %-10d %.2f FCFA\n", "Voiture", 
+                compteurParType[VOITURE], recettesParType[VOITURE]);
+    rendreTexte("%-15s %-10d %.2f FCFA\n", "Moto", 
+                compteurParType[MOTO], recettesParType[MOTO]);
+    rendreTexte("%-15s %-10d %.2f FCFA\n", "Camion", 
+                compteurParType[CAMION], recettesParType[CAMION]);
+    rendreTexte("%-15s %-10d %.2f FCFA\n", "Bus", 
+                compteurParType[BUS], recettesParType[BUS]);
+    
+    rendreLigne('=', 50);
+    
+    terminerRendu();
 }
 
-int chargerDonnees(Parking *parking, const char *nomFichier)
+void afficherMesuresOperations(void)
 {
-    FILE *fichier;
+    ResumeMesure resume;
+    int operation;
+    int code;
     
-    if (parking == NULL || nomFichier == NULL) {
-        return 0;
-    }
+    commencerRendu();
+    
+    rendreTexte("\n");
+    rendreLigne('=', 78);
+    rendreTexte("   LATENCES ET ERREURS DES OPERATIONS (microsecondes)\n");
+    rendreLigne('=', 78);
     
-    fichier = fopen(nomFichier, "rb");
-    if (fichier == NULL) {
-        printf("Information : Aucune sauvegarde trouvee.\n");
-        return 0;
+    rendreTexte("%-21s %9s %9s %8s %8s %9s %8s\n", "Operation", "Appels",
+                "Chrono.", "p50", "p99", "Max", "Moyenne");
+    rendreLigne('-', 78);
+    
+    for (operation = 0; operation < NOMBRE_MESURES; operation++) {
+        resumerMesure((OperationMesuree)operation, &resume);
+        
+        rendreTexte("%-21s %9lld %9lld %8.2f %8.2f %9.2f %8.2f\n",
+                    nomMesure((OperationMesuree)operation), resume.nombre,
+                    resume.chronometrees, resume.p50 / 1000.0,
+                    resume.p99 / 1000.0, resume.maximum / 1000.0,
+                    resume.moyenne / 1000.0);
+        
+        /* Causes d'echec rencontrees */
+        for (code = 1; code < CODES_MESURES; code++) {
+            if (resume.retours[code] > 0) {
+                rendreTexte("    echecs %-18s : %lld\n", nomCodeMesure(-code),
+                            resume.retours[code]);
+            }
+        }
     }
     
-    /* Lecture des donnees du parking */
-    if (fread(parking, sizeof(Parking), 1, fichier) != 1) {
-        fclose(fichier);
-        return 0;
+    rendreLigne('=', 78);
+    rendreTexte("Chrono. : appels hors d'une autre operation mesuree\n");
+    
+    terminerRendu();
+}
+
+/* ============================================================================
+ * AFFICHAGE DES RAPPORTS
+ * ============================================================================ */
+
+void afficherRapportComplet(const Parking *parking)
+{
+    Statistiques stats;
+    int compteurs[5];
+    
+    if (parking == NULL) {
+        return;
     }
     
-    fclose(fichier);
-    printf("Donnees chargees avec succes depuis %s\n", nomFichier);
+    calculerStatistiques(parking, &stats);
+    compterVehiculesParType(parking, compteurs);
+    
+    commencerRendu();
+    
+    rendreTexte("\n");
+    rendreLigne('=', 60);
+    rendreTexte("         RAPPORT COMPLET DU PARKING\n");
+    rendreLigne('=', 60);
+    
+    rendreTexte("\n[INFORMATIONS GENERALES]\n");
+    rendreLigne('-', 40);
+    rendreTexte("Nom du parking       : %s\n", parking->nom);
+    rendreTexte("Capacite totale      : %d places\n", parking->nombrePlaces);
+    rendreTexte("Places libres        : %d\n", parking->placesLibres);
+    rendreTexte("Places occupees      : %d\n", parking->placesOccupees);
+    rendreTexte("Taux d'occupation    : %.1f%%\n", stats.tauxOccupation);
+    
+    rendreTexte("\n[STATISTIQUES VEHICULES]\n");
+    rendreLigne('-', 40);
+    rendreTexte("Total entrees        : %d\n", stats.totalEntrees);
+    rendreTexte("Total sorties        : %d\n", stats.totalSorties);
+    rendreTexte("Vehicules presents   : %d\n", 
+                stats.totalEntrees - stats.totalSorties);
+    
+    rendreTexte("\n[REPARTITION PAR TYPE]\n");
+    rendreLigne('-', 40);
+    rendreTexte("Voitures             : %d\n", compteurs[VOITURE]);
+    rendreTexte("Motos                : %d\n", compteurs[MOTO]);
+    rendreTexte("Camions              : %d\n", compteurs[CAMION]);
+    rendreTexte("Bus                  : %d\n", compteurs[BUS]);
+    
+    rendreTexte("\n[RECETTES]\n");
+    rendreLigne('-', 40);
+    rendreTexte("Recette journaliere  : %.2f FCFA\n", parking->recetteJournaliere);
+    rendreTexte("Recette totale       : %.2f FCFA\n", parking->recetteTotale);
+    rendreTexte("Recette moyenne      : %.2f FCFA\n", stats.recetteMoyenne);
+    
+    rendreLigne('=', 60);
     
-    return 1;
+    terminerRendu();
 }
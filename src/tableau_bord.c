@@ -0,0 +1,407 @@
+/**
+ * @file tableau_bord.c
+ * @brief Implementation du tableau de bord en direct
+ * @date Decembre 2025
+ *
+ * L'image affichee est gardee en memoire (un symbole par place et le
+ * texte des compteurs). A chaque periode, les operations nouvelles du
+ * journal sont appliquees, puis l'image courante est comparee a la
+ * precedente : seules les differences sont envoyees, en une ecriture.
+ * Une periode sans operation n'ecrit rien.
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include "../include/tableau_bord.h"
+#include "../include/parking.h"
+#include "../include/persistance.h"
+#include "../include/journal.h"
+#include "../include/rendu.h"
+
+/** Places par ligne de la carte (sans variable COLUMNS) */
+#define PLACES_PAR_LIGNE_DEFAUT 50
+
+/** Premiere ligne et premiere colonne de la grille des places */
+#define LIGNE_CARTE 7
+#define COLONNE_CARTE 8
+
+/** Lignes des compteurs, reecrites sur place */
+#define LIGNE_COMPTEURS 3
+#define LIGNE_ACTIVITE 4
+
+/** Longueur maximale d'une ligne de compteurs */
+#define TAILLE_COMPTEURS 160
+
+/* ============================================================================
+ * IMAGE AFFICHEE
+ * ============================================================================ */
+
+/**
+ * @struct ImageTableau
+ * @brief Contenu actuellement a l'ecran
+ */
+typedef struct {
+    char *symboles;
+    int nombrePlaces;
+    int placesParLigne;
+    char compteurs[TAILLE_COMPTEURS];
+    char activite[TAILLE_COMPTEURS];
+} ImageTableau;
+
+/** Positionne par Ctrl+C */
+static volatile sig_atomic_t arretDemande = 0;
+
+static void demanderArret(int signal)
+{
+    (void)signal;
+    arretDemande = 1;
+}
+
+/**
+ * @brief Symbole d'une place sur la carte (meme legende que la carte)
+ * @param etat Etat de la place
+ * @return L, O, R ou X
+ */
+static char symbolePlace(EtatPlace etat)
+{
+    static const char symboles[] = "LORX";
+
+    if (etat < LIBRE || etat > HORS_SERVICE) {
+        return '?';
+    }
+
+    return symboles[etat];
+}
+
+/**
+ * @brief Places par ligne d'apres la largeur du terminal
+ * @return Multiple de 10 entre 10 et 200
+ */
+static int calculerPlacesParLigne(void)
+{
+    const char *colonnes;
+    int largeur;
+
+    colonnes = getenv("COLUMNS");
+    if (colonnes == NULL || (largeur = atoi(colonnes)) <= 0) {
+        return PLACES_PAR_LIGNE_DEFAUT;
+    }
+
+    largeur = (largeur - COLONNE_CARTE) / 10 * 10;
+    if (largeur < 10) {
+        return 10;
+    }
+
+    return largeur > 200 ? 200 : largeur;
+}
+
+/* ============================================================================
+ * COMPOSITION DES IMAGES
+ * ============================================================================ */
+
+/**
+ * @brief Compose l'image complete : cadre, legende et grille des places
+ * @param image Image a (re)construire
+ * @param parking Pointeur vers le parking
+ * @return 1 si succes, 0 si memoire insuffisante
+ */
+static int rendreImageComplete(ImageTableau *image, const Parking *parking)
+{
+    char *symboles;
+    int largeur;
+    int i;
+
+    symboles = (char*)realloc(image->symboles,
+                              parking->nombrePlaces > 0 ?
+                              (size_t)parking->nombrePlaces : 1);
+    if (symboles == NULL) {
+        return 0;
+    }
+
+    image->symboles = symboles;
+    image->nombrePlaces = parking->nombrePlaces;
+    image->placesParLigne = calculerPlacesParLigne();
+    largeur = COLONNE_CARTE - 1 + image->placesParLigne;
+
+    /* Les compteurs seront reecrits par la mise a jour qui suit */
+    image->compteurs[0] = '\0';
+    image->activite[0] = '\0';
+
+    rendreEffacement();
+    rendreTexte("\033[?25l");
+    rendreTexte("TABLEAU DE BORD : %s\n", parking->nom);
+    rendreLigne('=', largeur);
+    rendreTexte("\n\n");
+    rendreTexte("Legende : [L] Libre  [O] Occupee  [R] Reservee  "
+                "[X] Hors service\n");
+    rendreLigne('-', largeur);
+
+    for (i = 0; i < parking->nombrePlaces; i++) {
+        if (i % image->placesParLigne == 0) {
+            if (i > 0) {
+                rendreTexte("\n");
+            }
+            rendreTexte("%6d ", i + 1);
+        }
+        image->symboles[i] = symbolePlace(obtenirPlace(parking, i)->etat);
+        rendreTexte("%c", image->symboles[i]);
+    }
+
+    rendreTexte("\n");
+    rendreLigne('-', largeur);
+
+    return 1;
+}
+
+/**
+ * @brief Reecrit une ligne de compteurs si son texte a change
+ * @param precedent Texte affiche, remplace par le nouveau
+ * @param texte Nouveau texte
+ * @param ligne Ligne de l'ecran
+ * @return 1 si la ligne a ete reecrite, 0 sinon
+ */
+static int rendreCompteurs(char *precedent, const char *texte, int ligne)
+{
+    if (strcmp(precedent, texte) == 0) {
+        return 0;
+    }
+
+    rendreTexte("\033[%d;1H%s\033[K", ligne, texte);
+    strcpy(precedent, texte);
+
+    return 1;
+}
+
+/**
+ * @brief Compose les seules differences entre l'image et le parking
+ * @param image Image affichee, mise a jour
+ * @param parking Pointeur vers le parking
+ * @return Nombre d'elements reecrits
+ */
+static int rendreDifferences(ImageTableau *image, const Parking *parking)
+{
+    char texte[TAILLE_COMPTEURS];
+    int parEtat[4];
+    int ligne;
+    int colonne;
+    int ligneCurseur;
+    int colonneCurseur;
+    int modifies;
+    int i;
+    char symbole;
+    EtatPlace etat;
+
+    memset(parEtat, 0, sizeof(parEtat));
+    ligneCurseur = 0;
+    colonneCurseur = 0;
+    modifies = 0;
+
+    for (i = 0; i < image->nombrePlaces; i++) {
+        etat = obtenirPlace(parking, i)->etat;
+        if (etat >= LIBRE && etat <= HORS_SERVICE) {
+            parEtat[etat]++;
+        }
+
+        symbole = symbolePlace(etat);
+        if (symbole == image->symboles[i]) {
+            continue;
+        }
+
+        /* Deplacement du curseur, sauf pour une place voisine de la
+         * precedente */
+        ligne = LIGNE_CARTE + i / image->placesParLigne;
+        colonne = COLONNE_CARTE + i % image->placesParLigne;
+        if (ligne != ligneCurseur || colonne != colonneCurseur) {
+            rendreTexte("\033[%d;%dH", ligne, colonne);
+        }
+        rendreTexte("%c", symbole);
+
+        image->symboles[i] = symbole;
+        ligneCurseur = ligne;
+        colonneCurseur = colonne + 1;
+        modifies++;
+    }
+
+    snprintf(texte, sizeof(texte),
+             "Libres : %d | Occupees : %d | Reservees : %d | "
+             "Hors service : %d | Occupation : %.1f%%",
+             parEtat[LIBRE], parEtat[OCCUPEE], parEtat[RESERVEE],
+             parEtat[HORS_SERVICE],
+             image->nombrePlaces > 0 ?
+             (float)parEtat[OCCUPEE] / image->nombrePlaces * 100 : 0.0f);
+    modifies += rendreCompteurs(image->compteurs, texte, LIGNE_COMPTEURS);
+
+    snprintf(texte, sizeof(texte),
+             "Entrees : %d | Sorties : %d | Recette du jour : "
+             "%.2f FCFA | Operation %lu",
+             parking->agregats.totalEntrees, parking->agregats.totalSorties,
+             parking->recetteJournaliere,
+             (unsigned long)parking->sequenceJournal);
+    modifies += rendreCompteurs(image->activite, texte, LIGNE_ACTIVITE);
+
+    return modifies;
+}
+
+/**
+ * @brief Place le curseur sous la carte
+ * @param image Image affichee
+ */
+static void rendreCurseurSousCarte(const ImageTableau *image)
+{
+    int lignes;
+
+    lignes = (image->nombrePlaces + image->placesParLigne - 1) /
+             image->placesParLigne;
+    rendreTexte("\033[%d;1H", LIGNE_CARTE + lignes + 1);
+}
+
+/* ============================================================================
+ * SUIVI DU JOURNAL
+ * ============================================================================ */
+
+/**
+ * @brief Recharge la sauvegarde (journal compacte ou en retard sur elle)
+ * @param parking Pointeur vers le parking
+ * @param fichierSauvegarde Fichier de sauvegarde
+ * @return SUCCES ou code d'erreur de chargerDonnees
+ */
+static int rechargerTableau(Parking *parking, const char *fichierSauvegarde)
+{
+    char nom[MAX_CHAINE];
+    int nombrePlaces;
+    int resultat;
+
+    resultat = chargerDonnees(parking, fichierSauvegarde);
+    if (resultat != ERREUR_FICHIER_ABSENT) {
+        return resultat;
+    }
+
+    /* Sauvegarde supprimee : parking vide de meme configuration */
+    strcpy(nom, parking->nom);
+    nombrePlaces = parking->nombrePlaces;
+    libererParking(parking);
+
+    return initialiserParking(parking, nom, nombrePlaces) ? SUCCES :
+                                                            ERREUR_MEMOIRE;
+}
+
+/**
+ * @brief Rattrape l'instance en service : sauvegarde puis journal
+ * @param parking Pointeur vers le parking
+ * @param fichierSauvegarde Fichier de sauvegarde
+ * @param fichierJournal Journal suivi
+ * @param position Position de lecture du journal
+ *
+ * L'image n'est pas refaite apres un rechargement : la comparaison avec
+ * l'image affichee reste valable.
+ */
+static void suivreInstance(Parking *parking, const char *fichierSauvegarde,
+                          const char *fichierJournal, long *position)
+{
+    uint32_t sequence;
+    int recharger;
+
+    /* Une sauvegarde plus recente que l'etat affiche (le journal a pu
+     * etre compacte entre deux images) */
+    recharger = lireSequenceSauvegarde(fichierSauvegarde, &sequence) ==
+                SUCCES && sequence > parking->sequenceJournal;
+
+    if (recharger == 0) {
+        recharger = suivreJournal(parking, fichierJournal, position) ==
+                    ERREUR_FICHIER_INVALIDE;
+        if (recharger == 0) {
+            return;
+        }
+    }
+
+    if (rechargerTableau(parking, fichierSauvegarde) == SUCCES) {
+        *position = 0;
+        suivreJournal(parking, fichierJournal, position);
+    }
+}
+
+/**
+ * @brief Attend entre deux images (interrompu par Ctrl+C)
+ * @param millisecondes Delai
+ */
+static void attendreMillisecondes(int millisecondes)
+{
+#ifdef _WIN32
+    Sleep((DWORD)millisecondes);
+#else
+    struct timespec delai;
+
+    delai.tv_sec = millisecondes / 1000;
+    delai.tv_nsec = (long)(millisecondes % 1000) * 1000000L;
+    nanosleep(&delai, NULL);
+#endif
+}
+
+int executerTableauBord(Parking *parking, const char *fichierSauvegarde,
+                        const char *fichierJournal,
+                        int periodeMillisecondes)
+{
+    ImageTableau image;
+    long position;
+    int resultat;
+
+    if (parking == NULL || fichierSauvegarde == NULL ||
+        fichierJournal == NULL || periodeMillisecondes <= 0) {
+        return ERREUR_PARAMETRE;
+    }
+
+    memset(&image, 0, sizeof(image));
+    position = 0;
+    resultat = SUCCES;
+    arretDemande = 0;
+    signal(SIGINT, demanderArret);
+
+    while (arretDemande == 0) {
+        /* Operations ajoutees depuis l'image precedente */
+        suivreInstance(parking, fichierSauvegarde, fichierJournal, &position);
+
+        commencerRendu();
+
+        /* Image complete au depart et si le nombre de places change */
+        if (image.symboles == NULL ||
+            image.nombrePlaces != parking->nombrePlaces) {
+            if (rendreImageComplete(&image, parking) == 0) {
+                terminerRendu();
+                resultat = ERREUR_MEMOIRE;
+                break;
+            }
+        }
+
+        if (rendreDifferences(&image, parking) > 0) {
+            rendreCurseurSousCarte(&image);
+        }
+
+        terminerRendu();
+
+        attendreMillisecondes(periodeMillisecondes);
+    }
+
+    signal(SIGINT, SIG_DFL);
+
+    /* Curseur rendu au terminal, sous la carte */
+    commencerRendu();
+    if (image.symboles != NULL) {
+        rendreCurseurSousCarte(&image);
+    }
+    rendreTexte("\033[?25h");
+    terminerRendu();
+
+    free(image.symboles);
+
+    return resultat;
+}
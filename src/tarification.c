@@ -0,0 +1,357 @@
+/**
+ * @file tarification.c
+ * @brief Implementation du moteur de tarification par tables
+ * @date Decembre 2025
+ *
+ * A chaque chargement, les tarifs sont compiles en tables de prix
+ * cumules, plafonnes, indexees par type, heure d'entree et nombre
+ * d'heures facturees. Le prix d'un sejour se lit alors directement :
+ *   jours complets x prix d'une journee + cumul des heures restantes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/tarification.h"
+#include "../include/trace.h"
+#include "../include/utilitaires.h"
+
+/** Nombre d'heures d'une journee (une bande par heure) */
+#define HEURES_PAR_JOUR 24
+
+/* ============================================================================
+ * TABLES DE TARIFICATION
+ * ============================================================================ */
+
+/**
+ * @struct TarifType
+ * @brief Parametres de tarification d'un type de vehicule
+ */
+typedef struct {
+    float tarifHoraire;
+    float plafondJournalier;
+    int franchiseMinutes;
+} TarifType;
+
+/**
+ * @struct GrilleTarifaire
+ * @brief Parametres et tables compilees (indice 0 : type inconnu)
+ */
+typedef struct {
+    TarifType types[5];
+    float coefficients[HEURES_PAR_JOUR];
+    float cumul[5][HEURES_PAR_JOUR][HEURES_PAR_JOUR];
+    float prixJour[5];
+    float cumulUniforme[5][HEURES_PAR_JOUR];
+    float prixJourUniforme[5];
+    int compilee;
+} GrilleTarifaire;
+
+/** Grille courante */
+static GrilleTarifaire grille;
+
+/**
+ * @brief Applique le plafond journalier a un montant
+ * @param montant Montant brut
+ * @param plafond Plafond (0 ou negatif : pas de plafond)
+ * @return Montant plafonne
+ */
+static float plafonner(float montant, float plafond)
+{
+    if (plafond > 0 && montant > plafond) {
+        return plafond;
+    }
+    return montant;
+}
+
+/**
+ * @brief Compile les tables de prix cumules a partir des parametres
+ * @param g Grille a compiler
+ */
+static void compilerGrille(GrilleTarifaire *g)
+{
+    int t;
+    int h;
+    int k;
+    float somme;
+    float sommeUniforme;
+    float sommeJour;
+    const TarifType *tarif;
+
+    for (t = 0; t < 5; t++) {
+        tarif = &g->types[t];
+
+        /* Prix d'une journee complete : somme des 24 bandes, plafonnee */
+        sommeJour = 0.0f;
+        for (h = 0; h < HEURES_PAR_JOUR; h++) {
+            sommeJour += tarif->tarifHoraire * g->coefficients[h];
+        }
+        g->prixJour[t] = plafonner(sommeJour, tarif->plafondJournalier);
+        g->prixJourUniforme[t] = plafonner(tarif->tarifHoraire * HEURES_PAR_JOUR,
+                                           tarif->plafondJournalier);
+
+        /* Cumul de k heures (k < 24) commencant a l'heure h */
+        sommeUniforme = 0.0f;
+        for (k = 0; k < HEURES_PAR_JOUR; k++) {
+            g->cumulUniforme[t][k] = plafonner(sommeUniforme,
+                                               tarif->plafondJournalier);
+            sommeUniforme += tarif->tarifHoraire;
+        }
+
+        for (h = 0; h < HEURES_PAR_JOUR; h++) {
+            somme = 0.0f;
+            for (k = 0; k < HEURES_PAR_JOUR; k++) {
+                g->cumul[t][h][k] = plafonner(somme, tarif->plafondJournalier);
+                somme += tarif->tarifHoraire *
+                         g->coefficients[(h + k) % HEURES_PAR_JOUR];
+            }
+        }
+    }
+
+    g->compilee = 1;
+}
+
+/**
+ * @brief Remplit une grille avec les tarifs par defaut
+ * @param g Grille a remplir
+ */
+static void remplirTarifsParDefaut(GrilleTarifaire *g)
+{
+    static const float coefficientsTypes[5] = { 1.0f, 1.0f, 0.5f, 1.5f, 2.0f };
+    int t;
+    int h;
+
+    for (t = 0; t < 5; t++) {
+        g->types[t].tarifHoraire = TARIF_HORAIRE * coefficientsTypes[t];
+        g->types[t].plafondJournalier = TARIF_JOURNALIER_MAX;
+        g->types[t].franchiseMinutes = 0;
+    }
+
+    for (h = 0; h < HEURES_PAR_JOUR; h++) {
+        g->coefficients[h] = 1.0f;
+    }
+}
+
+void appliquerTarifsParDefaut(void)
+{
+    remplirTarifsParDefaut(&grille);
+    compilerGrille(&grille);
+}
+
+/* ============================================================================
+ * LECTURE DU FICHIER DE TARIFS
+ * ============================================================================ */
+
+/**
+ * @brief Convertit un nom de type de vehicule
+ * @param nom Nom en majuscules (VOITURE, MOTO, CAMION, BUS)
+ * @return Type correspondant, 0 si inconnu
+ */
+static int typeDepuisNom(const char *nom)
+{
+    if (strcmp(nom, "VOITURE") == 0) {
+        return VOITURE;
+    }
+    if (strcmp(nom, "MOTO") == 0) {
+        return MOTO;
+    }
+    if (strcmp(nom, "CAMION") == 0) {
+        return CAMION;
+    }
+    if (strcmp(nom, "BUS") == 0) {
+        return BUS;
+    }
+    return 0;
+}
+
+int chargerTarifs(const char *nomFichier)
+{
+    FILE *fichier;
+    GrilleTarifaire nouvelle;
+    char ligne[200];
+    char directive[20];
+    char nomType[20];
+    float tarifHoraire;
+    float plafond;
+    float coefficient;
+    int franchise;
+    int debut;
+    int fin;
+    int heures;
+    int type;
+    int valide;
+
+    if (nomFichier == NULL) {
+        return 0;
+    }
+
+    fichier = fopen(nomFichier, "r");
+    if (fichier == NULL) {
+        return 0;
+    }
+
+    /* Les directives modifient une copie des tarifs par defaut */
+    memset(&nouvelle, 0, sizeof(nouvelle));
+    remplirTarifsParDefaut(&nouvelle);
+    valide = 1;
+
+    while (valide && fgets(ligne, sizeof(ligne), fichier) != NULL) {
+        if (sscanf(ligne, "%19s", directive) != 1 || directive[0] == '#') {
+            continue;
+        }
+
+        if (strcmp(directive, "tarif") == 0) {
+            valide = sscanf(ligne, "%*s %19s %f %f %d", nomType, &tarifHoraire,
+                            &plafond, &franchise) == 4;
+            type = valide ? typeDepuisNom(nomType) : 0;
+            valide = type != 0 && tarifHoraire >= 0 && franchise >= 0;
+
+            if (valide) {
+                nouvelle.types[type].tarifHoraire = tarifHoraire;
+                nouvelle.types[type].plafondJournalier = plafond;
+                nouvelle.types[type].franchiseMinutes = franchise;
+            }
+        } else if (strcmp(directive, "bande") == 0) {
+            valide = sscanf(ligne, "%*s %d %d %f", &debut, &fin,
+                            &coefficient) == 3 &&
+                     debut >= 0 && debut < HEURES_PAR_JOUR &&
+                     fin >= 0 && fin <= HEURES_PAR_JOUR && coefficient >= 0;
+
+            /* Une bande peut passer minuit (ex. 22 -> 6) ; une bande de
+             * debut egal a sa fin (ex. 0 -> 24) couvre toute la journee */
+            heures = (fin - debut + HEURES_PAR_JOUR) % HEURES_PAR_JOUR;
+            if (heures == 0) {
+                heures = HEURES_PAR_JOUR;
+            }
+            while (valide && heures > 0) {
+                nouvelle.coefficients[debut] = coefficient;
+                debut = (debut + 1) % HEURES_PAR_JOUR;
+                heures--;
+            }
+        } else {
+            valide = 0;
+        }
+    }
+
+    fclose(fichier);
+
+    if (valide == 0) {
+        return 0;
+    }
+
+    compilerGrille(&nouvelle);
+    grille = nouvelle;
+
+    return 1;
+}
+
+/* ============================================================================
+ * CALCUL DES MONTANTS
+ * ============================================================================ */
+
+/**
+ * @brief Nombre d'heures facturees pour une duree
+ * @param dureeMinutes Duree de stationnement
+ * @param type Ligne de la grille
+ * @return Heures facturees, 0 si la duree tient dans la franchise
+ */
+static int heuresFacturees(int dureeMinutes, int type)
+{
+    int heures;
+
+    if (grille.types[type].franchiseMinutes > 0 &&
+        dureeMinutes <= grille.types[type].franchiseMinutes) {
+        return 0;
+    }
+
+    /* Arrondi a l'heure superieure, minimum une heure */
+    heures = (dureeMinutes + 59) / 60;
+    if (heures < 1) {
+        heures = 1;
+    }
+
+    return heures;
+}
+
+/**
+ * @brief Ligne de la grille d'un type de vehicule
+ * @param type Type de vehicule
+ * @return Indice de ligne (0 pour un type inconnu)
+ */
+static int ligneGrille(TypeVehicule type)
+{
+    if (grille.compilee == 0) {
+        appliquerTarifsParDefaut();
+    }
+
+    if (type >= VOITURE && type <= BUS) {
+        return type;
+    }
+    return 0;
+}
+
+float calculerMontant(int dureeMinutes, TypeVehicule type)
+{
+    int t;
+    int heures;
+    float montant;
+
+    TRACER_DEBUT(TRACE_TARIFICATION);
+
+    t = ligneGrille(type);
+    heures = heuresFacturees(dureeMinutes, t);
+    montant = (heures / HEURES_PAR_JOUR) * grille.prixJourUniforme[t] +
+              grille.cumulUniforme[t][heures % HEURES_PAR_JOUR];
+
+    TRACER_FIN(TRACE_TARIFICATION);
+
+    return montant;
+}
+
+float calculerMontantSejour(Horodatage entree, int dureeMinutes,
+                            TypeVehicule type)
+{
+    int t;
+    int heures;
+    int heureEntree;
+    float montant;
+
+    TRACER_DEBUT(TRACE_TARIFICATION);
+
+    t = ligneGrille(type);
+    heures = heuresFacturees(dureeMinutes, t);
+
+    /* Heure locale du jour de l'entree (minutes positives ou negatives) */
+    heureEntree = (int)((minutesLocales(entree) / 60) % HEURES_PAR_JOUR);
+    if (heureEntree < 0) {
+        heureEntree += HEURES_PAR_JOUR;
+    }
+
+    montant = (heures / HEURES_PAR_JOUR) * grille.prixJour[t] +
+              grille.cumul[t][heureEntree][heures % HEURES_PAR_JOUR];
+
+    TRACER_FIN(TRACE_TARIFICATION);
+
+    return montant;
+}
+
+float calculerMontantsLot(const Sejour sejours[], float montants[], int nombre)
+{
+    int i;
+    float total;
+
+    if (sejours == NULL || montants == NULL) {
+        return 0.0f;
+    }
+
+    total = 0.0f;
+
+    for (i = 0; i < nombre; i++) {
+        montants[i] = calculerMontantSejour(sejours[i].entree,
+                                            sejours[i].dureeMinutes,
+                                            sejours[i].type);
+        total += montants[i];
+    }
+
+    return total;
+}
@@ -0,0 +1,307 @@
+/**
+ * @file trace.c
+ * @brief Implementation de la trace des operations au format Chrome
+ * @date Decembre 2025
+ *
+ * Chaque thread recoit a son premier evenement un anneau, chaine dans la
+ * liste de tous les anneaux. Le thread range l'instant et le code de
+ * l'evenement puis publie le nouveau nombre d'evenements (rangement avec
+ * semantique de liberation). La lecture copie la fenetre publiee, relit
+ * ce nombre et ecarte les evenements que le thread a pu ecraser entre
+ * temps : aucun verrou sur le chemin des operations.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "../include/trace.h"
+#include "../include/utilitaires.h"
+
+/** Evenements par anneau (puissance de deux) */
+#define CAPACITE_ANNEAU 65536
+
+/** Longueur maximale d'un nom de thread */
+#define TAILLE_NOM_THREAD 32
+
+/**
+ * @struct AnneauTrace
+ * @brief Derniers evenements d'un thread
+ */
+typedef struct AnneauTrace {
+    long long instants[CAPACITE_ANNEAU];    /* ns depuis l'activation */
+    unsigned char codes[CAPACITE_ANNEAU];   /* evenement * 2 + fin */
+    unsigned long long ecrits;              /* Evenements publies */
+    int numero;                             /* tid dans la trace */
+    char nom[TAILLE_NOM_THREAD];            /* Sous verrouAnneaux */
+    struct AnneauTrace *suivant;
+} AnneauTrace;
+
+int traceActive = 0;
+
+/** Anneaux de tous les threads (ajouts et lectures sous verrouAnneaux) */
+static AnneauTrace *premierAnneau = NULL;
+static int nombreAnneaux = 0;
+static pthread_mutex_t verrouAnneaux = PTHREAD_MUTEX_INITIALIZER;
+
+/** Anneau du thread courant */
+#if defined(__GNUC__)
+static __thread AnneauTrace *anneauThread = NULL;
+#else
+static AnneauTrace *anneauThread = NULL;
+#endif
+
+/** Instant d'activation (origine des instants) et fichier de la trace */
+static double origineTrace = 0.0;
+static char fichierTrace[MAX_CHEMIN] = "";
+
+/** Noms des operations dans la trace, dans l'ordre de EvenementTrace */
+static const char *nomsEvenements[NOMBRE_EVENEMENTS_TRACE] = {
+    "entree",
+    "sortie",
+    "recherche place",
+    "tarification",
+    "journal",
+    "sauvegarde",
+    "rendu",
+    "fusion des voies"
+};
+
+/** Categories Chrome (filtre de l'interface), meme ordre */
+static const char *categoriesEvenements[NOMBRE_EVENEMENTS_TRACE] = {
+    "operation",
+    "operation",
+    "operation",
+    "tarif",
+    "disque",
+    "disque",
+    "affichage",
+    "operation"
+};
+
+/* ============================================================================
+ * ENREGISTREMENT
+ * ============================================================================ */
+
+/**
+ * @brief Anneau du thread courant, cree a son premier evenement
+ * @return Anneau, NULL si memoire insuffisante
+ */
+static AnneauTrace* obtenirAnneauThread(void)
+{
+    AnneauTrace *anneau;
+
+    if (anneauThread != NULL) {
+        return anneauThread;
+    }
+
+    anneau = (AnneauTrace*)calloc(1, sizeof(AnneauTrace));
+    if (anneau == NULL) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&verrouAnneaux);
+    anneau->numero = ++nombreAnneaux;
+    sprintf(anneau->nom, "thread %d", anneau->numero);
+    anneau->suivant = premierAnneau;
+    premierAnneau = anneau;
+    pthread_mutex_unlock(&verrouAnneaux);
+
+    anneauThread = anneau;
+
+    return anneau;
+}
+
+void activerTrace(const char *nomFichier)
+{
+    if (nomFichier == NULL || nomFichier[0] == '\0' ||
+        strlen(nomFichier) >= MAX_CHEMIN) {
+        traceActive = 0;
+        fichierTrace[0] = '\0';
+        return;
+    }
+
+    strcpy(fichierTrace, nomFichier);
+    origineTrace = instantMonotone();
+    traceActive = 1;
+    nommerThreadTrace("principal");
+}
+
+void tracerEvenement(EvenementTrace evenement, char phase)
+{
+    AnneauTrace *anneau;
+    unsigned long long position;
+    unsigned int indice;
+
+    anneau = obtenirAnneauThread();
+    if (anneau == NULL) {
+        return;
+    }
+
+    /* Seul ce thread ecrit l'anneau : pas d'instruction verrouillee */
+    position = __atomic_load_n(&anneau->ecrits, __ATOMIC_RELAXED);
+    indice = (unsigned int)(position & (CAPACITE_ANNEAU - 1));
+
+    __atomic_store_n(&anneau->instants[indice],
+                     (long long)((instantMonotone() - origineTrace) * 1e9),
+                     __ATOMIC_RELAXED);
+    __atomic_store_n(&anneau->codes[indice],
+                     (unsigned char)(evenement * 2 + (phase == 'E')),
+                     __ATOMIC_RELAXED);
+    __atomic_store_n(&anneau->ecrits, position + 1, __ATOMIC_RELEASE);
+}
+
+void nommerThreadTrace(const char *nom)
+{
+    AnneauTrace *anneau;
+
+    if (traceActive == 0 || nom == NULL) {
+        return;
+    }
+
+    anneau = obtenirAnneauThread();
+    if (anneau == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&verrouAnneaux);
+    strncpy(anneau->nom, nom, TAILLE_NOM_THREAD - 1);
+    anneau->nom[TAILLE_NOM_THREAD - 1] = '\0';
+    pthread_mutex_unlock(&verrouAnneaux);
+}
+
+/* ============================================================================
+ * ECRITURE
+ * ============================================================================ */
+
+/**
+ * @brief Ecrit les evenements d'un anneau
+ * @param flux Flux de destination
+ * @param anneau Anneau lu (sous verrouAnneaux)
+ * @param instants Copie des instants (CAPACITE_ANNEAU cases)
+ * @param codes Copie des codes (CAPACITE_ANNEAU cases)
+ */
+static void ecrireAnneau(FILE *flux, AnneauTrace *anneau,
+                         long long instants[], unsigned char codes[])
+{
+    unsigned long long debut;
+    unsigned long long fin;
+    unsigned long long relu;
+    unsigned long long i;
+    unsigned int indice;
+    int evenement;
+    int profondeur;
+
+    fin = __atomic_load_n(&anneau->ecrits, __ATOMIC_ACQUIRE);
+    debut = fin > CAPACITE_ANNEAU ? fin - CAPACITE_ANNEAU : 0;
+
+    for (i = debut; i < fin; i++) {
+        indice = (unsigned int)(i & (CAPACITE_ANNEAU - 1));
+        instants[indice] = __atomic_load_n(&anneau->instants[indice],
+                                           __ATOMIC_RELAXED);
+        codes[indice] = __atomic_load_n(&anneau->codes[indice],
+                                        __ATOMIC_RELAXED);
+    }
+
+    /* Evenement en cours d'ecriture : il ecrase le plus ancien copie */
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    relu = __atomic_load_n(&anneau->ecrits, __ATOMIC_RELAXED);
+    if (relu + 1 > CAPACITE_ANNEAU && relu + 1 - CAPACITE_ANNEAU > debut) {
+        debut = relu + 1 - CAPACITE_ANNEAU;
+    }
+
+    fprintf(flux, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+            "\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+            anneau->numero, anneau->nom);
+
+    /* Fins dont le debut a ete ecrase : ecartees */
+    profondeur = 0;
+    for (i = debut; i < fin; i++) {
+        indice = (unsigned int)(i & (CAPACITE_ANNEAU - 1));
+        evenement = codes[indice] / 2;
+        if (evenement >= NOMBRE_EVENEMENTS_TRACE) {
+            continue;
+        }
+
+        if (codes[indice] % 2 == 0) {
+            profondeur++;
+        } else if (profondeur == 0) {
+            continue;
+        } else {
+            profondeur--;
+        }
+
+        fprintf(flux, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\","
+                "\"ts\":%.3f,\"pid\":1,\"tid\":%d}",
+                nomsEvenements[evenement], categoriesEvenements[evenement],
+                codes[indice] % 2 == 0 ? 'B' : 'E',
+                instants[indice] / 1000.0, anneau->numero);
+    }
+}
+
+int ecrireTrace(const char *nomFichier)
+{
+    char nomTemporaire[MAX_CHEMIN + 8];
+    long long *instants;
+    unsigned char *codes;
+    AnneauTrace *anneau;
+    FILE *flux;
+    int resultat;
+
+    if (nomFichier == NULL || strlen(nomFichier) >= MAX_CHEMIN) {
+        return ERREUR_PARAMETRE;
+    }
+
+    instants = (long long*)malloc(CAPACITE_ANNEAU * sizeof(long long));
+    codes = (unsigned char*)malloc(CAPACITE_ANNEAU);
+    if (instants == NULL || codes == NULL) {
+        free(instants);
+        free(codes);
+        return ERREUR_MEMOIRE;
+    }
+
+    /* Ecriture a cote puis renommage, comme les metriques */
+    sprintf(nomTemporaire, "%s.tmp", nomFichier);
+    flux = fopen(nomTemporaire, "w");
+    if (flux == NULL) {
+        free(instants);
+        free(codes);
+        return ERREUR_ENTREE_SORTIE;
+    }
+
+    fprintf(flux, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+            "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+            "\"args\":{\"name\":\"parking\"}}");
+
+    pthread_mutex_lock(&verrouAnneaux);
+    for (anneau = premierAnneau; anneau != NULL; anneau = anneau->suivant) {
+        ecrireAnneau(flux, anneau, instants, codes);
+    }
+    pthread_mutex_unlock(&verrouAnneaux);
+
+    fprintf(flux, "\n]}\n");
+
+    free(instants);
+    free(codes);
+
+    resultat = ferror(flux) ? ERREUR_ENTREE_SORTIE : SUCCES;
+    if (fclose(flux) != 0) {
+        resultat = ERREUR_ENTREE_SORTIE;
+    }
+
+    if (resultat != SUCCES || rename(nomTemporaire, nomFichier) != 0) {
+        remove(nomTemporaire);
+        return ERREUR_ENTREE_SORTIE;
+    }
+
+    return SUCCES;
+}
+
+int exporterTrace(void)
+{
+    if (traceActive == 0 || fichierTrace[0] == '\0') {
+        return SUCCES;
+    }
+
+    return ecrireTrace(fichierTrace);
+}
@@ -9,10 +9,29 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "../include/tri_recherche.h"
+#include "../include/parking.h"
 #include "../include/prototypes.h"
 
+/** Longueur des series triees par insertion avant les fusions */
+#define SERIE_INSERTION 32
+
+/**
+ * @struct PaireTri
+ * @brief Cle de tri d'un enregistrement et sa position
+ *
+ * La cle tient dans deux mots compares comme des entiers non signes : les
+ * caracteres d'une plaque (premier octet en poids fort), ou une valeur
+ * numerique rendue croissante dans le premier mot.
+ */
+typedef struct {
+    uint64_t cle;
+    uint64_t cleSuite;
+    int indice;
+} PaireTri;
+
 /* ============================================================================
  * FONCTIONS AUXILIAIRES
  * ============================================================================ */
@@ -24,28 +43,8 @@ int comparerPlaques(const char *plaque1, const char *plaque2)
 
 int comparerHorodatages(Horodatage h1, Horodatage h2)
 {
-    /* Comparaison annee */
-    if (h1.annee != h2.annee) {
-        return h1.annee - h2.annee;
-    }
-    
-    /* Comparaison mois */
-    if (h1.mois != h2.mois) {
-        return h1.mois - h2.mois;
-    }
-    
-    /* Comparaison jour */
-    if (h1.jour != h2.jour) {
-        return h1.jour - h2.jour;
-    }
-    
-    /* Comparaison heure */
-    if (h1.heure != h2.heure) {
-        return h1.heure - h2.heure;
-    }
-    
-    /* Comparaison minute */
-    return h1.minute - h2.minute;
+    /* Une seule comparaison d'entiers, sans risque de debordement */
+    return (h1.minutes > h2.minutes) - (h1.minutes < h2.minutes);
 }
 
 void echangerVehicules(Vehicule *v1, Vehicule *v2)
@@ -197,3 +196,238 @@ void triVehiculesParMontant(Vehicule vehicules[], int taille)
         vehicules[j + 1] = vehiculeACaser;
     }
 }
+
+/* ============================================================================
+ * TRI INDIRECT
+ * ============================================================================ */
+
+/**
+ * @brief Calcule la cle de tri d'un vehicule
+ * @param vehicule Vehicule
+ * @param critere Ordre voulu
+ * @param indice Position du vehicule
+ * @param paire Recoit la cle et la position
+ */
+static void construirePaire(const Vehicule *vehicule, CritereTri critere,
+                            int indice, PaireTri *paire)
+{
+    uint32_t bits;
+    int i;
+
+    paire->cle = 0;
+    paire->cleSuite = 0;
+    paire->indice = indice;
+
+    switch (critere) {
+        case TRI_PAR_PLAQUE:
+            /* Octets completes par des zeros : meme ordre que strcmp */
+            for (i = 0; i < TAILLE_PLAQUE - 1 && vehicule->plaque[i] != '\0';
+                 i++) {
+                if (i < 8) {
+                    paire->cle |= (uint64_t)(unsigned char)vehicule->plaque[i]
+                                  << (56 - 8 * i);
+                } else {
+                    paire->cleSuite |=
+                        (uint64_t)(unsigned char)vehicule->plaque[i]
+                        << (56 - 8 * (i - 8));
+                }
+            }
+            break;
+        case TRI_PAR_ENTREE:
+            /* Bit de signe inverse : minutes negatives en tete */
+            paire->cle = (uint32_t)vehicule->entree.minutes ^ 0x80000000u;
+            break;
+        case TRI_PAR_MONTANT:
+            /* Bits du flottant rendus croissants comme un entier, puis
+             * inverses pour l'ordre decroissant */
+            memcpy(&bits, &vehicule->montantPaye, sizeof(bits));
+            bits = (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+            paire->cle = (uint32_t)~bits;
+            break;
+    }
+}
+
+/**
+ * @brief Ordre strict de deux paires
+ * @param a Premiere paire
+ * @param b Deuxieme paire
+ * @return 1 si a passe avant b
+ */
+static int pairePrecede(const PaireTri *a, const PaireTri *b)
+{
+    return a->cle < b->cle || (a->cle == b->cle && a->cleSuite < b->cleSuite);
+}
+
+/**
+ * @brief Fusionne deux series triees consecutives
+ * @param source Tableau contenant [debut, milieu) et [milieu, fin)
+ * @param destination Recoit [debut, fin) trie
+ * @param debut Debut de la premiere serie
+ * @param milieu Debut de la seconde serie
+ * @param fin Fin de la seconde serie
+ *
+ * A cle egale, la premiere serie passe avant : la fusion est stable.
+ */
+static void fusionnerSeries(const PaireTri source[], PaireTri destination[],
+                            long debut, long milieu, long fin)
+{
+    long i;
+    long j;
+    long k;
+
+    /* Seconde serie deja apres la premiere (presque trie) : copie */
+    if (milieu == fin || !pairePrecede(&source[milieu], &source[milieu - 1])) {
+        memcpy(destination + debut, source + debut,
+               (size_t)(fin - debut) * sizeof(PaireTri));
+        return;
+    }
+
+    i = debut;
+    j = milieu;
+    for (k = debut; k < fin; k++) {
+        if (j < fin && (i == milieu || pairePrecede(&source[j], &source[i]))) {
+            destination[k] = source[j++];
+        } else {
+            destination[k] = source[i++];
+        }
+    }
+}
+
+/**
+ * @brief Trie des paires et en extrait la permutation
+ * @param paires Paires a trier (modifiees)
+ * @param taille Nombre de paires
+ * @param permutation Recoit les indices dans l'ordre
+ * @return SUCCES ou ERREUR_MEMOIRE
+ *
+ * Tri fusion ascendant : series de SERIE_INSERTION paires triees par
+ * insertion, puis fusions de largeur doublee entre deux tableaux.
+ */
+static int ordonnerPaires(PaireTri paires[], int taille, int permutation[])
+{
+    PaireTri *travail;
+    PaireTri *source;
+    PaireTri *destination;
+    PaireTri *echange;
+    PaireTri paire;
+    long largeur;
+    long debut;
+    long milieu;
+    long fin;
+    long i;
+    long j;
+
+    /* Deja dans l'ordre (historique par date d'entree) : un seul parcours */
+    i = 1;
+    while (i < taille && !pairePrecede(&paires[i], &paires[i - 1])) {
+        i++;
+    }
+    if (i >= taille) {
+        for (i = 0; i < taille; i++) {
+            permutation[i] = paires[i].indice;
+        }
+        return SUCCES;
+    }
+
+    travail = (PaireTri*)malloc((taille > 0 ? taille : 1) * sizeof(PaireTri));
+    if (travail == NULL) {
+        return ERREUR_MEMOIRE;
+    }
+
+    for (debut = 0; debut < taille; debut += SERIE_INSERTION) {
+        fin = debut + SERIE_INSERTION < taille ? debut + SERIE_INSERTION :
+                                                 taille;
+        for (i = debut + 1; i < fin; i++) {
+            paire = paires[i];
+            for (j = i - 1; j >= debut && pairePrecede(&paire, &paires[j]);
+                 j--) {
+                paires[j + 1] = paires[j];
+            }
+            paires[j + 1] = paire;
+        }
+    }
+
+    source = paires;
+    destination = travail;
+    for (largeur = SERIE_INSERTION; largeur < taille; largeur *= 2) {
+        for (debut = 0; debut < taille; debut += 2 * largeur) {
+            milieu = debut + largeur < taille ? debut + largeur : taille;
+            fin = debut + 2 * largeur < taille ? debut + 2 * largeur : taille;
+            fusionnerSeries(source, destination, debut, milieu, fin);
+        }
+        echange = source;
+        source = destination;
+        destination = echange;
+    }
+
+    for (i = 0; i < taille; i++) {
+        permutation[i] = source[i].indice;
+    }
+
+    free(travail);
+
+    return SUCCES;
+}
+
+int trierIndicesVehicules(const Vehicule vehicules[], int taille,
+                          CritereTri critere, int permutation[])
+{
+    PaireTri *paires;
+    int resultat;
+    int i;
+
+    if (vehicules == NULL || permutation == NULL || taille < 0 ||
+        critere < TRI_PAR_PLAQUE || critere > TRI_PAR_MONTANT) {
+        return ERREUR_PARAMETRE;
+    }
+
+    paires = (PaireTri*)malloc((taille > 0 ? taille : 1) * sizeof(PaireTri));
+    if (paires == NULL) {
+        return ERREUR_MEMOIRE;
+    }
+
+    for (i = 0; i < taille; i++) {
+        construirePaire(&vehicules[i], critere, i, &paires[i]);
+    }
+
+    resultat = ordonnerPaires(paires, taille, permutation);
+    free(paires);
+
+    return resultat;
+}
+
+int trierIndicesHistorique(const Parking *parking, CritereTri critere,
+                           int permutation[])
+{
+    const Vehicule *vehicule;
+    PaireTri *paires;
+    int resultat;
+    int taille;
+    int i;
+
+    if (parking == NULL || permutation == NULL ||
+        critere < TRI_PAR_PLAQUE || critere > TRI_PAR_MONTANT) {
+        return ERREUR_PARAMETRE;
+    }
+
+    taille = parking->nombreVehicules;
+    paires = (PaireTri*)malloc((taille > 0 ? taille : 1) * sizeof(PaireTri));
+    if (paires == NULL) {
+        return ERREUR_MEMOIRE;
+    }
+
+    /* Lecture dans l'ordre : un segment archive n'est lu qu'une fois */
+    for (i = 0; i < taille; i++) {
+        vehicule = lireVehicule(parking, i);
+        if (vehicule == NULL) {
+            free(paires);
+            return ERREUR_ENTREE_SORTIE;
+        }
+        construirePaire(vehicule, critere, i, &paires[i]);
+    }
+
+    resultat = ordonnerPaires(paires, taille, permutation);
+    free(paires);
+
+    return resultat;
+}
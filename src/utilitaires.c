@@ -9,6 +9,8 @@
 #include <string.h>
 #include <time.h>
 #include "../include/utilitaires.h"
+#include "../include/rendu.h"
+#include "../include/prototypes.h"
 
 /* ============================================================================
  * FONCTIONS D'AFFICHAGE
@@ -16,47 +18,59 @@
 
 void effacerEcran(void)
 {
-    /* Commande specifique au systeme d'exploitation */
-    #ifdef _WIN32
-        system("cls");
-    #else
-        system("clear");
-    #endif
+    /* Sequence ANSI plutot qu'un processus "clear" a chaque ecran */
+    commencerRendu();
+    rendreEffacement();
+    terminerRendu();
 }
 
 void afficherLigne(char caractere, int longueur)
+{
+    rendreLigne(caractere, longueur);
+}
+
+/**
+ * @brief Ajoute une bordure de cadre (+---+) a l'ecran en cours
+ * @param longueur Largeur totale du cadre
+ */
+static void rendreBordureCadre(int longueur)
 {
     int i;
     
-    for (i = 0; i < longueur; i++) {
-        printf("%c", caractere);
+    rendreTexte("+");
+    for (i = 0; i < longueur - 2; i++) {
+        rendreTexte("-");
     }
-    printf("\n");
+    rendreTexte("+\n");
 }
 
 void afficherCadre(const char *message)
 {
     int longueur;
-    int i;
     
     longueur = strlen(message) + 4;
     
-    /* Ligne superieure */
-    printf("+");
-    for (i = 0; i < longueur - 2; i++) {
-        printf("-");
-    }
-    printf("+\n");
+    commencerRendu();
     
-    /* Message */
-    printf("| %s |\n", message);
+    /* Ligne superieure, message puis ligne inferieure */
+    rendreBordureCadre(longueur);
+    rendreTexte("| %s |\n", message);
+    rendreBordureCadre(longueur);
     
-    /* Ligne inferieure */
-    printf("+");
-    for (i = 0; i < longueur - 2; i++) {
-        printf("-");
-    }
-    printf("+\n");
+    terminerRendu();
+}
+
+/**
+ * @brief Affiche un horodatage sur la sortie standard
+ * @param h Horodatage a afficher
+ */
+void afficherHorodatage(Horodatage h)
+{
+    DateHeure d;
+    
+    d = decomposerHorodatage(h);
+    printf("%02d/%02d/%04d a %02d:%02d",
+           d.jour, d.mois, d.annee, d.heure, d.minute);
 }
 
 void pause(void)
@@ -137,39 +151,3 @@ float lireFlottant(float min, float max)
         }
     } while (1);
 }
-
-/* ============================================================================
- * FONCTIONS DE CONVERSION
- * ============================================================================ */
-
-const char* typeVehiculeEnChaine(TypeVehicule type)
-{
-    switch (type) {
-        case VOITURE:
-            return "Voiture";
-        case MOTO:
-            return "Moto";
-        case CAMION:
-            return "Camion";
-        case BUS:
-            return "Bus";
-        default:
-            return "Inconnu";
-    }
-}
-
-const char* etatPlaceEnChaine(EtatPlace etat)
-{
-    switch (etat) {
-        case LIBRE:
-            return "Libre";
-        case OCCUPEE:
-            return "Occupee";
-        case RESERVEE:
-            return "Reservee";
-        case HORS_SERVICE:
-            return "Hors service";
-        default:
-            return "Inconnu";
-    }
-}
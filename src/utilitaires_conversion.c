@@ -0,0 +1,79 @@
+/**
+ * @file utilitaires_conversion.c
+ * @brief Implementation des fonctions de conversion en chaines
+ * @date Decembre 2025
+ *
+ * Fonctions sans entree ni sortie, utilisables par le coeur comme par
+ * l'interface.
+ */
+
+#include <stdio.h>
+#include "../include/utilitaires.h"
+
+/* ============================================================================
+ * FONCTIONS DE CONVERSION
+ * ============================================================================ */
+
+const char* typeVehiculeEnChaine(TypeVehicule type)
+{
+    switch (type) {
+        case VOITURE:
+            return "Voiture";
+        case MOTO:
+            return "Moto";
+        case CAMION:
+            return "Camion";
+        case BUS:
+            return "Bus";
+        default:
+            return "Inconnu";
+    }
+}
+
+const char* etatPlaceEnChaine(EtatPlace etat)
+{
+    switch (etat) {
+        case LIBRE:
+            return "Libre";
+        case OCCUPEE:
+            return "Occupee";
+        case RESERVEE:
+            return "Reservee";
+        case HORS_SERVICE:
+            return "Hors service";
+        default:
+            return "Inconnu";
+    }
+}
+
+const char* messageErreur(int code)
+{
+    switch (code) {
+        case SUCCES:
+            return "Operation reussie.";
+        case ERREUR_PARAMETRE:
+            return "Parametre invalide.";
+        case ERREUR_MEMOIRE:
+            return "Memoire insuffisante.";
+        case ERREUR_DEJA_PRESENT:
+            return "Ce vehicule est deja dans le parking.";
+        case ERREUR_AUCUNE_PLACE:
+            return "Aucune place disponible pour ce type de vehicule.";
+        case ERREUR_VEHICULE_ABSENT:
+            return "Vehicule non trouve dans le parking.";
+        case ERREUR_DEJA_SORTI:
+            return "Ce vehicule a deja quitte le parking.";
+        case ERREUR_PLACE_INVALIDE:
+            return "Numero de place invalide.";
+        case ERREUR_FICHIER_ABSENT:
+            return "Fichier introuvable.";
+        case ERREUR_FICHIER_INVALIDE:
+            return "Fichier invalide, corrompu ou d'une autre version.";
+        case ERREUR_ENTREE_SORTIE:
+            return "Erreur de lecture ou d'ecriture sur disque.";
+        case ERREUR_PLACE_OCCUPEE:
+            return "Place occupee par un vehicule.";
+        default:
+            return "Erreur inconnue.";
+    }
+}
@@ -4,73 +4,284 @@
  * @date Decembre 2025
  */
 
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200112L
+#endif
+
 #include <stdio.h>
 #include <time.h>
 #include "../include/utilitaires.h"
+#include "../include/prototypes.h"
+
+/* ============================================================================
+ * ETAT DE L'HORLOGE
+ * ============================================================================ */
+
+/** Source utilisee par obtenirHorodatageActuel */
+static SourceHorloge sourceCourante = HORLOGE_REELLE;
+
+/** Horloge reelle : derniere minute decomposee et debut de la suivante */
+static Horodatage cacheReel;
+static time_t debutMinuteSuivante = 0;
+
+/** Horloge monotone : heure de reference et instant monotone associe */
+static Horodatage origineMonotone;
+static double secondesOrigine;
+static double instantOrigine;
+
+/** Horloge simulee : heure courante fixee par le programme */
+static Horodatage heureSimulee;
+
+/** Dernier jour (UTC) sans changement d'heure et son decalage local :
+ *  jour << 16 | (decalage + 32768), lu et ecrit d'un seul bloc */
+static unsigned long long decalageJour = 0;
 
 /* ============================================================================
  * FONCTIONS DE GESTION DU TEMPS
  * ============================================================================ */
 
-Horodatage obtenirHorodatageActuel(void)
+/**
+ * @brief Nombre de jours du 01/01/1970 a une date du calendrier gregorien
+ * @param jour Jour du mois
+ * @param mois Mois de l'annee (1-12)
+ * @param annee Annee
+ * @return Nombre de jours (negatif avant 1970)
+ */
+static long joursDepuisEpoque(int jour, int mois, int annee)
+{
+    long ere;
+    long anneeDansEre;
+    long jourDansAnnee;
+    long jourDansEre;
+    
+    /* L'annee commence en mars : le 29 fevrier tombe en fin d'annee */
+    annee -= mois <= 2;
+    ere = (annee >= 0 ? annee : annee - 399) / 400;
+    anneeDansEre = annee - ere * 400;
+    jourDansAnnee = (153 * (mois + (mois > 2 ? -3 : 9)) + 2) / 5 + jour - 1;
+    jourDansEre = anneeDansEre * 365 + anneeDansEre / 4 - anneeDansEre / 100 +
+                  jourDansAnnee;
+    
+    return ere * 146097 + jourDansEre - 719468;
+}
+
+/**
+ * @brief Decalage de l'heure locale sur UTC a un instant donne
+ * @param minutes Minutes UTC depuis le 01/01/1970 00:00
+ * @return Decalage en minutes (heure locale - UTC)
+ */
+static int32_t lireDecalageLocal(int32_t minutes)
+{
+    time_t t;
+    struct tm infoTemps;
+    
+    t = (time_t)minutes * 60;
+#ifdef _WIN32
+    infoTemps = *localtime(&t);
+#else
+    localtime_r(&t, &infoTemps);
+#endif
+    
+    return (int32_t)(joursDepuisEpoque(infoTemps.tm_mday,
+                                       infoTemps.tm_mon + 1,
+                                       infoTemps.tm_year + 1900) * 1440 +
+                     infoTemps.tm_hour * 60 + infoTemps.tm_min) - minutes;
+}
+
+/**
+ * @brief Decalage de l'heure locale sur UTC, garde par jour
+ * @param minutes Minutes UTC depuis le 01/01/1970 00:00
+ * @return Decalage en minutes (heure locale - UTC)
+ *
+ * Un jour dont le debut et la fin ont le meme decalage n'a pas de
+ * changement d'heure : son decalage est garde et sert sans appel a
+ * localtime. Le jour d'un changement est recalcule a chaque appel.
+ */
+static int32_t decalageLocal(int32_t minutes)
 {
+    unsigned long long garde;
+    long jour;
+    int32_t debut;
+    int32_t decalage;
+    
+    jour = minutes >= 0 ? minutes / 1440 : (minutes - 1439) / 1440;
+    garde = __atomic_load_n(&decalageJour, __ATOMIC_RELAXED);
+    if (garde != 0 && (long)(garde >> 16) - 32768 == jour) {
+        return (int32_t)(garde & 0xFFFF) - 32768;
+    }
+    
+    debut = (int32_t)(jour * 1440);
+    decalage = lireDecalageLocal(debut);
+    if (lireDecalageLocal(debut + 1439) != decalage) {
+        return lireDecalageLocal(minutes);
+    }
+    
+    garde = (unsigned long long)(jour + 32768) << 16 |
+            (unsigned long long)(decalage + 32768);
+    __atomic_store_n(&decalageJour, garde, __ATOMIC_RELAXED);
+    
+    return decalage;
+}
+
+/**
+ * @brief Lit l'heure systeme et la convertit en horodatage
+ * @param secondes Recoit les secondes de la minute courante (peut etre NULL)
+ * @param tempsActuel Recoit le temps systeme lu (peut etre NULL)
+ * @return Horodatage courant
+ */
+static Horodatage lireHeureSysteme(int *secondes, time_t *tempsActuel)
+{
+    time_t t;
     Horodatage h;
-    time_t tempsActuel;
-    struct tm *infoTemps;
     
-    /* Obtenir le temps systeme */
-    time(&tempsActuel);
-    infoTemps = localtime(&tempsActuel);
+    /* Obtenir le temps systeme, en secondes UTC depuis 1970 */
+    time(&t);
+    h.minutes = (int32_t)(t / 60);
     
-    /* Remplir la structure Horodatage */
-    h.jour = infoTemps->tm_mday;
-    h.mois = infoTemps->tm_mon + 1;      /* tm_mon commence a 0 */
-    h.annee = infoTemps->tm_year + 1900; /* tm_year depuis 1900 */
-    h.heure = infoTemps->tm_hour;
-    h.minute = infoTemps->tm_min;
+    if (secondes != NULL) {
+        *secondes = (int)(t % 60);
+    }
+    if (tempsActuel != NULL) {
+        *tempsActuel = t;
+    }
     
     return h;
 }
 
-int calculerDureeMinutes(Horodatage debut, Horodatage fin)
+double instantMonotone(void)
 {
-    struct tm tempsDebut;
-    struct tm tempsFin;
-    time_t t1;
-    time_t t2;
-    double difference;
+#ifdef _WIN32
+    return (double)time(NULL);
+#else
+    struct timespec ts;
     
-    /* Initialiser les structures tm */
-    tempsDebut.tm_year = debut.annee - 1900;
-    tempsDebut.tm_mon = debut.mois - 1;
-    tempsDebut.tm_mday = debut.jour;
-    tempsDebut.tm_hour = debut.heure;
-    tempsDebut.tm_min = debut.minute;
-    tempsDebut.tm_sec = 0;
-    tempsDebut.tm_isdst = -1;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ts.tv_nsec / 1e9;
+#endif
+}
+
+void choisirSourceHorloge(SourceHorloge source)
+{
+    int secondes;
     
-    tempsFin.tm_year = fin.annee - 1900;
-    tempsFin.tm_mon = fin.mois - 1;
-    tempsFin.tm_mday = fin.jour;
-    tempsFin.tm_hour = fin.heure;
-    tempsFin.tm_min = fin.minute;
-    tempsFin.tm_sec = 0;
-    tempsFin.tm_isdst = -1;
+    switch (source) {
+        case HORLOGE_MONOTONE:
+            /* Reference : heure murale au moment du choix */
+            origineMonotone = lireHeureSysteme(&secondes, NULL);
+            secondesOrigine = secondes;
+            instantOrigine = instantMonotone();
+            break;
+        case HORLOGE_SIMULEE:
+            /* Demarre a l'heure courante tant qu'elle n'est pas reglee */
+            if (heureSimulee.minutes == 0) {
+                heureSimulee = lireHeureSysteme(NULL, NULL);
+            }
+            break;
+        default:
+            source = HORLOGE_REELLE;
+            debutMinuteSuivante = 0;
+    }
     
-    /* Convertir en time_t */
-    t1 = mktime(&tempsDebut);
-    t2 = mktime(&tempsFin);
+    sourceCourante = source;
+}
+
+SourceHorloge sourceHorlogeCourante(void)
+{
+    return sourceCourante;
+}
+
+void reglerHorlogeSimulee(Horodatage h)
+{
+    heureSimulee = h;
+}
+
+void avancerHorlogeSimulee(int minutes)
+{
+    heureSimulee.minutes += minutes;
+}
+
+Horodatage obtenirHorodatageActuel(void)
+{
+    time_t tempsActuel;
+    int secondes;
+    Horodatage h;
     
-    /* Calculer la difference en secondes puis convertir en minutes */
-    difference = difftime(t2, t1);
+    switch (sourceCourante) {
+        case HORLOGE_SIMULEE:
+            return heureSimulee;
+            
+        case HORLOGE_MONOTONE:
+            h = origineMonotone;
+            h.minutes += (int32_t)((secondesOrigine + instantMonotone() -
+                                    instantOrigine) / 60.0);
+            return h;
+            
+        default:
+            /* Relu qu'au changement de minute, ou quand l'horloge
+             * systeme a recule avant la minute gardee */
+            time(&tempsActuel);
+            if (tempsActuel >= debutMinuteSuivante ||
+                tempsActuel < debutMinuteSuivante - 60) {
+                cacheReel = lireHeureSysteme(&secondes, &tempsActuel);
+                debutMinuteSuivante = tempsActuel - secondes + 60;
+            }
+            return cacheReel;
+    }
+}
+
+int calculerDureeMinutes(Horodatage debut, Horodatage fin)
+{
+    return (int)(fin.minutes - debut.minutes);
+}
+
+int32_t minutesLocales(Horodatage h)
+{
+    return h.minutes + decalageLocal(h.minutes);
+}
+
+DateHeure decomposerHorodatage(Horodatage h)
+{
+    DateHeure d;
+    int32_t locales;
+    long jours;
+    long ere;
+    long jourDansEre;
+    long anneeDansEre;
+    long jourDansAnnee;
+    long moisDecale;
+    int minutesDuJour;
+    
+    /* Division arrondie vers le bas, valable avant 1970 */
+    locales = minutesLocales(h);
+    jours = locales >= 0 ? locales / 1440 : (locales - 1439) / 1440;
+    minutesDuJour = (int)(locales - jours * 1440);
+    d.heure = minutesDuJour / 60;
+    d.minute = minutesDuJour % 60;
+    
+    /* Conversion inverse de joursDepuisEpoque */
+    jours += 719468;
+    ere = (jours >= 0 ? jours : jours - 146096) / 146097;
+    jourDansEre = jours - ere * 146097;
+    anneeDansEre = (jourDansEre - jourDansEre / 1460 + jourDansEre / 36524 -
+                    jourDansEre / 146096) / 365;
+    jourDansAnnee = jourDansEre - (365 * anneeDansEre + anneeDansEre / 4 -
+                                   anneeDansEre / 100);
+    moisDecale = (5 * jourDansAnnee + 2) / 153;
     
-    return (int)(difference / 60.0);
+    d.jour = (int)(jourDansAnnee - (153 * moisDecale + 2) / 5 + 1);
+    d.mois = (int)(moisDecale < 10 ? moisDecale + 3 : moisDecale - 9);
+    d.annee = (int)(anneeDansEre + ere * 400 + (d.mois <= 2));
+    
+    return d;
 }
 
 void formaterHorodatage(Horodatage h, char *buffer)
 {
+    DateHeure d;
+    
+    d = decomposerHorodatage(h);
     sprintf(buffer, "%02d/%02d/%04d %02d:%02d",
-            h.jour, h.mois, h.annee, h.heure, h.minute);
+            d.jour, d.mois, d.annee, d.heure, d.minute);
 }
 
 /**
@@ -80,20 +291,12 @@ void formaterHorodatage(Horodatage h, char *buffer)
  */
 int horodatageValide(Horodatage h)
 {
-    /* Verification des bornes */
-    if (h.jour < 1 || h.jour > 31) {
-        return 0;
-    }
-    if (h.mois < 1 || h.mois > 12) {
-        return 0;
-    }
-    if (h.annee < 2000 || h.annee > 2100) {
-        return 0;
-    }
-    if (h.heure < 0 || h.heure > 23) {
-        return 0;
-    }
-    if (h.minute < 0 || h.minute > 59) {
+    DateHeure d;
+    
+    /* Les champs derives sont toujours coherents : seule l'annee
+     * peut sortir des bornes */
+    d = decomposerHorodatage(h);
+    if (d.annee < 2000 || d.annee > 2100) {
         return 0;
     }
     
@@ -101,7 +304,7 @@ int horodatageValide(Horodatage h)
 }
 
 /**
- * @brief Cree un horodatage a partir de valeurs
+ * @brief Cree un horodatage a partir de valeurs en heure locale
  * @param jour Jour du mois
  * @param mois Mois de l'annee
  * @param annee Annee
@@ -112,22 +315,16 @@ int horodatageValide(Horodatage h)
 Horodatage creerHorodatage(int jour, int mois, int annee, int heure, int minute)
 {
     Horodatage h;
+    int32_t locales;
+    int32_t decalage;
     
-    h.jour = jour;
-    h.mois = mois;
-    h.annee = annee;
-    h.heure = heure;
-    h.minute = minute;
+    /* Decalage pris a l'instant vise, comme mktime avec tm_isdst = -1 */
+    locales = (int32_t)(joursDepuisEpoque(jour, mois, annee) * 1440 +
+                        heure * 60 + minute);
+    decalage = decalageLocal(locales);
+    h.minutes = locales - decalage;
+    decalage = decalageLocal(h.minutes);
+    h.minutes = locales - decalage;
     
     return h;
 }
-
-/**
- * @brief Affiche un horodatage sur la sortie standard
- * @param h Horodatage a afficher
- */
-void afficherHorodatage(Horodatage h)
-{
-    printf("%02d/%02d/%04d a %02d:%02d",
-           h.jour, h.mois, h.annee, h.heure, h.minute);
-}
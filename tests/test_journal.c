@@ -0,0 +1,337 @@
+/**
+ * @file test_journal.c
+ * @brief Tests du rejeu du journal des operations au demarrage
+ * @date Decembre 2025
+ *
+ * Chaque cas ecrit un journal avec le moteur, l'altere comme le ferait un
+ * incident (arret pendant une ecriture, sauvegarde perdue, secteur
+ * corrompu) puis le rouvre sur un parking neuf. Seule une fin dechiree
+ * peut etre retiree du fichier ; un journal qui ne prolonge pas la
+ * sauvegarde est refuse et laisse intact.
+ *
+ * Usage : test_journal (fichiers de travail dans le repertoire courant)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/types.h"
+#include "../include/parking.h"
+#include "../include/persistance.h"
+#include "../include/journal.h"
+#include "../include/utilitaires.h"
+
+/** Fichiers de travail */
+#define FICHIER_JOURNAL_TEST "test_journal.dat"
+#define FICHIER_SAUVEGARDE_TEST "test_sauvegarde.dat"
+
+/** Places du parking de test */
+#define PLACES_TEST 20
+
+/** Nombre de verifications en echec */
+static int echecs = 0;
+
+/**
+ * @brief Note le resultat d'une verification
+ * @param condition Non nulle si la verification reussit
+ * @param description Verification effectuee
+ */
+static void verifier(int condition, const char *description)
+{
+    printf("%s : %s\n", condition ? "OK   " : "ECHEC", description);
+    if (condition == 0) {
+        echecs++;
+    }
+}
+
+/**
+ * @brief Lit un fichier entier
+ * @param nomFichier Fichier a lire
+ * @param taille Recoit la taille en octets
+ * @return Contenu (a liberer), NULL si illisible
+ */
+static unsigned char* lireFichier(const char *nomFichier, long *taille)
+{
+    FILE *flux;
+    unsigned char *contenu;
+
+    flux = fopen(nomFichier, "rb");
+    if (flux == NULL) {
+        return NULL;
+    }
+
+    fseek(flux, 0, SEEK_END);
+    *taille = ftell(flux);
+    fseek(flux, 0, SEEK_SET);
+
+    contenu = (unsigned char*)malloc((size_t)*taille + 1);
+    if (contenu != NULL &&
+        fread(contenu, 1, (size_t)*taille, flux) != (size_t)*taille) {
+        free(contenu);
+        contenu = NULL;
+    }
+
+    fclose(flux);
+
+    return contenu;
+}
+
+/**
+ * @brief Remplace un fichier par un contenu donne
+ * @param nomFichier Fichier a ecrire
+ * @param contenu Octets a ecrire
+ * @param taille Nombre d'octets
+ */
+static void ecrireFichier(const char *nomFichier,
+                          const unsigned char *contenu, long taille)
+{
+    FILE *flux;
+
+    flux = fopen(nomFichier, "wb");
+    if (flux != NULL) {
+        fwrite(contenu, 1, (size_t)taille, flux);
+        fclose(flux);
+    }
+}
+
+/**
+ * @brief Indique si un fichier a exactement le contenu donne
+ * @param nomFichier Fichier a comparer
+ * @param contenu Contenu attendu
+ * @param taille Taille attendue
+ * @return 1 si identique, 0 sinon
+ */
+static int fichierIdentique(const char *nomFichier,
+                            const unsigned char *contenu, long taille)
+{
+    unsigned char *actuel;
+    long tailleActuelle;
+    int identique;
+
+    actuel = lireFichier(nomFichier, &tailleActuelle);
+    identique = actuel != NULL && tailleActuelle == taille &&
+                memcmp(actuel, contenu, (size_t)taille) == 0;
+    free(actuel);
+
+    return identique;
+}
+
+/**
+ * @brief Ecrit un journal de quelques operations depuis un parking neuf
+ * @param entrees Nombre d'entrees journalisees
+ * @param sauvegardeApres Entrees apres lesquelles le parking est
+ *        sauvegarde et le journal compacte (0 : jamais)
+ * @return Taille d'un enregistrement, 0 en cas d'echec
+ */
+static long ecrireJournal(int entrees, int sauvegardeApres)
+{
+    Parking parking;
+    char plaque[TAILLE_PLAQUE];
+    unsigned char *contenu;
+    long taille;
+    int i;
+
+    remove(FICHIER_JOURNAL_TEST);
+    remove(FICHIER_SAUVEGARDE_TEST);
+
+    if (initialiserParking(&parking, "Test", PLACES_TEST) == 0) {
+        return 0;
+    }
+    if (ouvrirJournal(&parking, FICHIER_JOURNAL_TEST, 1, 0) != 0) {
+        libererParking(&parking);
+        return 0;
+    }
+
+    for (i = 1; i <= entrees; i++) {
+        sprintf(plaque, "TST%03d", i);
+        avancerHorlogeSimulee(10);
+        enregistrerEntree(&parking, plaque, "Test", VOITURE);
+
+        if (i == sauvegardeApres) {
+            sauvegarderDonnees(&parking, FICHIER_SAUVEGARDE_TEST);
+            compacterJournal(&parking, parking.sequenceJournal);
+        }
+    }
+
+    libererParking(&parking);
+
+    /* Le journal ne garde que les entrees posterieures a la sauvegarde */
+    contenu = lireFichier(FICHIER_JOURNAL_TEST, &taille);
+    if (contenu == NULL) {
+        return 0;
+    }
+    free(contenu);
+    entrees -= sauvegardeApres;
+
+    return entrees > 0 ? taille / entrees : 0;
+}
+
+/**
+ * @brief Rouvre le journal sur un parking neuf (apres la sauvegarde de
+ *        test si elle existe)
+ * @param presents Recoit le nombre de vehicules presents
+ * @return Resultat de ouvrirJournal
+ */
+static int rouvrirJournal(int *presents)
+{
+    Parking parking;
+    int resultat;
+
+    if (initialiserParking(&parking, "Test", PLACES_TEST) == 0) {
+        return ERREUR_MEMOIRE;
+    }
+
+    resultat = chargerDonnees(&parking, FICHIER_SAUVEGARDE_TEST);
+    if (resultat == SUCCES || resultat == ERREUR_FICHIER_ABSENT) {
+        resultat = ouvrirJournal(&parking, FICHIER_JOURNAL_TEST, 1, 0);
+    }
+
+    *presents = parking.placesOccupees;
+    libererParking(&parking);
+
+    return resultat;
+}
+
+/* ============================================================================
+ * CAS DE TEST
+ * ============================================================================ */
+
+/** Journal intact : toutes les operations sont rejouees */
+static void testerJournalIntact(void)
+{
+    int presents;
+
+    verifier(ecrireJournal(5, 0) > 0, "ecriture d'un journal de 5 entrees");
+    verifier(rouvrirJournal(&presents) == 5 && presents == 5,
+             "journal intact : 5 operations rejouees");
+}
+
+/** Enregistrement incomplet en fin de fichier : retire, le reste rejoue */
+static void testerFinIncomplete(void)
+{
+    unsigned char *contenu;
+    long tailleEnregistrement;
+    long taille;
+    int presents;
+
+    tailleEnregistrement = ecrireJournal(5, 0);
+    contenu = lireFichier(FICHIER_JOURNAL_TEST, &taille);
+    if (contenu == NULL || tailleEnregistrement == 0) {
+        verifier(0, "fin incomplete : preparation");
+        free(contenu);
+        return;
+    }
+
+    ecrireFichier(FICHIER_JOURNAL_TEST, contenu,
+                  taille - tailleEnregistrement / 2);
+
+    verifier(rouvrirJournal(&presents) == 4 && presents == 4,
+             "fin incomplete : 4 operations rejouees");
+    verifier(fichierIdentique(FICHIER_JOURNAL_TEST, contenu,
+                              taille - tailleEnregistrement),
+             "fin incomplete : seule la fin dechiree est retiree");
+    free(contenu);
+}
+
+/** Dernier enregistrement corrompu : fin dechiree, retiree */
+static void testerDernierCorrompu(void)
+{
+    unsigned char *contenu;
+    long tailleEnregistrement;
+    long taille;
+    int presents;
+
+    tailleEnregistrement = ecrireJournal(5, 0);
+    contenu = lireFichier(FICHIER_JOURNAL_TEST, &taille);
+    if (contenu == NULL || tailleEnregistrement == 0) {
+        verifier(0, "dernier enregistrement corrompu : preparation");
+        free(contenu);
+        return;
+    }
+
+    contenu[taille - tailleEnregistrement / 2] ^= 0x5A;
+    ecrireFichier(FICHIER_JOURNAL_TEST, contenu, taille);
+
+    verifier(rouvrirJournal(&presents) == 4 && presents == 4,
+             "dernier enregistrement corrompu : 4 operations rejouees");
+    verifier(fichierIdentique(FICHIER_JOURNAL_TEST, contenu,
+                              taille - tailleEnregistrement),
+             "dernier enregistrement corrompu : retire du fichier");
+    free(contenu);
+}
+
+/** Enregistrement corrompu suivi d'enregistrements valides : refus */
+static void testerMilieuCorrompu(void)
+{
+    unsigned char *contenu;
+    long tailleEnregistrement;
+    long taille;
+    int presents;
+
+    tailleEnregistrement = ecrireJournal(5, 0);
+    contenu = lireFichier(FICHIER_JOURNAL_TEST, &taille);
+    if (contenu == NULL || tailleEnregistrement == 0) {
+        verifier(0, "enregistrement du milieu corrompu : preparation");
+        free(contenu);
+        return;
+    }
+
+    contenu[2 * tailleEnregistrement + tailleEnregistrement / 2] ^= 0x5A;
+    ecrireFichier(FICHIER_JOURNAL_TEST, contenu, taille);
+
+    verifier(rouvrirJournal(&presents) == ERREUR_FICHIER_INVALIDE,
+             "enregistrement du milieu corrompu : journal refuse");
+    verifier(fichierIdentique(FICHIER_JOURNAL_TEST, contenu, taille),
+             "enregistrement du milieu corrompu : journal intact");
+    free(contenu);
+}
+
+/** Journal compacte dont la sauvegarde a disparu : refus */
+static void testerSauvegardeAbsente(void)
+{
+    unsigned char *contenu;
+    long taille;
+    int presents;
+
+    verifier(ecrireJournal(6, 3) > 0,
+             "journal compacte apres une sauvegarde");
+    verifier(rouvrirJournal(&presents) == 3 && presents == 6,
+             "sauvegarde presente : 3 operations rejouees");
+
+    contenu = lireFichier(FICHIER_JOURNAL_TEST, &taille);
+    remove(FICHIER_SAUVEGARDE_TEST);
+
+    verifier(contenu != NULL &&
+             rouvrirJournal(&presents) == ERREUR_FICHIER_INVALIDE,
+             "sauvegarde absente : journal refuse");
+    verifier(contenu != NULL &&
+             fichierIdentique(FICHIER_JOURNAL_TEST, contenu, taille),
+             "sauvegarde absente : journal intact");
+    free(contenu);
+}
+
+/* ============================================================================
+ * PROGRAMME PRINCIPAL
+ * ============================================================================ */
+
+int main(void)
+{
+    Horodatage origine;
+
+    origine.minutes = 0;
+    choisirSourceHorloge(HORLOGE_SIMULEE);
+    reglerHorlogeSimulee(origine);
+
+    testerJournalIntact();
+    testerFinIncomplete();
+    testerDernierCorrompu();
+    testerMilieuCorrompu();
+    testerSauvegardeAbsente();
+
+    remove(FICHIER_JOURNAL_TEST);
+    remove(FICHIER_SAUVEGARDE_TEST);
+
+    printf("%s (%d echec(s))\n", echecs == 0 ? "Succes" : "Echec", echecs);
+
+    return echecs == 0 ? 0 : 1;
+}